@@ -0,0 +1,234 @@
+#include "Interface/ui/HexGrid.h"
+#include "Systems/WorkerPool.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <new>
+#include <random>
+#include <vector>
+
+/**
+ * HexGrid pathfinding benchmark
+ * Console program (no window) that times path queries, whole-army movement ranges and
+ * heap vs bucket-queue Dijkstra on the historical battlefields of a large map. Heap
+ * allocations are counted through a replaced global operator new; exits with status 1
+ * if the workspace-based findPath allocates in steady state or results disagree.
+ */
+
+static std::atomic<size_t> g_allocationCount{0};
+
+void* operator new(std::size_t size) {
+    ++g_allocationCount;
+    if (void* ptr = std::malloc(size ? size : 1)) {
+        return ptr;
+    }
+    throw std::bad_alloc();
+}
+
+void operator delete(void* ptr) noexcept {
+    std::free(ptr);
+}
+
+void operator delete(void* ptr, std::size_t) noexcept {
+    std::free(ptr);
+}
+
+namespace {
+
+struct Query {
+    HexCoordinate start;
+    HexCoordinate goal;
+};
+
+struct BenchmarkResult {
+    double milliseconds = 0.0;
+    size_t allocations = 0;
+    int pathsFound = 0;
+};
+
+void fillRandomTerrain(HexGrid& grid, std::mt19937& rng) {
+    const TerrainType terrains[] = {
+        TerrainType::PLAIN, TerrainType::PLAIN, TerrainType::PLAIN, TerrainType::FOREST,
+        TerrainType::FOREST, TerrainType::MOUNTAIN, TerrainType::SWAMP, TerrainType::ROAD,
+        TerrainType::RIVER
+    };
+    std::uniform_int_distribution<int> terrainDist(0, 8);
+    std::uniform_int_distribution<int> heightDist(0, 3);
+
+    for (int index = 0; index < grid.getTileCount(); ++index) {
+        const HexCoordinate& coord = grid.getCoordinateAt(index);
+        grid.setTerrain(coord, terrains[terrainDist(rng)]);
+        grid.setHeight(coord, heightDist(rng) == 3 ? 1 : 0);
+    }
+}
+
+std::vector<Query> makeQueries(const HexGrid& grid, int count, std::mt19937& rng) {
+    std::uniform_int_distribution<int> indexDist(0, grid.getTileCount() - 1);
+    std::vector<Query> queries;
+    queries.reserve(count);
+    for (int i = 0; i < count; ++i) {
+        queries.push_back({grid.getCoordinateAt(indexDist(rng)), grid.getCoordinateAt(indexDist(rng))});
+    }
+    return queries;
+}
+
+template<typename Run>
+BenchmarkResult measure(const std::vector<Query>& queries, Run&& run) {
+    BenchmarkResult result;
+    size_t allocationsBefore = g_allocationCount.load();
+    auto begin = std::chrono::steady_clock::now();
+
+    for (const Query& query : queries) {
+        if (run(query)) {
+            ++result.pathsFound;
+        }
+    }
+
+    auto end = std::chrono::steady_clock::now();
+    result.milliseconds = std::chrono::duration<double, std::milli>(end - begin).count();
+    result.allocations = g_allocationCount.load() - allocationsBefore;
+    return result;
+}
+
+// Heap vs bucket queue Dijkstra for long-range (cavalry) movement on a battlefield setup
+bool benchmarkSearchQueues(const char* name, HexGrid& grid, int movementPoints, int queryCount) {
+    PathfindingWorkspace workspace;
+    MovementField field;
+    std::vector<int> heapCosts;
+    std::vector<int> bucketCosts;
+
+    int stride = std::max(1, grid.getTileCount() / queryCount);
+    auto run = [&](HexGrid::SearchQueue queue, std::vector<int>& totals) {
+        grid.setSearchQueue(queue);
+        totals.clear();
+        auto begin = std::chrono::steady_clock::now();
+        for (int index = 0; index < grid.getTileCount(); index += stride) {
+            grid.calculateMovementRange(grid.getCoordinateAt(index), movementPoints, workspace, field);
+            totals.push_back(field.size());
+        }
+        return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - begin).count();
+    };
+
+    run(HexGrid::SearchQueue::BinaryHeap, heapCosts); // Warm-up
+    double heapMs = run(HexGrid::SearchQueue::BinaryHeap, heapCosts);
+    double bucketMs = run(HexGrid::SearchQueue::BucketQueue, bucketCosts);
+    grid.setSearchQueue(HexGrid::SearchQueue::Auto);
+
+    std::cout << std::left << std::setw(12) << name << std::right << std::fixed << std::setprecision(2)
+              << "heap " << std::setw(9) << heapMs << " ms   bucket " << std::setw(9) << bucketMs
+              << " ms   speedup " << std::setprecision(2) << heapMs / bucketMs << "x"
+              << "   (max step cost " << grid.getMaxStepCost(true) << ")" << std::endl;
+    return heapCosts == bucketCosts;
+}
+
+void printResult(const char* name, const BenchmarkResult& result, size_t queryCount) {
+    std::cout << std::left << std::setw(28) << name
+              << std::right << std::setw(10) << std::fixed << std::setprecision(2) << result.milliseconds << " ms"
+              << std::setw(10) << std::setprecision(3) << result.milliseconds * 1000.0 / queryCount << " us/query"
+              << std::setw(12) << result.allocations << " allocs"
+              << std::setw(8) << result.pathsFound << " found" << std::endl;
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    int size = (argc > 1) ? std::atoi(argv[1]) : 256;
+    int queryCount = (argc > 2) ? std::atoi(argv[2]) : 500;
+
+    std::cout << "=== HexGrid Pathfinding Benchmark ===" << std::endl;
+    std::cout << "Map: " << size << "x" << size << ", queries: " << queryCount << std::endl;
+
+    std::mt19937 rng(1337);
+    HexGrid grid(size, size);
+    fillRandomTerrain(grid, rng);
+    std::vector<Query> queries = makeQueries(grid, queryCount, rng);
+
+    BenchmarkResult legacy = measure(queries, [&](const Query& query) {
+        return grid.findPath(query.start, query.goal).pathFound;
+    });
+    printResult("findPath (legacy API)", legacy, queries.size());
+
+    PathfindingWorkspace workspace;
+    PathfindingResult path;
+
+    // Warm-up: grows the workspace and the path buffer to their steady-state size
+    measure(queries, [&](const Query& query) {
+        return grid.findPath(query.start, query.goal, workspace, path);
+    });
+
+    BenchmarkResult reused = measure(queries, [&](const Query& query) {
+        return grid.findPath(query.start, query.goal, workspace, path);
+    });
+    printResult("findPath (workspace)", reused, queries.size());
+
+    BenchmarkResult custom = measure(queries, [&](const Query& query) {
+        return grid.findPath(query.start, query.goal, workspace, path,
+                             [](const HexTile& tile) { return tile.isPassable(); });
+    });
+    printResult("findPath (workspace+lambda)", custom, queries.size());
+
+    if (legacy.pathsFound != reused.pathsFound) {
+        std::cout << "ERROR: legacy and workspace searches disagree" << std::endl;
+        return 1;
+    }
+    if (reused.allocations != 0) {
+        std::cout << "ERROR: workspace findPath allocated in steady state" << std::endl;
+        return 1;
+    }
+
+    std::cout << "Steady-state workspace queries allocate nothing." << std::endl;
+
+    // Whole-army turn: one movement range per unit
+    const int unitCount = 200;
+    std::vector<MovementRequest> requests;
+    for (int i = 0; i < unitCount; ++i) {
+        MovementRequest request;
+        request.start = queries[i % queries.size()].start;
+        request.movementPoints = 6 + i % 6;
+        requests.push_back(request);
+    }
+
+    auto begin = std::chrono::steady_clock::now();
+    size_t reachedSequential = 0;
+    for (const MovementRequest& request : requests) {
+        reachedSequential += grid.calculateMovementRange(request.start, request.movementPoints).reachableTiles.size();
+    }
+    double sequentialMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - begin).count();
+
+    std::vector<MovementField> fields;
+    grid.calculateMovementRanges(requests, fields); // Warm-up: threads, workspaces, field storage
+    begin = std::chrono::steady_clock::now();
+    grid.calculateMovementRanges(requests, fields);
+    double batchMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - begin).count();
+
+    size_t reachedBatch = 0;
+    for (const MovementField& field : fields) {
+        reachedBatch += field.tiles.size();
+    }
+
+    std::cout << std::fixed << std::setprecision(2)
+              << unitCount << " movement ranges: sequential " << sequentialMs << " ms, batch "
+              << batchMs << " ms on " << WorkerPool::shared().getConcurrency() << " threads" << std::endl;
+    if (reachedSequential != reachedBatch) {
+        std::cout << "ERROR: batch movement ranges disagree with calculateMovementRange" << std::endl;
+        return 1;
+    }
+
+    // Cavalry-sized movement budgets on the historical setups
+    std::cout << "Movement range queue comparison (" << size << "x" << size << ", 40 MP):" << std::endl;
+    bool queuesAgree = true;
+    grid.setupCannaeBattlefield();
+    queuesAgree &= benchmarkSearchQueues("Cannae", grid, 40, 200);
+    grid.setupAlesiaBattlefield();
+    queuesAgree &= benchmarkSearchQueues("Alesia", grid, 40, 200);
+    grid.setupTeutobergBattlefield();
+    queuesAgree &= benchmarkSearchQueues("Teutoburg", grid, 40, 200);
+    if (!queuesAgree) {
+        std::cout << "ERROR: bucket queue and binary heap ranges disagree" << std::endl;
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,175 @@
+#include "Interface/ui/HexGrid.h"
+#include <nlohmann/json.hpp>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <new>
+#include <random>
+#include <sstream>
+
+/**
+ * HexGrid serialization benchmark
+ * Console program (no window) that saves and loads a large map (512x512 by default)
+ * as JSON through an in-memory string, as streamed JSON files, through a full nlohmann
+ * document for comparison, and as a binary .hexmap. Reports wall time and the peak heap
+ * in use above the starting point, tracked through replaced global operator new/delete.
+ * Exits with status 1 if any loaded map differs from the original.
+ */
+
+namespace {
+
+std::atomic<size_t> g_liveBytes{0};
+std::atomic<size_t> g_peakBytes{0};
+
+// Each allocation carries its size in front so delete can subtract it
+constexpr size_t HEADER_SIZE = alignof(std::max_align_t);
+
+} // namespace
+
+void* operator new(std::size_t size) {
+    void* block = std::malloc(size + HEADER_SIZE);
+    if (!block) {
+        throw std::bad_alloc();
+    }
+    *static_cast<size_t*>(block) = size;
+    size_t live = g_liveBytes += size;
+    size_t peak = g_peakBytes.load();
+    while (live > peak && !g_peakBytes.compare_exchange_weak(peak, live)) {
+    }
+    return static_cast<char*>(block) + HEADER_SIZE;
+}
+
+void operator delete(void* ptr) noexcept {
+    if (!ptr) return;
+    void* block = static_cast<char*>(ptr) - HEADER_SIZE;
+    g_liveBytes -= *static_cast<size_t*>(block);
+    std::free(block);
+}
+
+void operator delete(void* ptr, std::size_t) noexcept {
+    operator delete(ptr);
+}
+
+namespace {
+
+struct Measurement {
+    double milliseconds = 0.0;
+    double peakMegabytes = 0.0;
+};
+
+template<typename Run>
+Measurement measure(Run&& run) {
+    size_t baseline = g_liveBytes.load();
+    g_peakBytes = baseline;
+    auto begin = std::chrono::steady_clock::now();
+
+    run();
+
+    Measurement result;
+    result.milliseconds = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - begin).count();
+    result.peakMegabytes = (g_peakBytes.load() - baseline) / (1024.0 * 1024.0);
+    return result;
+}
+
+void printResult(const char* name, const Measurement& result) {
+    std::cout << std::left << std::setw(30) << name << std::right << std::fixed
+              << std::setw(10) << std::setprecision(1) << result.milliseconds << " ms"
+              << std::setw(10) << std::setprecision(1) << result.peakMegabytes << " MB peak" << std::endl;
+}
+
+void fillRandomMap(HexGrid& grid, std::mt19937& rng) {
+    const TerrainType terrains[] = {
+        TerrainType::PLAIN, TerrainType::PLAIN, TerrainType::FOREST, TerrainType::MOUNTAIN,
+        TerrainType::SWAMP, TerrainType::ROAD, TerrainType::RIVER, TerrainType::CAMP
+    };
+    std::uniform_int_distribution<int> terrainDist(0, 7);
+    std::uniform_int_distribution<int> heightDist(0, 3);
+    std::uniform_int_distribution<int> rareDist(0, 999);
+
+    for (int index = 0; index < grid.getTileCount(); ++index) {
+        const HexCoordinate& coord = grid.getCoordinateAt(index);
+        grid.setTerrain(coord, terrains[terrainDist(rng)]);
+        grid.setHeight(coord, heightDist(rng));
+
+        // A sprinkling of tags and events so the side data is exercised
+        if (rareDist(rng) == 0) {
+            HexTile* tile = grid.getTileByIndex(index);
+            tile->getProperties().specialTag = "outpost_" + std::to_string(index);
+            TileEvent event;
+            event.eventId = "ambush_" + std::to_string(index);
+            event.triggerCondition = "unit_enter";
+            event.action = "spawn_enemy";
+            event.parameters["count"] = "2";
+            tile->addEvent(event);
+            grid.refreshTile(coord);
+        }
+    }
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    int size = (argc > 1) ? std::atoi(argv[1]) : 512;
+    const std::string jsonFile = "hexgrid_benchmark_map.json";
+    const std::string binaryFile = "hexgrid_benchmark_map.hexmap";
+
+    std::cout << "=== HexGrid Serialization Benchmark ===" << std::endl;
+    std::cout << "Map: " << size << "x" << size << " (" << size * size << " tiles)" << std::endl;
+
+    std::mt19937 rng(1337);
+    HexGrid grid(size, size);
+    fillRandomMap(grid, rng);
+
+    std::string reference;
+    printResult("toJSON (string)", measure([&] { reference = grid.toJSON(); }));
+    std::cout << "JSON size: " << std::fixed << std::setprecision(1)
+              << reference.size() / (1024.0 * 1024.0) << " MB" << std::endl;
+
+    printResult("writeJSON (file stream)", measure([&] {
+        std::ofstream file(jsonFile, std::ios::binary);
+        grid.writeJSON(file);
+    }));
+
+    bool identical = true;
+    {
+        HexGrid loaded(1, 1);
+        printResult("fromJSON (string, SAX)", measure([&] { loaded.fromJSON(reference); }));
+        identical &= loaded.toJSON() == reference;
+    }
+    {
+        HexGrid loaded(1, 1);
+        printResult("readJSON (file stream, SAX)", measure([&] {
+            std::ifstream file(jsonFile, std::ios::binary);
+            loaded.readJSON(file);
+        }));
+        identical &= loaded.toJSON() == reference;
+    }
+
+    // What a document-based loader pays before touching a single tile
+    printResult("nlohmann DOM parse (file)", measure([&] {
+        std::ifstream file(jsonFile, std::ios::binary);
+        nlohmann::json document = nlohmann::json::parse(file);
+        if (document["tiles"].size() != static_cast<size_t>(grid.getTileCount())) identical = false;
+    }));
+
+    printResult("saveBinary (.hexmap)", measure([&] { grid.saveBinary(binaryFile); }));
+    {
+        HexGrid loaded(1, 1);
+        printResult("loadBinary (.hexmap, mmap)", measure([&] { loaded.loadBinary(binaryFile); }));
+        identical &= loaded.toJSON() == reference;
+    }
+
+    std::remove(jsonFile.c_str());
+    std::remove(binaryFile.c_str());
+
+    if (!identical) {
+        std::cout << "ERROR: a loaded map differs from the original" << std::endl;
+        return 1;
+    }
+    std::cout << "All loaded maps match the original." << std::endl;
+    return 0;
+}
@@ -152,6 +152,9 @@ void MainMenuScene::onCreate() {
     
     // Add to UI manager
     getUIManager().addComponent(container_, true);
+    
+    // The menu is static: redraw only what changes, over the same background render() clears to
+    setRetainedRendering(true, {30, 30, 60, 255});
 }
 
 void MainMenuScene::onEnter() {
@@ -399,11 +402,11 @@ int main() {
             sceneManager.handleEvent(event);
         }
         
-        // Update and render
+        // Update and render; an unchanged retained frame does not need presenting again
         sceneManager.update(deltaTime);
-        sceneManager.render();
-        
-        SDL_RenderPresent(sdl.getRenderer());
+        if (sceneManager.render()) {
+            SDL_RenderPresent(sdl.getRenderer());
+        }
         
         // Check for exit from main menu
         if (auto mainMenu = sceneManager.getMainMenuScene()) {
@@ -22,7 +22,7 @@ public:
     bool canReceiveFocus() const override { return true; }
     
     // Button properties
-    void setText(const std::string& text) { text_ = text; }
+    void setText(const std::string& text) { text_ = text; invalidateRender(); }
     const std::string& getText() const { return text_; }
     void setOnClick(std::function<void()> onClick) { onClick_ = onClick; }
 
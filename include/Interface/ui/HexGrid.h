@@ -1,10 +1,19 @@
 #pragma once
 #include "HexCoordinate.h"
 #include "HexTile.h"
+#include "PathfindingWorkspace.h"
 #include <unordered_map>
 #include <vector>
 #include <memory>
 #include <functional>
+#include <cstdint>
+#include <algorithm>
+#include <type_traits>
+#include <cstdlib>
+#include <array>
+
+class WorkerPool;
+class HexMapView;
 
 /**
  * Pathfinding result containing path and cost information
@@ -39,6 +48,64 @@ struct MovementRange {
     }
 };
 
+/**
+ * Compact movement range produced by batch queries
+ * Reached tiles are stored as ascending tile indices with parallel costs, plus a
+ * bitset over all tile indices for O(1) reachability tests. Reusing a field across
+ * queries reuses its storage.
+ */
+struct MovementField {
+    int startIndex = -1;
+    int maxMovementPoints = 0;
+    std::vector<int> tiles;              // Reached tile indices, ascending
+    std::vector<int> costs;              // Cost to reach tiles[i]
+    std::vector<uint64_t> reachableBits; // Bit per tile index
+    
+    int size() const { return static_cast<int>(tiles.size()); }
+    
+    bool canReach(int index) const {
+        return index >= 0 && static_cast<size_t>(index >> 6) < reachableBits.size() &&
+               (reachableBits[index >> 6] >> (index & 63)) & 1;
+    }
+    
+    int getCostToReach(int index) const {
+        if (!canReach(index)) return -1;
+        auto it = std::lower_bound(tiles.begin(), tiles.end(), index);
+        return costs[it - tiles.begin()];
+    }
+};
+
+/**
+ * Flow field toward one or more goals
+ * Every tile holds its integration cost (cheapest route to the nearest goal) and the
+ * direction of the first step, 0-5 as in HexCoordinate::getNeighbor. A unit follows
+ * directions from tile to tile with no search of its own.
+ */
+struct FlowField {
+    static constexpr int UNREACHABLE = -1;
+    static constexpr int8_t NO_DIRECTION = -1;  // At goals and unreachable tiles
+    
+    std::vector<int> goals;             // Goal tile indices
+    std::vector<int> costs;             // Per tile index, UNREACHABLE without a route
+    std::vector<int8_t> directions;     // Per tile index
+    uint64_t movementRevision = 0;      // HexGrid::getMovementRevision() when computed
+    
+    bool canReach(int index) const {
+        return index >= 0 && static_cast<size_t>(index) < costs.size() && costs[index] != UNREACHABLE;
+    }
+    int getCost(int index) const { return canReach(index) ? costs[index] : UNREACHABLE; }
+    int getDirection(int index) const { return canReach(index) ? directions[index] : NO_DIRECTION; }
+};
+
+/**
+ * One unit's entry in a batched movement range query
+ */
+struct MovementRequest {
+    HexCoordinate start;
+    int movementPoints = 0;
+    std::function<bool(const HexTile&)> isPassable; // Empty: passable and unoccupied
+};
+
 /**
  * Hexagonal grid manager supporting Roman warfare tactics
  * Manages the collection of hex tiles and provides pathfinding, 
@@ -47,7 +114,7 @@ struct MovementRange {
 class HexGrid {
 public:
     HexGrid(int width, int height);
-    ~HexGrid() = default;
+    ~HexGrid();
     
     // Grid management
     int getWidth() const { return width_; }
@@ -63,26 +130,169 @@ public:
     
     void setTile(const HexCoordinate& coord, const HexTile& tile);
     void setTerrain(const HexCoordinate& coord, TerrainType terrain);
+    void setHeight(const HexCoordinate& coord, int height);
+    void setOccupant(const HexCoordinate& coord, const std::string& unitId);
+    
+    // Re-read a tile's hot data after modifying it directly through getTile()
+    void refreshTile(const HexCoordinate& coord);
     
-    bool isValidCoordinate(const HexCoordinate& coord) const;
+    bool isValidCoordinate(const HexCoordinate& coord) const { return getTileIndex(coord) >= 0; }
     std::vector<HexCoordinate> getAllCoordinates() const;
     
+    // Dense tile storage: tiles are kept row-major in offset order (index = row * width + col).
+    // Tile pointers and indices stay valid until resize() rebuilds the grid.
+    int getTileCount() const { return static_cast<int>(tiles_.size()); }
+    int getTileIndex(const HexCoordinate& coord) const; // -1 if outside the grid
+    HexTile* getTileByIndex(int index) { return &tiles_[index]; }
+    const HexTile* getTileByIndex(int index) const { return &tiles_[index]; }
+    const HexCoordinate& getCoordinateAt(int index) const { return tiles_[index].getCoordinate(); }
+    const std::vector<HexTile>& getTiles() const { return tiles_; }
+    
+    // Change notifications, fired after a tile's hot data changes (index, TileChange bits).
+    // Rebuilding the grid (constructor, resize) reports index -1 with CHANGE_LAYOUT.
+    enum TileChange : uint8_t {
+        CHANGE_TERRAIN = 1 << 0,
+        CHANGE_HEIGHT  = 1 << 1,
+        CHANGE_FLAGS    = 1 << 2,   // Passability, line of sight, occupancy, buildable, supply
+        CHANGE_LAYOUT   = 1 << 3,
+        CHANGE_OCCUPANT = 1 << 4,   // Occupying unit id
+        CHANGE_MOVEMENT_COST = 1 << 5
+    };
+    using TileChangeListener = std::function<void(int index, uint8_t changes)>;
+    int addChangeListener(TileChangeListener listener); // Returns an id for removeChangeListener
+    void removeChangeListener(int listenerId);
+    
+    // Change journal for incremental consumers (render caches, statistics, validation, network
+    // sync). Each subscriber owns a cursor; drainChanges() returns every tile changed since that
+    // cursor's last drain, once, with the OR of its TileChange bits, in first-change order.
+    // A false return means the grid was rebuilt or the subscriber fell too far behind, and it
+    // must rescan the whole grid; the cursor then continues from the current state.
+    struct TileChangeRecord {
+        int index;
+        uint8_t changes;
+    };
+    int openChangeCursor();
+    void closeChangeCursor(int cursorId);
+    bool drainChanges(int cursorId, std::vector<TileChangeRecord>& changes);
+    
+    // Neighbor index in direction 0-5 (same order as HexCoordinate::getNeighbor), -1 at the border
+    int getNeighborIndex(int index, int direction) const { return neighbors_[index * 6 + direction]; }
+    
+    // Hot tile data in packed parallel arrays (structure-of-arrays), indexed like getTileByIndex.
+    // Pathfinding, line of sight and rendering read these instead of whole HexTile objects.
+    enum TileFlags : uint8_t {
+        TILE_PASSABLE  = 1 << 0,
+        TILE_HIDDEN    = 1 << 1,    // Blocks line of sight
+        TILE_OCCUPIED  = 1 << 2,
+        TILE_BUILDABLE = 1 << 3,
+        TILE_SUPPLY    = 1 << 4
+    };
+    static uint8_t computeTileFlags(const HexTile& tile);
+    TerrainType getTerrainAt(int index) const { return terrain_[index]; }
+    int getHeightAt(int index) const { return heights_[index]; }
+    int getMovementCostAt(int index) const { return movementCosts_[index]; }
+    uint8_t getTileFlags(int index) const { return flags_[index]; }
+    bool isPassableAt(int index) const { return flags_[index] & TILE_PASSABLE; }
+    bool blocksLineOfSightAt(int index) const { return flags_[index] & TILE_HIDDEN; }
+    bool isOccupiedAt(int index) const { return flags_[index] & TILE_OCCUPIED; }
+    
+    // Same rule as HexTileUtils::calculateMovementCost, on the packed arrays
+    int getStepCost(int from, int to) const {
+        int heightDiff = heights_[to] - heights_[from];
+        return movementCosts_[to] + (heightDiff < 0 ? -heightDiff : heightDiff);
+    }
+    
     // Pathfinding using A* algorithm
     PathfindingResult findPath(const HexCoordinate& start, const HexCoordinate& goal,
                               std::function<bool(const HexTile&)> isPassable = nullptr) const;
     
+    // Symmetry reduction for A*: in regions of uniform step cost every shortest path can be
+    // reordered to use one direction and then the next one clockwise, so a tile whose six
+    // neighbors are enterable at its own cost and height only expands its arrival direction
+    // and that direction turned clockwise. Tiles next to a cost change, obstacle or the grid
+    // edge expand all six. Path costs are unchanged; on by default.
+    void setSymmetryReduction(bool enabled) { symmetryReduction_ = enabled; }
+    bool isSymmetryReductionEnabled() const { return symmetryReduction_; }
+    
+    // Allocation-free A* for bulk queries: search state lives in the caller's workspace and
+    // result.path reuses its capacity. isPassable is any callable bool(const HexTile&), inlined
+    // at compile time; DefaultPassable selects the passable-and-unoccupied rule on packed flags.
+    struct DefaultPassable {};
+    template<typename Predicate>
+    bool findPath(const HexCoordinate& start, const HexCoordinate& goal,
+                  PathfindingWorkspace& workspace, PathfindingResult& result,
+                  Predicate&& isPassable) const;
+    bool findPath(const HexCoordinate& start, const HexCoordinate& goal,
+                  PathfindingWorkspace& workspace, PathfindingResult& result) const {
+        return findPath(start, goal, workspace, result, DefaultPassable{});
+    }
+    
     // Movement range calculation (Dijkstra-based)
     MovementRange calculateMovementRange(const HexCoordinate& start, int movementPoints,
                                        std::function<bool(const HexTile&)> isPassable = nullptr) const;
     
-    // Attack range calculation considering line of sight
+    // Open-set structure for movement range searches. Auto uses a bucket queue (Dial's
+    // algorithm) whenever the largest possible step cost is at most MAX_BUCKET_QUEUE_COST.
+    enum class SearchQueue { Auto, BinaryHeap, BucketQueue };
+    static constexpr int MAX_BUCKET_QUEUE_COST = 64;
+    void setSearchQueue(SearchQueue queue) { searchQueue_ = queue; }
+    SearchQueue getSearchQueue() const { return searchQueue_; }
+    
+    // Upper bound on a single step's cost (terrain cost plus height difference); with
+    // passableOnly it only considers tiles the default passability rule can enter
+    int getMaxStepCost(bool passableOnly) const;
+    
+    // Movement range into a reusable field using the caller's workspace (allocation-free once warm)
+    template<typename Predicate>
+    void calculateMovementRange(const HexCoordinate& start, int movementPoints,
+                                PathfindingWorkspace& workspace, MovementField& field,
+                                Predicate&& isPassable) const;
+    void calculateMovementRange(const HexCoordinate& start, int movementPoints,
+                                PathfindingWorkspace& workspace, MovementField& field) const {
+        calculateMovementRange(start, movementPoints, workspace, field, DefaultPassable{});
+    }
+    
+    // Whole-army movement ranges: one search per request, run in parallel on a worker pool
+    // (WorkerPool::shared() when null). The grid must not be modified during the call.
+    void calculateMovementRanges(const std::vector<MovementRequest>& requests,
+                                 std::vector<MovementField>& results,
+                                 WorkerPool* pool = nullptr) const;
+    std::vector<MovementField> calculateMovementRanges(const std::vector<MovementRequest>& requests,
+                                                       WorkerPool* pool = nullptr) const;
+    
+    // Flow fields for many units marching on shared goals: one reverse Dijkstra from the goals
+    // covers every tile. Routes avoid impassable terrain but ignore occupancy, which changes
+    // every move; a tile's own blockage does not stop units leaving it. Impassable goals are
+    // skipped. getFlowField() caches one field per goal until terrain, height, movement cost
+    // or passability changes anywhere (getMovementRevision()); the pointer stays usable after.
+    void computeFlowField(const std::vector<HexCoordinate>& goals, PathfindingWorkspace& workspace,
+                          FlowField& field) const;
+    FlowField computeFlowField(const std::vector<HexCoordinate>& goals) const;
+    std::shared_ptr<const FlowField> getFlowField(const HexCoordinate& goal) const;
+    bool isFlowFieldCurrent(const FlowField& field) const { return field.movementRevision == movementRevision_; }
+    uint64_t getMovementRevision() const { return movementRevision_; }
+    
+    // Attack range calculation considering line of sight (one shadow-casting field-of-view sweep)
     std::vector<HexCoordinate> calculateAttackRange(const HexCoordinate& attacker, int range,
                                                    bool requireLineOfSight = true) const;
     
-    // Line of sight calculation
+    // Line of sight calculation. The line visits one hex per distance step; where it runs exactly
+    // between two hexes it is blocked only if both block. The end points never block.
     bool hasLineOfSight(const HexCoordinate& from, const HexCoordinate& to) const;
     std::vector<HexCoordinate> getLineOfSightPath(const HexCoordinate& from, const HexCoordinate& to) const;
     
+    // Field of view: every grid tile within range of origin that hasLineOfSight can see, found
+    // by one ring-by-ring shadow-casting sweep instead of a line walk per tile. Blockers are
+    // themselves visible. Results are tile indices, origin first, in ring order.
+    void computeFieldOfView(const HexCoordinate& origin, int range, std::vector<int>& visible) const;
+    std::vector<HexCoordinate> computeFieldOfView(const HexCoordinate& origin, int range) const;
+    
+    // Optional memoization of hasLineOfSight and computeFieldOfView results. Cached entries are
+    // dropped only when a tile's line-of-sight blocking changes (terrain edits, destroyed structures).
+    void setVisibilityCacheEnabled(bool enabled);
+    bool isVisibilityCacheEnabled() const { return visibilityCache_ != nullptr; }
+    uint64_t getLineOfSightRevision() const { return lineOfSightRevision_; }
+    
     // Neighbors and adjacency
     std::vector<HexCoordinate> getNeighbors(const HexCoordinate& coord) const;
     std::vector<HexTile*> getNeighborTiles(const HexCoordinate& coord);
@@ -96,6 +306,12 @@ public:
     void highlightFormation(const std::vector<HexCoordinate>& formation, const SDL_Color& color);
     void clearHighlights();
     
+    // Highlighted tiles are tracked, so clearHighlights() only visits those. Highlights set here
+    // or arriving through setTile() are tracked at once; ones set directly on a HexTile are
+    // tracked once refreshTile() re-reads it.
+    void setHighlight(int index, const SDL_Color& color);
+    const std::vector<int>& getHighlightedTiles() const { return highlightedTiles_; }
+    
     // Engineering operations (Roman military engineering)
     bool canBuildBridge(const HexCoordinate& coord) const;
     void buildBridge(const HexCoordinate& coord);
@@ -107,11 +323,24 @@ public:
     void processEvents(const std::string& triggerCondition, 
                       const std::unordered_map<std::string, std::string>& context);
     
-    // Serialization for map editor
+    // Serialization for map editor. writeJSON streams tiles straight to out; readJSON is a SAX
+    // reader that fills tiles in place without building a document ("width" and "height" must
+    // precede "tiles"). Tiles are read into a separate buffer, so on failure the grid is left
+    // unchanged and error (if given) describes the problem.
+    void writeJSON(std::ostream& out) const;
+    bool readJSON(std::istream& in, std::string* error = nullptr);
     std::string toJSON() const;
     void fromJSON(const std::string& json);
     
-    // Statistics and analysis
+    // Binary .hexmap format (see HexMapFile.h). Loading copies the packed arrays straight from
+    // the memory-mapped file; only tiles in the side table need per-tile decoding. On failure
+    // the grid is left unchanged and error (if given) describes the problem.
+    bool saveBinary(const std::string& filename, std::string* error = nullptr) const;
+    bool loadBinary(const std::string& filename, std::string* error = nullptr);
+    bool loadBinary(const HexMapView& map, std::string* error = nullptr);
+    
+    // Statistics and analysis. Counters are kept up to date by every tile change, so the whole
+    // grid snapshot is constant time. terrainCounts only lists terrains that are present.
     struct GridStatistics {
         int totalTiles = 0;
         std::unordered_map<TerrainType, int> terrainCounts;
@@ -121,6 +350,12 @@ public:
     };
     GridStatistics getStatistics() const;
     
+    // Statistics for the offset-coordinate rectangle [minCol, maxCol] x [minRow, maxRow], clamped
+    // to the grid. Chunks fully inside the rectangle use their STATISTICS_CHUNK_SIZE^2 summaries,
+    // so only tiles in partially covered chunks along the edges are visited.
+    static constexpr int STATISTICS_CHUNK_SIZE = 16;
+    GridStatistics getStatistics(int minCol, int minRow, int maxCol, int maxRow) const;
+    
     // Batch operations for performance
     void setTerrainArea(const std::vector<HexCoordinate>& coords, TerrainType terrain);
     void setHeightArea(const std::vector<HexCoordinate>& coords, int height);
@@ -132,24 +367,268 @@ public:
 
 private:
     int width_, height_;
-    std::unordered_map<HexCoordinate, std::unique_ptr<HexTile>> tiles_;
+    std::vector<HexTile> tiles_;     // width_ * height_ tiles, row-major offset order
+    std::vector<int> neighbors_;     // 6 neighbor indices per tile, -1 where off-grid
     
-    // Pathfinding helpers
-    struct PathNode {
-        HexCoordinate coord;
-        int gCost = 0;      // Cost from start
-        int hCost = 0;      // Heuristic cost to goal
-        int fCost() const { return gCost + hCost; }
-        HexCoordinate parent{-9999, -9999, -9999}; // Invalid coordinate as null
+    // Hot data mirrored from tiles_ by syncTile()
+    std::vector<TerrainType> terrain_;
+    std::vector<int8_t> heights_;         // Clamped to the int8_t range
+    std::vector<uint8_t> movementCosts_;  // Clamped to 255
+    std::vector<uint8_t> flags_;          // TileFlags
+    
+    // Movement cost histograms over all tiles and over passable tiles, for getMaxStepCost()
+    std::array<int, 256> costCounts_{};
+    std::array<int, 256> passableCostCounts_{};
+    SearchQueue searchQueue_ = SearchQueue::Auto;
+    bool symmetryReduction_ = true;
+    
+    // Statistics counters for the whole grid and per STATISTICS_CHUNK_SIZE square chunk
+    struct StatisticsCounts {
+        std::array<int, TERRAIN_TYPE_COUNT> terrain{};
+        int impassable = 0;
+        int buildable = 0;
+        int supply = 0;
         
-        bool operator>(const PathNode& other) const { return fCost() > other.fCost(); }
+        void add(TerrainType type, uint8_t flags, int delta) {
+            terrain[static_cast<int>(type)] += delta;
+            if (!(flags & TILE_PASSABLE)) impassable += delta;
+            if ((flags & (TILE_BUILDABLE | TILE_OCCUPIED)) == TILE_BUILDABLE) buildable += delta;
+            if (flags & TILE_SUPPLY) supply += delta;
+        }
+        void add(const StatisticsCounts& other) {
+            for (int type = 0; type < TERRAIN_TYPE_COUNT; ++type) terrain[type] += other.terrain[type];
+            impassable += other.impassable;
+            buildable += other.buildable;
+            supply += other.supply;
+        }
     };
+    StatisticsCounts statistics_;
+    std::vector<StatisticsCounts> statisticsChunks_;
+    int statisticsChunksX_ = 0;
+    
+    int getStatisticsChunk(int index) const {
+        return (index / width_ / STATISTICS_CHUNK_SIZE) * statisticsChunksX_ + (index % width_) / STATISTICS_CHUNK_SIZE;
+    }
+    void countTile(int index, TerrainType type, uint8_t flags, int delta) {
+        statistics_.add(type, flags, delta);
+        statisticsChunks_[getStatisticsChunk(index)].add(type, flags, delta);
+    }
+    static GridStatistics makeStatistics(const StatisticsCounts& counts, int totalTiles);
+    
+    // Bumped whenever a tile starts or stops blocking line of sight
+    uint64_t lineOfSightRevision_ = 0;
+    struct VisibilityCache;
+    std::unique_ptr<VisibilityCache> visibilityCache_;
+    
+    // Bumped whenever a tile's step cost or terrain passability changes
+    uint64_t movementRevision_ = 0;
+    struct FlowFieldCache;
+    std::unique_ptr<FlowFieldCache> flowFieldCache_;
+    
+    void sweepFieldOfView(int originIndex, int range, std::vector<int>& visible) const;
+    bool isLineBlocked(const HexCoordinate& from, const HexCoordinate& to, int distance) const;
     
-    int calculateHeuristic(const HexCoordinate& from, const HexCoordinate& to) const;
-    bool isDefaultPassable(const HexTile& tile) const;
+    std::vector<std::pair<int, TileChangeListener>> changeListeners_;
+    int nextListenerId_ = 1;
+    bool notifyChanges_ = true;     // Off while initializeGrid() fills the arrays
+    struct ChangeJournal;
+    std::unique_ptr<ChangeJournal> changeJournal_;  // Created by the first openChangeCursor()
     
-    // Grid initialization helpers
+    std::vector<int> highlightedTiles_;
+    std::vector<bool> highlightTracked_;    // Per tile: listed in highlightedTiles_
+    void trackHighlight(int index);
+    
+    // Re-read tile index into the hot arrays; extraChanges reports fields syncTile cannot compare
+    void syncTile(int index, uint8_t extraChanges = 0);
+    void notifyChange(int index, uint8_t changes);
+    
+    // Pathfinding helpers
+    bool isDefaultPassable(int index) const {
+        return (flags_[index] & (TILE_PASSABLE | TILE_OCCUPIED)) == TILE_PASSABLE;
+    }
+    
+    // True if every neighbor of index exists, is enterable, and has index's cost and height
+    template<typename Predicate>
+    bool isUniformAround(int index, Predicate& isPassable) const {
+        const int* neighbors = &neighbors_[index * 6];
+        for (int direction = 0; direction < 6; ++direction) {
+            int neighbor = neighbors[direction];
+            if (neighbor < 0 || movementCosts_[neighbor] != movementCosts_[index] ||
+                heights_[neighbor] != heights_[index]) {
+                return false;
+            }
+            if constexpr (std::is_same_v<std::decay_t<Predicate>, DefaultPassable>) {
+                if (!isDefaultPassable(neighbor)) return false;
+            } else {
+                if (!isPassable(tiles_[neighbor])) return false;
+            }
+        }
+        return true;
+    }
+    
+    // Hex distance between two tile indices, computed from the row-major layout
+    int indexDistance(int from, int to) const {
+        int fromRow = from / width_;
+        int toRow = to / width_;
+        int fromX = from % width_ - (fromRow - (fromRow & 1)) / 2;
+        int toX = to % width_ - (toRow - (toRow & 1)) / 2;
+        int dx = fromX - toX;
+        int dz = fromRow - toRow;
+        int dy = -dx - dz;
+        return (std::abs(dx) + std::abs(dy) + std::abs(dz)) / 2;
+    }
+    
+    template<typename Input>
+    bool parseJSON(Input&& input, std::string* error);  // Shared by readJSON and fromJSON
+    
+    // Grid initialization helpers: initializeGrid() is createTiles() followed by syncAllTiles();
+    // loaders fill the fresh tiles in between. createTiles() is makeTiles() plus buildNeighbors().
     void initializeGrid();
+    void createTiles();
+    static std::vector<HexTile> makeTiles(int width, int height);
+    static int tileIndexIn(const HexCoordinate& coord, int width, int height);
+    void buildNeighbors();
+    void syncAllTiles();
     HexCoordinate offsetToHex(int col, int row) const;
     void offsetToHex(int col, int row, int& x, int& y, int& z) const;
 };
+
+template<typename Predicate>
+bool HexGrid::findPath(const HexCoordinate& start, const HexCoordinate& goal,
+                       PathfindingWorkspace& workspace, PathfindingResult& result,
+                       Predicate&& isPassable) const {
+    result.path.clear();
+    result.totalCost = 0;
+    result.pathFound = false;
+    
+    int startIndex = getTileIndex(start);
+    int goalIndex = getTileIndex(goal);
+    if (startIndex < 0 || goalIndex < 0) {
+        return false;
+    }
+    
+    workspace.begin(getTileCount());
+    workspace.relax(startIndex, 0, indexDistance(startIndex, goalIndex), -1);
+    
+    while (workspace.hasOpenNodes()) {
+        int current = workspace.popMin();
+        
+        if (current == goalIndex) {
+            // Reconstruct path
+            result.totalCost = workspace.getCost(current);
+            for (int index = goalIndex; index >= 0; index = workspace.getParent(index)) {
+                result.path.push_back(getCoordinateAt(index));
+            }
+            std::reverse(result.path.begin(), result.path.end());
+            result.pathFound = true;
+            return true;
+        }
+        
+        int currentCost = workspace.getCost(current);
+        const int* neighbors = &neighbors_[current * 6];
+        
+        // Inside a uniform region only continue straight or turn clockwise
+        int firstDirection = 0;
+        int directionCount = 6;
+        int parent = workspace.getParent(current);
+        if (symmetryReduction_ && parent >= 0 && isUniformAround(current, isPassable)) {
+            while (neighbors_[parent * 6 + firstDirection] != current) {
+                ++firstDirection;
+            }
+            directionCount = 2;
+        }
+        
+        for (int step = 0; step < directionCount; ++step) {
+            int direction = (firstDirection + step) % 6;
+            int neighbor = neighbors[direction];
+            if (neighbor < 0 || workspace.isClosed(neighbor)) {
+                continue;
+            }
+            
+            if constexpr (std::is_same_v<std::decay_t<Predicate>, DefaultPassable>) {
+                if (!isDefaultPassable(neighbor)) continue;
+            } else {
+                if (!isPassable(tiles_[neighbor])) continue;
+            }
+            
+            int gCost = currentCost + getStepCost(current, neighbor);
+            workspace.relax(neighbor, gCost, gCost + indexDistance(neighbor, goalIndex), current);
+        }
+    }
+    
+    return false; // No path found
+}
+
+template<typename Predicate>
+void HexGrid::calculateMovementRange(const HexCoordinate& start, int movementPoints,
+                                     PathfindingWorkspace& workspace, MovementField& field,
+                                     Predicate&& isPassable) const {
+    field.startIndex = getTileIndex(start);
+    field.maxMovementPoints = movementPoints;
+    field.tiles.clear();
+    field.costs.clear();
+    field.reachableBits.assign((tiles_.size() + 63) / 64, 0);
+    
+    if (field.startIndex < 0) {
+        return;
+    }
+    
+    constexpr bool defaultRule = std::is_same_v<std::decay_t<Predicate>, DefaultPassable>;
+    int maxStepCost = getMaxStepCost(defaultRule);
+    bool useBuckets = searchQueue_ == SearchQueue::BucketQueue ||
+                      (searchQueue_ == SearchQueue::Auto && maxStepCost <= MAX_BUCKET_QUEUE_COST);
+    
+    // Dijkstra: priority equals cost, nodes are settled in nondecreasing cost order
+    if (useBuckets) {
+        workspace.beginBuckets(getTileCount(), maxStepCost);
+        workspace.relaxBucket(field.startIndex, 0, -1);
+    } else {
+        workspace.begin(getTileCount());
+        workspace.relax(field.startIndex, 0, 0, -1);
+    }
+    
+    while (true) {
+        int current;
+        if (useBuckets) {
+            current = workspace.popMinBucket();
+            if (current < 0) break;
+        } else {
+            if (!workspace.hasOpenNodes()) break;
+            current = workspace.popMin();
+        }
+        field.tiles.push_back(current);
+        field.reachableBits[current >> 6] |= uint64_t(1) << (current & 63);
+        
+        int currentCost = workspace.getCost(current);
+        const int* neighbors = &neighbors_[current * 6];
+        
+        for (int direction = 0; direction < 6; ++direction) {
+            int neighbor = neighbors[direction];
+            if (neighbor < 0 || workspace.isClosed(neighbor)) {
+                continue;
+            }
+            
+            if constexpr (defaultRule) {
+                if (!isDefaultPassable(neighbor)) continue;
+            } else {
+                if (!isPassable(tiles_[neighbor])) continue;
+            }
+            
+            int newCost = currentCost + getStepCost(current, neighbor);
+            if (newCost <= movementPoints) {
+                if (useBuckets) {
+                    workspace.relaxBucket(neighbor, newCost, current);
+                } else {
+                    workspace.relax(neighbor, newCost, newCost, current);
+                }
+            }
+        }
+    }
+    
+    // Index order makes lookups binary-searchable; the workspace still holds the costs
+    std::sort(field.tiles.begin(), field.tiles.end());
+    field.costs.reserve(field.tiles.size());
+    for (int index : field.tiles) {
+        field.costs.push_back(workspace.getCost(index));
+    }
+}
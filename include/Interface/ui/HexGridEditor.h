@@ -72,12 +72,15 @@ public:
     // UIComponent interface
     void render() override;
     void handleEvent(const SDL_Event& event) override;
+    void onFrame(Uint32 ticks) override { invalidateRender(); } // Redrawn every retained frame
     bool canReceiveFocus() const override { return true; }
     
     // Grid management
     void newMap(int width, int height);
+    // Files ending in .hexmap use the binary map format, anything else JSON
     void loadMap(const std::string& filename);
     void saveMap(const std::string& filename) const;
+    static bool isBinaryMapFile(const std::string& filename);
     std::shared_ptr<HexGrid> getGrid() const { return grid_; }
     HexGridRenderer* getRenderer() const { return renderer_.get(); }
     
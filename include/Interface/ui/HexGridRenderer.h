@@ -1,18 +1,22 @@
 #pragma once
 #include "UIComponent.h"
 #include "HexGrid.h"
+#include "HexOverviewLayer.h"
 #include <SDL2/SDL.h>
 #include <memory>
 #include <vector>
+#include <unordered_map>
+
+class HexWorld;
 
 /**
  * Rendering configuration for hexagonal grid display
  */
 struct HexRenderConfig {
     float hexSize = 32.0f;           // Radius of hexagon in pixels
-    float borderThickness = 1.0f;    // Border line thickness
+    float borderThickness = 1.0f;    // Border line thickness; 0 draws grid lines instead
     bool showCoordinates = false;    // Display hex coordinates as text
-    bool showGrid = true;            // Show grid lines
+    bool showGrid = true;            // Show grid lines where tiles have no border
     bool showHighlights = true;      // Show tile highlights
     
     // Colors
@@ -28,6 +32,12 @@ struct HexRenderConfig {
     // Rendering optimizations
     bool enableCulling = true;       // Only render visible tiles
     int maxRenderDistance = 20;     // Maximum tiles to render from view center
+    
+    // Level of detail: zoom levels below which detail is dropped
+    float lodLabelZoom = 0.6f;       // Coordinate labels
+    float lodBorderZoom = 0.35f;     // Tile borders and grid lines
+    float lodMarkerZoom = 0.35f;     // Unit and supply markers become points, formation outlines hidden
+    float lodOverviewZoom = 0.2f;    // Hexagons replaced by the mipmapped terrain overview image
 };
 
 /**
@@ -38,15 +48,16 @@ class HexGridRenderer : public UIComponent {
 public:
     HexGridRenderer(int x, int y, int width, int height, SDLManager& sdlManager, 
                    std::shared_ptr<HexGrid> grid = nullptr);
-    ~HexGridRenderer() = default;
+    ~HexGridRenderer();
     
     // UIComponent interface
     void render() override;
+    void onFrame(Uint32 ticks) override { invalidateRender(); } // Redrawn every retained frame; the layer cache keeps it cheap
     void handleEvent(const SDL_Event& event) override;
     bool canReceiveFocus() const override { return true; }
     
     // Grid management
-    void setGrid(std::shared_ptr<HexGrid> grid) { grid_ = grid; }
+    void setGrid(std::shared_ptr<HexGrid> grid);
     std::shared_ptr<HexGrid> getGrid() const { return grid_; }
     
     // Rendering configuration
@@ -74,6 +85,7 @@ public:
     void highlightTile(const HexCoordinate& coord, const SDL_Color& color);
     void highlightTiles(const std::vector<HexCoordinate>& coords, const SDL_Color& color);
     void highlightMovementRange(const HexCoordinate& start, int movementPoints, const SDL_Color& color);
+    void highlightMovementRange(const MovementField& field, const SDL_Color& color); // From calculateMovementRanges
     void highlightAttackRange(const HexCoordinate& attacker, int range, const SDL_Color& color);
     void highlightPath(const std::vector<HexCoordinate>& path, const SDL_Color& color);
     void clearHighlights();
@@ -90,10 +102,36 @@ public:
     const HexCoordinate& getHoveredTile() const { return hoveredTile_; }
     bool hasHover() const { return hasHover_; }
     
-    // Visibility culling
-    std::vector<HexCoordinate> getVisibleTiles() const;
+    // Static map layer cache: terrain, borders, grid lines and coordinate labels are rendered
+    // into HEX_LAYER_CHUNK_SIZE render-target chunks and blitted while panning. Chunks are
+    // redrawn only when the grid reports terrain, height or layout changes inside them, or
+    // when appearance settings change. While zooming the chunks are drawn scaled and redrawn
+    // once the zoom settles. Falls back to direct drawing without render targets.
+    void setLayerCacheEnabled(bool enabled);
+    bool isLayerCacheEnabled() const { return layerCacheEnabled_; }
+    void invalidateMapLayer();
+    int getCachedChunkCount() const { return static_cast<int>(layerChunks_.size()); }
+    
+    // Indices of tiles with a unit or supply marker, ascending. Zoomed-out markers are drawn
+    // from this list rather than a scan of the view; it follows the grid's change journal.
+    const std::vector<int>& getMarkerTiles();
+    
+    // Visibility culling: tiles overlapping the component, in row-major order.
+    // Cached until pan, zoom, hex size, component size or grid dimensions change.
+    const std::vector<HexCoordinate>& getVisibleTiles() const;
     bool isTileVisible(const HexCoordinate& coord) const;
     
+    // Offset rectangle the view covers, not clipped to the grid; used to prefetch HexWorld chunks
+    // around a grid extracted from a larger world
+    void getViewOffsetBounds(int& minCol, int& minRow, int& maxCol, int& maxRow) const;
+    
+    // Streaming: the grid is a window extracted from world at (originCol, originRow). Every
+    // render queues the world chunks under the view plus half a chunk around it, so panning
+    // finds its neighbours built; the owner still calls HexWorld::update() and re-extracts.
+    void setStreamingWorld(HexWorld* world, int originCol = 0, int originRow = 0);
+    HexWorld* getStreamingWorld() const { return world_; }
+    void updateWorldPrefetch();   // Called by render(); queues only when the view rectangle moved
+    
     // Animation support (for unit movement, effects)
     void animateTileHighlight(const HexCoordinate& coord, const SDL_Color& color, float duration);
     void animatePathTrace(const std::vector<HexCoordinate>& path, float duration);
@@ -137,9 +175,91 @@ private:
     // Debug mode
     bool debugMode_ = false;
     
+    // Streaming world the grid was extracted from, and the last rectangle queued for prefetch
+    HexWorld* world_ = nullptr;
+    int worldOriginCol_ = 0, worldOriginRow_ = 0;
+    int prefetchedView_[4] = {0, 0, -1, -1};
+    
+    // Offset row/column ranges of the tiles overlapping a world-space rectangle
+    struct TileWindow {
+        int rowMin = 0, rowMax = -1;
+        int colMin[2] = {0, 0};   // Per row parity (odd rows are shifted half a hex)
+        int colMax[2] = {-1, -1};
+    };
+    
+    // Visible window and the tiles inside it, derived from the view
+    struct VisibleRegion {
+        const HexGrid* grid = nullptr;
+        int gridWidth = 0, gridHeight = 0;
+        int width = 0, height = 0;
+        float panX = 0.0f, panY = 0.0f, zoom = 0.0f, hexSize = 0.0f;
+        bool culling = true;
+        TileWindow window;
+        bool tilesListed = false;   // visibleTiles_ matches window
+    };
+    mutable VisibleRegion visibleRegion_;
+    mutable std::vector<HexCoordinate> visibleTiles_;
+    
+    // Triangle list reused across frames; submitted with one SDL_RenderGeometry call
+    struct GeometryBatch {
+        std::vector<SDL_Vertex> vertices;
+        std::vector<int> indices;
+        void clear() { vertices.clear(); indices.clear(); }
+    };
+    GeometryBatch fillBatch_;
+    GeometryBatch lineBatch_;
+    
+    // Static layer chunks keyed by chunk position in zoomed world space
+    struct LayerChunk {
+        SDL_Texture* texture = nullptr;
+        bool dirty = true;
+        uint64_t lastUsed = 0;
+    };
+    struct LayerSettings {
+        float zoom = 0.0f, hexSize = 0.0f, borderThickness = 0.0f;
+        bool showGrid = false, showCoordinates = false;
+        SDL_Color gridColor = {0, 0, 0, 0}, borderColor = {0, 0, 0, 0}, textColor = {0, 0, 0, 0};
+    };
+    static constexpr float LAYER_LABEL_MARGIN = 64.0f;  // Screen pixels a label may extend past its hexagon
+    static uint64_t chunkKey(int chunkX, int chunkY) {
+        return (static_cast<uint64_t>(static_cast<uint32_t>(chunkX)) << 32) | static_cast<uint32_t>(chunkY);
+    }
+    std::unordered_map<uint64_t, LayerChunk> layerChunks_;
+    std::vector<SDL_Texture*> freeChunkTextures_;
+    LayerSettings layerSettings_;
+    uint64_t layerFrame_ = 0;
+    float layerZoomTarget_ = 0.0f;     // Zoom the view is settling on, and since when
+    Uint32 layerZoomChangedAt_ = 0;
+    bool layerCacheEnabled_ = true;
+    bool renderTargetsUnavailable_ = false;
+    int changeCursorId_ = -1;                                 // HexGrid change journal
+    std::vector<HexGrid::TileChangeRecord> pendingChanges_;
+    
+    // Level of detail
+    struct DetailLevel {
+        bool labels;
+        bool borders;
+        bool markers;
+        bool overview;
+    };
+    HexOverviewLayer overview_;
+    bool overviewDirty_ = true;
+    std::vector<SDL_FRect> unitPoints_;
+    std::vector<SDL_FRect> supplyPoints_;
+    std::vector<int> markerTiles_;
+    bool markersDirty_ = true;   // Rescan the grid on next use
+    
     // Rendering helpers
-    void renderHexagon(const HexCoordinate& coord, const SDL_Color& fillColor, 
-                      const SDL_Color& borderColor, float borderThickness = 1.0f);
+    SDL_Color getTileFillColor(int index) const;
+    void getCornerOffsets(SDL_FPoint corners[6], float radius) const;
+    void appendHexagonFill(GeometryBatch& batch, float centerX, float centerY,
+                           const SDL_FPoint corners[6], const SDL_Color& color);
+    void appendHexagonOutline(GeometryBatch& batch, float centerX, float centerY,
+                              const SDL_FPoint corners[6], const SDL_Color& color, float thickness);
+    void submitBatch(GeometryBatch& batch);
+    // Tile edges go in one line batch: borders when they have a thickness, otherwise grid lines.
+    // Returns false when neither is drawn.
+    bool getEdgeStyle(bool showGrid, float borderThickness, SDL_Color& color, float& thickness) const;
     void renderHexagonOutline(const HexCoordinate& coord, const SDL_Color& color, float thickness = 1.0f);
     void renderTileContent(const HexCoordinate& coord);
     void renderTileText(const HexCoordinate& coord, const std::string& text, const SDL_Color& color);
@@ -155,6 +275,34 @@ private:
     
     // Culling and optimization
     bool shouldRenderTile(const HexCoordinate& coord) const;
+    void updateVisibleRegion() const;
+    void computeTileWindow(float minX, float minY, float maxX, float maxY, float hexSize, TileWindow& window) const;
+    
+    // Calls fn(tileIndex) for every tile in the visible window, without listing coordinates
+    template<typename Fn>
+    void forEachVisibleTile(Fn&& fn) const {
+        updateVisibleRegion();
+        const TileWindow& window = visibleRegion_.window;
+        int gridWidth = visibleRegion_.gridWidth;
+        for (int row = window.rowMin; row <= window.rowMax; ++row) {
+            for (int col = window.colMin[row & 1]; col <= window.colMax[row & 1]; ++col) {
+                fn(row * gridWidth + col);
+            }
+        }
+    }
+    
+    DetailLevel getDetailLevel() const { return getDetailLevel(config_.zoomLevel); }
+    DetailLevel getDetailLevel(float zoom) const;
+    void renderOverview();
+    
+    // Static layer cache
+    bool renderCachedMapLayer();
+    void renderLayerChunk(LayerChunk& chunk, int chunkX, int chunkY);
+    LayerSettings makeLayerSettings(float zoom) const;   // Effective settings after level of detail
+    static bool sameLayerSettings(const LayerSettings& a, const LayerSettings& b);
+    void releaseLayerChunks();
+    void applyGridChanges();
+    void onTileChanged(int index, uint8_t changes);
     
     // Event handlers
     void handleMouseClick(int x, int y, Uint8 button);
@@ -163,8 +311,8 @@ private:
     void handleKeyPress(SDL_Keycode key);
     
     // Rendering passes
-    void renderGrid();
     void renderTiles();
+    void renderTileMarkers();
     void renderHighlights();
     void renderSelection();
     void renderHover();
@@ -172,6 +320,7 @@ private:
     void renderOverlays();
     
     // Utility functions
-    float getHexagonRadius() const { return config_.hexSize * config_.zoomLevel; }
+    float getHexagonRadius() const { return getHexagonRadius(config_.hexSize, config_.zoomLevel); }
+    static float getHexagonRadius(float hexSize, float zoom) { return hexSize * zoom; }
     bool isValidHexCoordinate(const HexCoordinate& coord) const;
 };
@@ -0,0 +1,152 @@
+#pragma once
+#include "HexGrid.h"
+#include "HexTile.h"
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <vector>
+
+/**
+ * Binary hex map format (.hexmap)
+ * A fixed header is followed by a section directory and 64-byte aligned sections:
+ * packed per-tile arrays (terrain, height, HexGrid::TileFlags, movement cost) in the
+ * grid's row-major tile order, plus a sparse side table for tiles whose data does not
+ * fit the arrays (property overrides, tags, occupants, events). Multi-byte values are
+ * stored in native byte order; files from a machine of the other endianness are rejected.
+ */
+namespace HexMapFormat {
+    constexpr uint32_t MAGIC = 0x50414d48;          // "HMAP"
+    constexpr uint32_t VERSION = 1;
+    constexpr uint32_t BYTE_ORDER_MARK = 0x01020304;
+    constexpr size_t SECTION_ALIGNMENT = 64;
+    constexpr int64_t MAX_TILE_COUNT = INT32_MAX;   // Largest width * height any loader accepts
+
+    enum SectionType : uint32_t {
+        SECTION_TERRAIN = 1,        // uint8_t TerrainType per tile
+        SECTION_HEIGHT = 2,         // int8_t per tile
+        SECTION_FLAGS = 3,          // uint8_t HexGrid::TileFlags per tile
+        SECTION_MOVEMENT_COST = 4,  // uint8_t per tile, clamped to 255
+        SECTION_TILE_DETAILS = 5    // Side table, see HexMapTileDetails
+    };
+
+    struct Header {
+        uint32_t magic;
+        uint32_t version;
+        uint32_t byteOrderMark;
+        uint32_t sectionCount;
+        int32_t width;
+        int32_t height;
+        uint64_t fileSize;
+    };
+
+    struct Section {
+        uint32_t type;
+        uint32_t reserved;
+        uint64_t offset;        // From the start of the file
+        uint64_t size;
+    };
+}
+
+/**
+ * Side table entry for one tile: everything the packed arrays cannot express
+ */
+struct HexMapTileDetails {
+    int index = -1;
+    TileProperties properties;      // Full properties, replacing the terrain defaults
+    std::string occupantId;
+    std::vector<TileEvent> events;
+};
+
+namespace HexMapFormat {
+    // One tile's entries in the packed arrays
+    struct PackedTile {
+        TerrainType terrain = TerrainType::PLAIN;
+        int8_t height = 0;          // Clamped to the int8_t range
+        uint8_t flags = 0;          // HexGrid::TileFlags
+        uint8_t movementCost = 0;   // Clamped to 255
+    };
+    PackedTile packTile(const HexTile& tile);
+    inline int8_t packHeight(int height) {
+        return static_cast<int8_t>(std::max<int>(INT8_MIN, std::min<int>(INT8_MAX, height)));
+    }
+
+    // Rebuild a tile from its packed entries on top of the terrain defaults
+    void unpackTile(const PackedTile& packed, HexTile& tile);
+
+    // True if packTile/unpackTile lose something and the tile needs a side table entry
+    bool needsDetails(const HexTile& tile);
+    HexMapTileDetails makeDetails(int index, const HexTile& tile);
+    void applyDetails(const HexMapTileDetails& details, HexTile& tile);
+}
+
+/**
+ * Read-only view of a .hexmap file
+ * The file is memory-mapped where the platform supports it (read into memory otherwise).
+ * The packed arrays are used in place without parsing; the side table is decoded on
+ * request. Pointers stay valid until close() or destruction.
+ */
+class HexMapView {
+public:
+    HexMapView() = default;
+    ~HexMapView();
+
+    HexMapView(const HexMapView&) = delete;
+    HexMapView& operator=(const HexMapView&) = delete;
+
+    // Returns false and sets getError() if the file is missing, truncated or not a valid map
+    bool open(const std::string& filename);
+    void close();
+    bool isOpen() const { return data_ != nullptr; }
+    const std::string& getError() const { return error_; }
+
+    int getWidth() const { return width_; }
+    int getHeight() const { return height_; }
+    int getTileCount() const { return width_ * height_; }
+
+    // Packed tile arrays, getTileCount() entries each
+    const TerrainType* getTerrain() const { return terrain_; }
+    const int8_t* getHeights() const { return heights_; }
+    const uint8_t* getFlags() const { return flags_; }
+    const uint8_t* getMovementCosts() const { return movementCosts_; }
+
+    // Decode the side table; returns false if it is malformed
+    bool readTileDetails(std::vector<HexMapTileDetails>& details) const;
+
+private:
+    const uint8_t* data_ = nullptr;
+    size_t size_ = 0;
+    bool mapped_ = false;
+    std::vector<uint8_t> buffer_;   // File contents when not memory-mapped
+    std::string error_;
+
+    int width_ = 0;
+    int height_ = 0;
+    const TerrainType* terrain_ = nullptr;
+    const int8_t* heights_ = nullptr;
+    const uint8_t* flags_ = nullptr;
+    const uint8_t* movementCosts_ = nullptr;
+    const uint8_t* details_ = nullptr;
+    size_t detailsSize_ = 0;
+
+    bool fail(const std::string& message);
+};
+
+/**
+ * Writes a .hexmap file from packed tile arrays, each width * height entries long, or
+ * row by row from a callback so maps larger than memory can be written
+ */
+class HexMapWriter {
+public:
+    static bool write(const std::string& filename, int width, int height,
+                      const TerrainType* terrain, const int8_t* heights,
+                      const uint8_t* flags, const uint8_t* movementCosts,
+                      const std::vector<HexMapTileDetails>& details,
+                      std::string* error = nullptr);
+
+    // fillRow(section, row, out) writes the width bytes of one row of an array section
+    using RowSource = std::function<void(HexMapFormat::SectionType section, int row, uint8_t* out)>;
+    static bool write(const std::string& filename, int width, int height, const RowSource& fillRow,
+                      const std::vector<HexMapTileDetails>& details, std::string* error = nullptr);
+};
@@ -0,0 +1,63 @@
+#pragma once
+#include <SDL2/SDL.h>
+#include <cstdint>
+#include <vector>
+
+/**
+ * Terrain overview image for zoomed-out hex maps
+ * Each tile is two texels wide and one texel tall, with odd rows shifted right by one texel,
+ * so the image lines up with an odd-r hex layout. A CPU-side mip chain (alpha-weighted
+ * box filter) keeps minified tiles from shimmering. The image is split into
+ * HEX_LAYER_CHUNK_SIZE chunks whose textures are created per mip level on first use and
+ * re-uploaded only after a tile inside them changes.
+ */
+class HexOverviewLayer {
+public:
+    HexOverviewLayer() = default;
+    ~HexOverviewLayer();
+
+    HexOverviewLayer(const HexOverviewLayer&) = delete;
+    HexOverviewLayer& operator=(const HexOverviewLayer&) = delete;
+
+    // Reallocate for a grid of columns x rows tiles; every tile starts transparent
+    void resize(int columns, int rows);
+    void setTileColor(int col, int row, const SDL_Color& color);
+
+    // Draw the chunks overlapping a viewWidth x viewHeight target. The image's top-left texel
+    // lands at (originX, originY) and each level 0 texel covers texelWidth x texelHeight pixels.
+    void render(SDL_Renderer* renderer, float originX, float originY,
+                float texelWidth, float texelHeight, int viewWidth, int viewHeight);
+    void releaseTextures();
+
+    // Mip level whose texels are closest to, but not smaller than, half a screen pixel
+    int chooseLevel(float texelSize) const;
+
+    // Image queries (texels, all levels valid after render() or updateMipmaps())
+    void updateMipmaps();
+    int getLevelCount() const { return static_cast<int>(levels_.size()); }
+    int getLevelWidth(int level) const { return levels_[level].width; }
+    int getLevelHeight(int level) const { return levels_[level].height; }
+    SDL_Color getTexel(int level, int x, int y) const;
+    int getChunkCount() const { return chunksX_ * chunksY_; }
+
+private:
+    struct Level {
+        int width = 0;
+        int height = 0;
+        std::vector<uint8_t> pixels;    // RGBA32, row-major
+    };
+
+    struct Chunk {
+        std::vector<SDL_Texture*> textures;  // Per mip level, created on demand
+        uint32_t staleLevels = ~0u;          // Bit per level that needs uploading
+    };
+
+    std::vector<Level> levels_;
+    std::vector<Chunk> chunks_;
+    int chunksX_ = 0;
+    int chunksY_ = 0;
+    bool mipmapsDirty_ = true;       // Set by resize(); mips are then rebuilt in one pass
+
+    void downsampleTexel(int level, int x, int y);
+    void uploadChunk(SDL_Renderer* renderer, int chunkX, int chunkY, int level);
+};
@@ -0,0 +1,122 @@
+#pragma once
+#include "HexGrid.h"
+#include "PathfindingWorkspace.h"
+#include <cstdint>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+/**
+ * Hierarchical pathfinding (HPA*) for long routes on large grids
+ * The grid is split into square clusters of offset tiles. Each run of passable tiles
+ * facing each other across a cluster border gets one entrance pair (one at each end for
+ * long runs), and the costs between a cluster's entrances are precomputed by searches
+ * bounded to the cluster. A query links start and goal to the entrances of their clusters,
+ * runs A* over this abstract graph, then refines each abstract step with an A* bounded to
+ * one cluster. Routes are near-optimal: they only cross borders at entrances.
+ *
+ * Uses the default passability rule of HexGrid::findPath (passable and unoccupied; the start
+ * tile itself may be closed, as when a unit stands on it). Tile
+ * changes arrive through the grid's change journal; the next query rebuilds only the
+ * clusters around changed tiles. The grid must outlive the hierarchy.
+ */
+class HexPathHierarchy {
+public:
+    static constexpr int DEFAULT_CLUSTER_SIZE = 16;
+
+    explicit HexPathHierarchy(HexGrid& grid, int clusterSize = DEFAULT_CLUSTER_SIZE);
+    ~HexPathHierarchy();
+
+    HexPathHierarchy(const HexPathHierarchy&) = delete;
+    HexPathHierarchy& operator=(const HexPathHierarchy&) = delete;
+
+    // Same output as HexGrid::findPath
+    PathfindingResult findPath(const HexCoordinate& start, const HexCoordinate& goal);
+    bool findPath(const HexCoordinate& start, const HexCoordinate& goal, PathfindingResult& result);
+
+    // Lazy refinement: findRoute() plans the abstract route only, and refineSegment() appends
+    // the tiles of one step (without its first tile) when a unit gets there. Segment i runs
+    // from waypoints[i] to waypoints[i + 1]; it fails if the grid has since blocked it.
+    struct Route {
+        std::vector<int> waypoints;     // Tile indices: start, entrances, goal
+        int totalCost = 0;
+        bool found = false;
+    };
+    bool findRoute(const HexCoordinate& start, const HexCoordinate& goal, Route& route);
+    bool refineSegment(const Route& route, int segment, std::vector<HexCoordinate>& tiles);
+
+    // Apply pending grid changes now; queries do this themselves
+    void update();
+
+    // Statistics for profiling
+    int getClusterSize() const { return clusterSize_; }
+    int getClusterCount() const { return static_cast<int>(clusters_.size()); }
+    int getEntranceCount() const;
+    int getRebuiltClusterCount() const { return rebuiltClusters_; }    // Cumulative
+    int getLastExpandedCount() const { return lastExpanded_; }        // Abstract nodes, last query
+
+private:
+    struct Cluster {
+        int minCol = 0, minRow = 0, maxCol = 0, maxRow = 0;
+        std::vector<int> entrances;                         // Tile indices
+        std::vector<std::vector<std::pair<int, int>>> links; // Per entrance: (tile across the border, step cost)
+        std::vector<int> costs;                             // Entrance to entrance, row-major by source
+    };
+
+    HexGrid& grid_;
+    int clusterSize_;
+    int cursorId_;
+    int width_ = 0, height_ = 0;
+    int clustersX_ = 0, clustersY_ = 0;
+    std::vector<Cluster> clusters_;
+    std::vector<int> entranceSlot_;     // Per tile: index in its cluster's entrances, or -1
+
+    // Selected crossings per pair of adjacent clusters (lower id first): (tile in lower, tile in higher)
+    std::unordered_map<int64_t, std::vector<std::pair<int, int>>> borders_;
+
+    PathfindingWorkspace searchWorkspace_;      // Cluster-bounded tile searches
+    PathfindingWorkspace abstractWorkspace_;    // Entrance graph, indexed by tile
+    std::vector<HexGrid::TileChangeRecord> changes_;
+    std::vector<int> startCosts_, goalCosts_;
+
+    // Temporary edges out of a start tile that is not open itself (a unit on its own tile):
+    // it is no entrance, so its steps into neighboring clusters are linked here per query
+    struct StartLink {
+        int tile = -1;              // Open neighbor in another cluster
+        int stepCost = 0;
+        int goalCost = 0;           // Within the neighbor's cluster, if the goal is there
+        std::vector<int> costs;     // To the entrances of the neighbor's cluster
+    };
+    std::vector<StartLink> startLinks_;
+    std::vector<uint8_t> dirtyClusters_;
+    std::vector<int> refinedTiles_;
+    Route route_;
+    int rebuiltClusters_ = 0;
+    int lastExpanded_ = 0;
+
+    bool isOpen(int index) const {
+        return (grid_.getTileFlags(index) & (HexGrid::TILE_PASSABLE | HexGrid::TILE_OCCUPIED)) == HexGrid::TILE_PASSABLE;
+    }
+    int getClusterOf(int index) const {
+        return (index / width_ / clusterSize_) * clustersX_ + index % width_ / clusterSize_;
+    }
+    bool isInCluster(int index, const Cluster& cluster) const {
+        int col = index % width_;
+        int row = index / width_;
+        return col >= cluster.minCol && col <= cluster.maxCol && row >= cluster.minRow && row <= cluster.maxRow;
+    }
+    int64_t getBorderKey(int a, int b) const {
+        return static_cast<int64_t>(std::min(a, b)) * static_cast<int64_t>(clusters_.size()) + std::max(a, b);
+    }
+
+    template<typename Fn>
+    void forEachAdjacentCluster(int clusterId, Fn&& fn) const;
+
+    void rebuildAll();
+    void buildBorder(int a, int b);
+    void buildCluster(int clusterId);
+
+    // Dijkstra from source within one cluster into searchWorkspace_; reverse follows edges backwards
+    void searchCluster(const Cluster& cluster, int source, bool reverse);
+    bool refineInCluster(const Cluster& cluster, int from, int to, std::vector<int>& tiles);
+};
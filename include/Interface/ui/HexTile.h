@@ -3,12 +3,14 @@
 #include <string>
 #include <unordered_map>
 #include <vector>
+#include <cstdint>
+#include <iosfwd>
 #include <SDL2/SDL.h>
 
 /**
  * Terrain types for hexagonal tiles, inspired by Roman warfare
  */
-enum class TerrainType {
+enum class TerrainType : uint8_t {
     PLAIN,          // Basic terrain, 1 movement cost
     FOREST,         // +20% evasion, -10% ranged accuracy, 2 movement cost
     MOUNTAIN,       // +30% defense, -1 movement range, 3 movement cost
@@ -20,6 +22,7 @@ enum class TerrainType {
     CAMP,           // Supply point, restores morale/HP
     FORTIFICATION   // Buildable by engineers, +40% defense
 };
+constexpr int TERRAIN_TYPE_COUNT = static_cast<int>(TerrainType::FORTIFICATION) + 1;
 
 /**
  * Special tile properties and tags for Roman-themed gameplay
@@ -116,11 +119,15 @@ public:
     bool isFormationTile() const { return formationTile_; } // Part of a military formation
     void setFormationTile(bool formation) { formationTile_ = formation; }
     
-    // Serialization for map editor
+    // Serialization for map editor (HexMapJson.cpp). Occupancy and events are written only
+    // when present; fromJSON leaves unspecified fields at the terrain defaults.
+    void writeJSON(std::ostream& out) const;
     std::string toJSON() const;
     static HexTile fromJSON(const std::string& json);
 
 private:
+    friend class HexGrid; // Keeps coordinate_ in sync with its grid slot in HexGrid::setTile
+    
     HexCoordinate coordinate_;
     TerrainType terrainType_;
     int height_ = 0;
@@ -0,0 +1,80 @@
+#pragma once
+#include "HexGrid.h"
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+class WorkerPool;
+
+/**
+ * A unit that reveals the map around itself
+ */
+struct VisibilityObserver {
+    int id = 0;
+    HexCoordinate position;
+    int sightRange = 0;
+};
+
+/**
+ * Fog of war for one faction
+ * Computes the union field of view of all the faction's observers: each observer's
+ * HexGrid::computeFieldOfView (a shadow-casting sweep that agrees with hasLineOfSight)
+ * runs in parallel on a worker pool, then the results are merged
+ * into per-tile observer counts and a packed visibility bitset. Moving, adding or
+ * removing a single observer only re-sweeps that observer. Terrain changes that
+ * affect line of sight are picked up by update(). After the grid is resized, the next
+ * update or observer change recomputes everything against the new layout.
+ *
+ * The grid must outlive the map and must not be modified during a recompute.
+ */
+class HexVisibilityMap {
+public:
+    explicit HexVisibilityMap(const HexGrid& grid);
+
+    // Replace all observers and recompute from scratch (WorkerPool::shared() when pool is null)
+    void setObservers(const std::vector<VisibilityObserver>& observers, WorkerPool* pool = nullptr);
+
+    // Incremental updates for a single unit
+    void addObserver(const VisibilityObserver& observer);
+    void moveObserver(int id, const HexCoordinate& position);
+    void removeObserver(int id);
+
+    // Recompute every observer if line of sight changed since the last computation
+    // (or the grid was resized); returns true if anything was recomputed
+    bool update(WorkerPool* pool = nullptr);
+
+    // Queries
+    bool isVisible(int tileIndex) const {
+        return (visibleBits_[tileIndex >> 6] >> (tileIndex & 63)) & 1;
+    }
+    bool isVisible(const HexCoordinate& coord) const;
+    int getObserverCount(int tileIndex) const { return observerCounts_[tileIndex]; }
+    int getVisibleCount() const { return visibleCount_; }
+    const std::vector<uint64_t>& getVisibleBits() const { return visibleBits_; }
+
+    // Copy the visibility bits into HexTile::setVisible for rendering
+    void applyToGrid(HexGrid& grid) const;
+
+private:
+    struct ObserverState {
+        VisibilityObserver observer;
+        std::vector<int> visibleTiles;   // Last FOV sweep, tile indices
+    };
+
+    const HexGrid& grid_;
+    std::vector<ObserverState> observers_;
+    std::unordered_map<int, size_t> observerSlots_;  // id -> index in observers_
+    std::vector<uint16_t> observerCounts_;           // Observers seeing each tile
+    std::vector<uint64_t> visibleBits_;              // observerCounts_ > 0, packed
+    int visibleCount_ = 0;
+    uint64_t lineOfSightRevision_ = 0;
+    int tileCount_ = 0;
+    int gridWidth_ = 0, gridHeight_ = 0;             // Layout the counts and sweeps index
+
+    bool layoutChanged() const {
+        return grid_.getWidth() != gridWidth_ || grid_.getHeight() != gridHeight_;
+    }
+    void recomputeAll(WorkerPool* pool);
+    void addVisibility(const std::vector<int>& tiles);
+    void removeVisibility(const std::vector<int>& tiles);
+};
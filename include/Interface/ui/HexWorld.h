@@ -0,0 +1,143 @@
+#pragma once
+#include "HexGrid.h"
+#include "HexMapFile.h"
+#include <condition_variable>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+/**
+ * Chunked, streaming hex world backed by a .hexmap file
+ * For maps too large to hold as one HexGrid. The file stays memory-mapped and HexTile
+ * objects exist only for resident CHUNK_SIZE x CHUNK_SIZE chunks (offset coordinates).
+ * At most getChunkBudget() chunks are resident; the least recently used one is evicted
+ * first. An edited chunk is packed back to the compact .hexmap form (4 bytes per tile
+ * plus side table entries) when evicted, and save() writes the world with all edits.
+ * Packed edits are not spilled to disk: they stay in memory until close(), about 4 KB per
+ * edited chunk, so memory grows with the edited area rather than the world. Saving and
+ * reopening the world folds them into the file and releases them.
+ *
+ * prefetchRegion() and prefetchPath() queue chunks for a background thread that builds
+ * them from the file; update() installs the finished chunks. Pathfinding and rendering
+ * run on a regular HexGrid filled by extractRegion(); HexGridRenderer::setStreamingWorld()
+ * prefetches around the rendered view.
+ *
+ * Use from one thread. Tile pointers stay valid until the next call that can page chunks
+ * in or out: getTile, editTile, update, extractRegion, setChunkBudget and close.
+ */
+class HexWorld {
+public:
+    static constexpr int CHUNK_SIZE = 32;
+
+    explicit HexWorld(int chunkBudget = 256);
+    ~HexWorld();
+
+    HexWorld(const HexWorld&) = delete;
+    HexWorld& operator=(const HexWorld&) = delete;
+
+    bool open(const std::string& filename, std::string* error = nullptr);
+    void close();   // Discards unsaved edits
+    bool isOpen() const { return map_.isOpen(); }
+
+    int getWidth() const { return map_.getWidth(); }
+    int getHeight() const { return map_.getHeight(); }
+    bool isValidOffset(int col, int row) const {
+        return col >= 0 && row >= 0 && col < getWidth() && row < getHeight();
+    }
+
+    // Tile access by offset coordinates, paging the chunk in if needed; nullptr outside the world
+    const HexTile* getTile(int col, int row);
+    const HexTile* getTile(const HexCoordinate& coord);
+    HexTile* editTile(int col, int row);    // Marks the chunk as modified
+    HexTile* editTile(const HexCoordinate& coord);
+
+    // Background prefetch of the chunks overlapping an offset rectangle (a viewport), or a
+    // corridor of margin tiles around the straight line between two tiles (a path query).
+    // Requests beyond the chunk budget are dropped, nearest first is kept.
+    void prefetchRegion(int minCol, int minRow, int maxCol, int maxRow);
+    void prefetchPath(const HexCoordinate& start, const HexCoordinate& goal, int margin = CHUNK_SIZE / 2);
+    void update();              // Install prefetched chunks; call once per frame or turn
+    void waitForPrefetch();     // Block until queued chunks are built (update() installs them)
+
+    // Copy a window into grid. minRow is rounded down to an even row to keep the offset layout:
+    // world tile (col, row) becomes grid tile (col - originCol, row - originRow).
+    void extractRegion(int minCol, int minRow, int maxCol, int maxRow, HexGrid& grid,
+                       int& originCol, int& originRow);
+
+    // Write the world including edits, a row at a time; safe to target the open file
+    bool save(const std::string& filename, std::string* error = nullptr);
+
+    // Residency
+    int getChunkBudget() const { return chunkBudget_; }
+    void setChunkBudget(int chunks);
+    int getResidentChunkCount() const { return static_cast<int>(chunks_.size()); }
+    bool isChunkResident(int col, int row) const;
+    int getChunkLoadCount() const { return chunkLoads_; }           // Synchronous page-ins
+    int getPrefetchedChunkCount() const { return chunksPrefetched_; }
+
+private:
+    struct Chunk {
+        int chunkX = 0, chunkY = 0;
+        int cols = 0, rows = 0;
+        std::vector<HexTile> tiles;     // Row-major within the chunk
+        bool modified = false;
+        uint64_t lastUse = 0;
+    };
+
+    // An evicted modified chunk; immutable once stored, replaced on the next eviction
+    struct PackedChunk {
+        std::vector<HexMapFormat::PackedTile> tiles;
+        std::vector<HexMapTileDetails> details;     // World tile indices
+    };
+
+    struct PrefetchRequest {
+        int chunkIndex;
+        std::shared_ptr<const PackedChunk> packed;
+        uint64_t generation;
+    };
+    struct PrefetchResult {
+        int chunkIndex;
+        std::shared_ptr<const PackedChunk> packed;  // Source the chunk was built from
+        std::unique_ptr<Chunk> chunk;
+    };
+
+    HexMapView map_;
+    int chunksX_ = 0, chunksY_ = 0;
+    std::unordered_map<int, std::vector<HexMapTileDetails>> baseDetails_;  // File side table by chunk
+    std::unordered_map<int, std::shared_ptr<const PackedChunk>> packedChunks_;   // Kept until close()
+
+    std::unordered_map<int, std::unique_ptr<Chunk>> chunks_;
+    int chunkBudget_;
+    uint64_t useCounter_ = 0;
+    int lastChunkIndex_ = -1;           // One-entry lookup cache for getTile
+    Chunk* lastChunk_ = nullptr;
+    int chunkLoads_ = 0;
+    int chunksPrefetched_ = 0;
+
+    // Prefetch thread; requests_, results_, busy_, generation_ and stopping_ are guarded by mutex_
+    std::thread worker_;
+    std::mutex mutex_;
+    std::condition_variable wake_;
+    std::condition_variable idle_;
+    std::deque<PrefetchRequest> requests_;
+    std::vector<PrefetchResult> results_;
+    std::unordered_set<int> queuedChunks_;      // Owner thread only
+    uint64_t generation_ = 0;
+    bool busy_ = false;
+    bool stopping_ = false;
+
+    int getChunkIndex(int col, int row) const { return (row / CHUNK_SIZE) * chunksX_ + col / CHUNK_SIZE; }
+    Chunk* acquireChunk(int chunkIndex);
+    std::unique_ptr<Chunk> buildChunk(int chunkIndex, const PackedChunk* packed) const;
+    void installChunk(int chunkIndex, std::unique_ptr<Chunk> chunk);
+    void evictToBudget(int keepChunk);
+    void packChunk(int chunkIndex, const Chunk& chunk);
+    void queuePrefetch(std::vector<int>& chunkIndices, int centerCol, int centerRow);
+    void cancelPrefetch();
+    void workerLoop();
+};
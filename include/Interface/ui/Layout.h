@@ -329,7 +329,7 @@ namespace LayoutFactory {
             int currentY = containerY;
             for (auto& child : children) {
                 if (!child) continue;
-                child->layout();
+                child->updateLayout();
                 child->setPosition(containerX, currentY);
                 currentY += child->getHeight() + spacing;
             }
@@ -359,7 +359,7 @@ namespace LayoutFactory {
             int currentX = containerX;
             for (auto& child : children) {
                 if (!child) continue;
-                child->layout();
+                child->updateLayout();
                 child->setPosition(currentX, containerY);
                 currentX += child->getWidth() + spacing;
             }
@@ -403,7 +403,7 @@ namespace LayoutFactory {
                         continue;
                     }
                     
-                    child->layout();
+                    child->updateLayout();
                     int x = containerX + col * (cellWidth + spacing);
                     int y = containerY + row * (cellHeight + spacing);
                     child->setPosition(x, y);
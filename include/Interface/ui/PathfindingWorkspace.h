@@ -0,0 +1,70 @@
+#pragma once
+#include <vector>
+#include <cstdint>
+
+/**
+ * Reusable scratch memory for grid searches (A*, Dijkstra)
+ * Node records are indexed by tile index and stamped with a search generation,
+ * so starting a new search is O(1) instead of clearing per-tile state. The open
+ * set is either an indexed binary min-heap supporting decrease-key, or a circular
+ * bucket queue (Dial's algorithm) for small integer edge costs. Once the arrays have
+ * grown to the grid size, repeated searches allocate nothing.
+ *
+ * A workspace must not be shared between threads running searches concurrently.
+ */
+class PathfindingWorkspace {
+public:
+    PathfindingWorkspace() = default;
+
+    // Start a new search over a grid with tileCount tiles
+    void begin(int tileCount);
+
+    // Node state for the current search
+    bool isVisited(int index) const { return nodes_[index].generation == generation_; }
+    bool isClosed(int index) const { return isVisited(index) && nodes_[index].heapIndex == CLOSED; }
+    int getCost(int index) const { return nodes_[index].gCost; }
+    int getParent(int index) const { return nodes_[index].parent; }
+
+    // Insert a node into the open set, or lower its priority if already open.
+    // Returns false (and changes nothing) if the node is closed or not improved.
+    bool relax(int index, int gCost, int priority, int parent);
+
+    // Remove and close the open node with the lowest priority
+    bool hasOpenNodes() const { return !heap_.empty(); }
+    int popMin();
+
+    // Bucket queue variant for Dijkstra with integer edge costs in [0, maxEdgeCost]:
+    // O(1) push, pops scan at most one bucket per distinct cost value
+    void beginBuckets(int tileCount, int maxEdgeCost);
+    bool relaxBucket(int index, int gCost, int parent);
+    int popMinBucket(); // -1 when no open nodes remain
+
+    // Statistics for profiling
+    int getExpandedCount() const { return expanded_; }
+
+private:
+    static constexpr int CLOSED = -1;
+    static constexpr int IN_BUCKET = 0;
+
+    struct Node {
+        uint32_t generation = 0;
+        int gCost = 0;
+        int priority = 0;       // gCost + heuristic
+        int parent = -1;
+        int heapIndex = CLOSED;
+    };
+
+    std::vector<Node> nodes_;
+    std::vector<int> heap_;     // Tile indices ordered as a binary heap
+    uint32_t generation_ = 0;
+    int expanded_ = 0;
+
+    std::vector<std::vector<int>> buckets_; // Ring indexed by cost % ringSize_
+    int ringSize_ = 0;
+    int bucketCost_ = 0;                    // Cost of the bucket being drained
+    int pendingEntries_ = 0;                // Entries in buckets, including stale ones
+
+    bool heapLess(int a, int b) const;
+    void siftUp(int position);
+    void siftDown(int position);
+};
@@ -4,6 +4,7 @@
 #include <SDL2/SDL.h>
 #include "UIComponent.h"
 #include "Layout.h"
+#include "UIHitGrid.h"
 
 // Forward declaration
 class SDLManager;
@@ -27,11 +28,16 @@ private:
     bool scrollable_ = false;
     int scrollOffset_ = 0;
     bool autoLayout_ = false; // Automatic layout after child changes
+    
+    // Child hit-test index, stale after children change or the layout moves them
+    mutable UIHitGrid hitGrid_;
+    mutable bool hitGridStale_ = true;
 
     bool isChildVisible(const std::shared_ptr<UIComponent>& child) const;
 
 public:
     SimpleContainer(int x, int y, int width, int height, SDLManager& sdl);
+    ~SimpleContainer() override;
     
     // === Forward Compatibility ===
     static std::shared_ptr<SimpleContainer> createUIContainerReplacement(
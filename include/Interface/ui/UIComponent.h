@@ -7,6 +7,7 @@
 
 // Forward declaration
 class SDLManager;
+class UIManager;
 
 /**
  * Abstract base class for all UI components
@@ -22,6 +23,24 @@ public:
 
     // Layout and rendering separation
     virtual void layout() {} // Optional layout calculation - implement if component needs layout logic
+    
+    // Retained layout: anything that changes a component's layout marks it and its ancestors dirty,
+    // and updateLayout() runs layout() only while the component is dirty
+    void updateLayout();
+    void invalidateLayout();
+    bool isLayoutDirty() const { return layoutDirty_; }
+    
+    // Retained rendering: anything that changes how a component looks damages its screen rect
+    // in the UIManager holding it (or its top-level ancestor), see UIManager::renderRetained
+    void invalidateRender();
+    
+    // Called once per retained frame for top-level and focused components; time-driven visuals
+    // (animations, a blinking cursor) call invalidateRender() here when their look changes
+    virtual void onFrame(Uint32 ticks) {}
+    
+    // Containing component, set by containers in addChild/removeChild
+    UIComponent* getParent() const { return parent_; }
+    void setParent(UIComponent* parent) { parent_ = parent; }
     virtual void render() = 0; // Pure virtual function for rendering - must be implemented by derived classes
     
     // Optional event handler for components (mouse/keyboard/scroll)
@@ -43,20 +62,20 @@ public:
     void setSize(int width, int height);
     
     // Z-order and modal properties
-    void setZOrder(int zOrder) { zOrder_ = zOrder; }
+    void setZOrder(int zOrder); // Keeps the owning UIManager's render order up to date
     int getZOrder() const { return zOrder_; }
     void setModal(bool modal) { isModal_ = modal; }
     bool isModal() const { return isModal_; }
     
     // Focus properties
-    void setFocused(bool focused) { hasFocus_ = focused; }
+    void setFocused(bool focused) { if (hasFocus_ != focused) { hasFocus_ = focused; invalidateRender(); } }
     bool hasFocus() const { return hasFocus_; }
     
     // Visibility and enabled state for data binding
-    virtual void setVisible(bool visible) { visible_ = visible; }
+    virtual void setVisible(bool visible) { if (visible_ != visible) { visible_ = visible; invalidateRender(); } }
     bool isVisible() const { return visible_; }
     
-    virtual void setEnabled(bool enabled) { enabled_ = enabled; }
+    virtual void setEnabled(bool enabled) { if (enabled_ != enabled) { enabled_ = enabled; invalidateRender(); } }
     bool isEnabled() const { return enabled_; }
     
     // Getters
@@ -65,6 +84,12 @@ public:
     int getWidth() const { return width_; }
     int getHeight() const { return height_; }
     SDL_Rect getRect() const { return {x_, y_, width_, height_}; }
+    
+    // Area a component may draw to: its rect plus room for thick borders and focus rings
+    static constexpr int RENDER_MARGIN = 4;
+    SDL_Rect getRenderBounds() const {
+        return {x_ - RENDER_MARGIN, y_ - RENDER_MARGIN, width_ + 2 * RENDER_MARGIN, height_ + 2 * RENDER_MARGIN};
+    }
 
 protected:
     int x_, y_, width_, height_;
@@ -81,4 +106,24 @@ protected:
     
     // Helper function to get text dimensions
     void getTextSize(const std::string& text, int& width, int& height);
+    
+    // Clipping for components that clip their children: the new clip is intersected with the
+    // active one, and popClipRect restores it. Returns false (clip unchanged) if nothing is visible.
+    struct ClipState {
+        SDL_Rect rect;      // Previous clip
+        bool enabled;
+        SDL_Rect visible;   // Clip in effect until popClipRect
+    };
+    bool pushClipRect(const SDL_Rect& clip, ClipState& saved);
+    void popClipRect(const ClipState& saved);
+    
+    static bool sameColor(const SDL_Color& a, const SDL_Color& b) {
+        return a.r == b.r && a.g == b.g && a.b == b.b && a.a == b.a;
+    }
+
+private:
+    friend class UIManager;
+    UIManager* owner_ = nullptr; // Manager holding this component, told about z-order changes
+    UIComponent* parent_ = nullptr;
+    bool layoutDirty_ = true; // New components have never been laid out
 };
\ No newline at end of file
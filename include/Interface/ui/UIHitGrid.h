@@ -0,0 +1,66 @@
+#pragma once
+#include <SDL2/SDL.h>
+#include <vector>
+
+/**
+ * Uniform-grid index of screen rects for pointer hit-testing
+ * Rects are added in stacking order (bottom first) and identified by that index. A query
+ * only looks at the entries bucketed in the cell under the point, so routing the mouse
+ * costs the same with thousands of components as with ten. Containment matches
+ * UIComponent::isPointInside (edges inclusive). Rects spanning many cells, like full-screen
+ * panels, go to a separate list instead of filling every cell.
+ */
+class UIHitGrid {
+public:
+    void build(const std::vector<SDL_Rect>& rects);
+    void clear();
+    bool empty() const { return rects_.empty(); }
+    int size() const { return static_cast<int>(rects_.size()); }
+
+    // Index of the top-most rect containing the point for which accept(index) returns true,
+    // or -1. Candidates are offered from the top down.
+    template <typename Accept>
+    int findTopmost(int x, int y, Accept accept) const;
+
+private:
+    static constexpr int MIN_CELL_SIZE = 16;
+    static constexpr int MAX_CELLS_PER_RECT = 16;
+
+    std::vector<SDL_Rect> rects_;
+    std::vector<std::vector<int>> cells_;   // Ascending rect indices per cell
+    std::vector<int> large_;                // Ascending indices of rects kept out of the cells
+    SDL_Rect bounds_ = {0, 0, 0, 0};        // Inclusive extents of every rect
+    int cellSize_ = MIN_CELL_SIZE;
+    int columns_ = 0, rows_ = 0;
+
+    bool contains(int index, int x, int y) const {
+        const SDL_Rect& r = rects_[index];
+        return x >= r.x && x <= r.x + r.w && y >= r.y && y <= r.y + r.h;
+    }
+};
+
+template <typename Accept>
+int UIHitGrid::findTopmost(int x, int y, Accept accept) const {
+    if (x < bounds_.x || y < bounds_.y || x >= bounds_.x + bounds_.w || y >= bounds_.y + bounds_.h) {
+        return -1;
+    }
+    const int column = (x - bounds_.x) / cellSize_;
+    const int row = (y - bounds_.y) / cellSize_;
+    const std::vector<int>& cell = cells_[row * columns_ + column];
+
+    // Both lists ascend, so merge them from the back to visit candidates top-down
+    auto c = cell.rbegin();
+    auto l = large_.rbegin();
+    while (c != cell.rend() || l != large_.rend()) {
+        int index;
+        if (l == large_.rend() || (c != cell.rend() && *c > *l)) {
+            index = *c++;
+        } else {
+            index = *l++;
+        }
+        if (contains(index, x, y) && accept(index)) {
+            return index;
+        }
+    }
+    return -1;
+}
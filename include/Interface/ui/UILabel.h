@@ -28,21 +28,26 @@ public:
     const std::string& getText() const { return text_; }
     
     // Styling options
-    void setTextColor(SDL_Color color) { textColor_ = color; }
+    void setTextColor(SDL_Color color) { if (!sameColor(textColor_, color)) { textColor_ = color; invalidateRender(); } }
     SDL_Color getTextColor() const { return textColor_; }
     
-    void setBackgroundColor(SDL_Color color) { backgroundColor_ = color; hasBackground_ = true; }
-    void setTransparentBackground() { hasBackground_ = false; }
+    void setBackgroundColor(SDL_Color color) {
+        if (hasBackground_ && sameColor(backgroundColor_, color)) return;
+        backgroundColor_ = color;
+        hasBackground_ = true;
+        invalidateRender();
+    }
+    void setTransparentBackground() { if (hasBackground_) { hasBackground_ = false; invalidateRender(); } }
     bool hasBackground() const { return hasBackground_; }
     
-    void setTextAlignment(TextAlignment alignment) { textAlignment_ = alignment; }
+    void setTextAlignment(TextAlignment alignment) { textAlignment_ = alignment; invalidateRender(); }
     TextAlignment getTextAlignment() const { return textAlignment_; }
     
-    void setWordWrap(bool wrap) { wordWrap_ = wrap; }
+    void setWordWrap(bool wrap) { wordWrap_ = wrap; invalidateLayout(); invalidateRender(); }
     bool getWordWrap() const { return wordWrap_; }
     
     // Auto-sizing functionality
-    void setAutoResize(bool autoResize) { autoResize_ = autoResize; }
+    void setAutoResize(bool autoResize) { autoResize_ = autoResize; invalidateLayout(); }
     bool getAutoResize() const { return autoResize_; }
     void autoResizeToFitText(); // Resize to fit current text content
 
@@ -4,6 +4,7 @@
 #include <SDL2/SDL.h>
 #include "UIComponent.h"
 #include "Layout.h"
+#include "UIHitGrid.h"
 
 /**
  * @deprecated UILayoutContainer is deprecated. Use SimpleContainer instead.
@@ -22,7 +23,7 @@
 class UILayoutContainer : public UIComponent {
 public:
     UILayoutContainer(int x, int y, int width, int height, SDLManager& sdl);
-    ~UILayoutContainer() override = default;
+    ~UILayoutContainer() override;
 
     // Child management
     void addChild(std::shared_ptr<UIComponent> child);
@@ -53,7 +54,7 @@ public:
     virtual int getMaxScroll() const;
     
     // Enable/disable scrolling
-    void setScrollable(bool scrollable) { scrollable_ = scrollable; }
+    void setScrollable(bool scrollable) { scrollable_ = scrollable; invalidateLayout(); }
     bool isScrollable() const { return scrollable_; }
 
     // Layout & render separation
@@ -81,7 +82,10 @@ protected:
     // Helper methods
     bool isChildVisible(const std::shared_ptr<UIComponent>& child) const;
     void updateScrollBounds();
+    void updateChildLayouts(); // Lays out children the layout pass moved or resized
 
 private:
-    // Currently no private members needed
+    // Child hit-test index, stale after children change or the layout moves them
+    mutable UIHitGrid hitGrid_;
+    mutable bool hitGridStale_ = true;
 };
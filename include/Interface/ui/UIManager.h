@@ -1,8 +1,10 @@
 #pragma once
 #include <vector>
 #include <memory>
+#include <cstdint>
 #include <SDL2/SDL.h>
 #include "UIComponent.h"
+#include "UIHitGrid.h"
 
 /**
  * Simple UI Manager that holds persistent and dynamic UI components.
@@ -13,7 +15,10 @@
 class UIManager {
 public:
     UIManager() = default;
-    ~UIManager() = default;
+    ~UIManager();
+
+    UIManager(const UIManager&) = delete;
+    UIManager& operator=(const UIManager&) = delete;
 
     // Add a component. If persistent is true it will remain until clearPersistent()
     void addComponent(std::shared_ptr<UIComponent> comp, bool persistent = true);
@@ -34,6 +39,20 @@ public:
 
     // Layout and render only components that are fully inside the provided clip rect
     void layoutAndRenderClipped(const SDL_Rect& clip);
+    
+    // Retained rendering: the UI is kept in a cached frame texture and only components that
+    // intersect damaged rectangles are rendered again, over the background color. Returns false
+    // when nothing changed, so the caller can skip presenting; otherwise the frame has been
+    // copied to the current render target. The UI owns the whole frame in this mode. Without
+    // render-target support every damaged frame is drawn in full.
+    bool renderRetained(SDL_Renderer* renderer, SDL_Color background);
+    
+    // Damage tracking for renderRetained; components report their own changes
+    void invalidateRect(const SDL_Rect& rect);
+    void invalidateAll();
+    bool hasDamage() const { return fullDamage_ || !damage_.empty(); }
+    const std::vector<SDL_Rect>& getDamageRects() const { return damage_; }   // Pending, merged
+    int getLastRedrawArea() const { return lastRedrawArea_; }                 // Pixels, last retained frame
 
     // Find top-most component at a point (considers z-order and modal state)
     std::shared_ptr<UIComponent> getComponentAt(int x, int y) const;
@@ -58,10 +77,41 @@ public:
     void bringToTop(std::shared_ptr<UIComponent> component);
     void sendToBottom(std::shared_ptr<UIComponent> component);
 
+    // Called by UIComponent::setZOrder for components held by this manager
+    void onZOrderChanged(UIComponent* component);
+    // Called when a component held by this manager may have moved or resized
+    void onBoundsChanged(UIComponent*) { hitGridDirty_ = true; }
+
 private:
     std::vector<std::shared_ptr<UIComponent>> persistent_;
     std::vector<std::shared_ptr<UIComponent>> dynamic_;
     
+    // Every component in render order: ascending z-order, then insertion order. Kept sorted as
+    // components are added, cleared or change z-order, so rendering and hit-testing walk it
+    // without copying shared_ptrs or sorting. A component belongs to one manager at a time.
+    struct RenderEntry {
+        UIComponent* component;
+        uint64_t sequence;
+        bool persistent;
+        size_t slot;        // Index in persistent_ or dynamic_, which only grow or clear
+    };
+    std::vector<RenderEntry> renderList_;
+    uint64_t nextSequence_ = 0;
+    
+    // Hit-test index over the render list, rebuilt on the first query after it changes
+    mutable UIHitGrid hitGrid_;
+    mutable bool hitGridDirty_ = true;
+    
+    // Retained rendering state. Damage rects are merged while they overlap.
+    static constexpr size_t MAX_DAMAGE_RECTS = 16;
+    std::vector<SDL_Rect> damage_;
+    std::vector<SDL_Rect> frameDamage_;
+    bool fullDamage_ = true;
+    SDL_Renderer* frameRenderer_ = nullptr;
+    SDL_Texture* frameCache_ = nullptr;
+    int frameWidth_ = 0, frameHeight_ = 0;
+    int lastRedrawArea_ = 0;
+    
     // Focus and modal management
     std::weak_ptr<UIComponent> focusedComponent_;
     std::weak_ptr<UIComponent> modalComponent_;
@@ -70,4 +120,13 @@ private:
     std::vector<std::shared_ptr<UIComponent>> getAllComponents() const;
     std::vector<std::shared_ptr<UIComponent>> getFocusableComponents() const;
     void sortComponentsByZOrder(std::vector<std::shared_ptr<UIComponent>>& components) const;
+    void sortRenderList();
+    void removeFromRenderList(bool persistent);
+    void rebuildHitGrid() const;
+    const std::shared_ptr<UIComponent>& getOwned(const RenderEntry& entry) const {
+        return entry.persistent ? persistent_[entry.slot] : dynamic_[entry.slot];
+    }
+    bool ensureFrameCache(SDL_Renderer* renderer, int width, int height);
+    void releaseFrameCache();
+    void renderDamage(const SDL_Rect& area);
 };
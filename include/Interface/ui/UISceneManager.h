@@ -34,6 +34,16 @@ public:
     bool isPaused() const { return paused_; }
     void setPaused(bool paused) { paused_ = paused; }
     
+    // Retained rendering: the scene draws only through its UIManager, which keeps the frame
+    // and redraws just the damaged parts over the background (UIManager::renderRetained).
+    // render() is not called for retained scenes.
+    void setRetainedRendering(bool enabled, SDL_Color background = {0, 0, 0, 255}) {
+        retainedRendering_ = enabled;
+        background_ = background;
+    }
+    bool isRetainedRendering() const { return retainedRendering_; }
+    SDL_Color getBackgroundColor() const { return background_; }
+    
     // UI Manager access
     UIManager& getUIManager() { return uiManager_; }
     const UIManager& getUIManager() const { return uiManager_; }
@@ -41,6 +51,8 @@ public:
 protected:
     bool active_ = false;
     bool paused_ = false;
+    bool retainedRendering_ = false;
+    SDL_Color background_ = {0, 0, 0, 255};
     UIManager uiManager_;
     
     friend class UISceneManager;
@@ -94,7 +106,9 @@ public:
     
     // Frame methods
     void update(float deltaTime);
-    void render();
+    // Returns false when nothing changed since the last frame (a lone retained scene with no
+    // damage); the previous frame is still current and presenting can be skipped
+    bool render();
     void handleEvent(const SDL_Event& event);
     
     // Scene stack info
@@ -121,6 +135,9 @@ private:
     std::shared_ptr<UIScene> transitionFromScene_;
     std::shared_ptr<UIScene> transitionToScene_;
     
+    // Scene whose retained frame was drawn last; any other rendering invalidates it
+    const UIScene* retainedScene_ = nullptr;
+    
     // Global data sharing between scenes
     std::unordered_map<std::string, std::string> globalData_;
     
@@ -21,6 +21,7 @@ public:
     void layout() override;
     void render() override;
     void handleEvent(const SDL_Event& event) override;
+    void onFrame(Uint32 ticks) override; // Cursor blink
     
     // Focus handling
     void onFocusGained() override;
@@ -33,30 +34,30 @@ public:
     void clearText();
     
     // Placeholder text
-    void setPlaceholder(const std::string& placeholder) { placeholderText_ = placeholder; }
+    void setPlaceholder(const std::string& placeholder) { placeholderText_ = placeholder; invalidateRender(); }
     const std::string& getPlaceholder() const { return placeholderText_; }
     
     // Input properties
     void setMaxLength(size_t maxLength) { maxLength_ = maxLength; }
     size_t getMaxLength() const { return maxLength_; }
     
-    void setReadOnly(bool readOnly) { readOnly_ = readOnly; }
+    void setReadOnly(bool readOnly) { readOnly_ = readOnly; invalidateRender(); }
     bool isReadOnly() const { return readOnly_; }
     
-    void setPassword(bool isPassword) { isPassword_ = isPassword; }
+    void setPassword(bool isPassword) { isPassword_ = isPassword; invalidateRender(); }
     bool isPassword() const { return isPassword_; }
     
     // Styling
-    void setTextColor(SDL_Color color) { textColor_ = color; }
+    void setTextColor(SDL_Color color) { textColor_ = color; invalidateRender(); }
     SDL_Color getTextColor() const { return textColor_; }
     
-    void setBackgroundColor(SDL_Color color) { backgroundColor_ = color; }
+    void setBackgroundColor(SDL_Color color) { backgroundColor_ = color; invalidateRender(); }
     SDL_Color getBackgroundColor() const { return backgroundColor_; }
     
-    void setBorderColor(SDL_Color color) { borderColor_ = color; }
+    void setBorderColor(SDL_Color color) { borderColor_ = color; invalidateRender(); }
     SDL_Color getBorderColor() const { return borderColor_; }
     
-    void setPlaceholderColor(SDL_Color color) { placeholderColor_ = color; }
+    void setPlaceholderColor(SDL_Color color) { placeholderColor_ = color; invalidateRender(); }
     SDL_Color getPlaceholderColor() const { return placeholderColor_; }
     
     // Theme support - batch color setting
@@ -65,6 +66,7 @@ public:
         textColor_ = text;
         borderColor_ = border;
         focusedBorderColor_ = focused;
+        invalidateRender();
     }
     
     // Callbacks
@@ -124,6 +126,7 @@ private:
     void moveCursor(int direction, bool selecting = false);
     void setCursorFromMousePosition(int mouseX);
     void updateTextOffset();
+    bool advanceCursorBlink(Uint32 ticks);
     void validateAndUpdateText(const std::string& newText);
     
     // Rendering helpers
@@ -0,0 +1,91 @@
+#pragma once
+#include <vector>
+#include <memory>
+#include <functional>
+#include <SDL2/SDL.h>
+#include "UIComponent.h"
+#include "Layout.h"
+
+// Forward declaration
+class SDLManager;
+
+/**
+ * VirtualListContainer: scrolling list that only keeps components for the rows in view
+ *
+ * The list knows how many rows there are and how tall each one is. A factory creates row
+ * components and a binder fills one in for a given row. Only the visible rows plus an
+ * overscan margin are bound, from a pool that is recycled as the list scrolls, so a 50k-row
+ * roster costs about as much as one screen of rows. Bound rows are sized to their row
+ * height and stacked at their content offset by a VerticalLayout.
+ */
+class VirtualListContainer : public UIComponent {
+public:
+    using RowFactory = std::function<std::shared_ptr<UIComponent>()>;
+    using RowBinder = std::function<void(UIComponent& component, int row)>;
+    using RowHeightFunction = std::function<int(int row)>;
+
+    static constexpr int DEFAULT_ROW_HEIGHT = 24;
+    static constexpr int DEFAULT_OVERSCAN = 2;
+
+    VirtualListContainer(int x, int y, int width, int height, SDLManager& sdl);
+    ~VirtualListContainer() override;
+
+    // === Data Source ===
+    void setRowFactory(RowFactory factory, RowBinder binder); // Drops the current pool
+    void setRowCount(int count);           // Bound rows keep their data; see refreshRows()
+    int getRowCount() const { return rowCount_; }
+    void setRowHeight(int height);         // Uniform rows, no per-row calls
+    void setRowHeightFunction(RowHeightFunction rowHeight);
+    void setSpacing(int spacing);
+    int getSpacing() const { return spacing_; }
+    void setOverscan(int rows);            // Extra rows bound above and below the view
+    int getOverscan() const { return overscan_; }
+    void refreshRows();                    // Row data changed: re-read heights, rebind every row
+    void refreshRow(int row);              // Rebinds the row if it is bound
+
+    // === Scrolling Support ===
+    void setScrollOffset(int offset);
+    int getScrollOffset() const { return scrollOffset_; }
+    int getMaxScroll() const;
+    int getContentHeight() const;
+    void scrollToRow(int row);             // Smallest scroll that shows the whole row
+
+    // === Row Geometry ===
+    int getRowTop(int row) const;          // Offset of the row in the content
+    int getRowHeight(int row) const;
+    int getRowAt(int y) const;             // Row under a screen y, or -1
+
+    // === Bound Rows (valid after layout) ===
+    int getFirstBoundRow() const { return firstBound_; }
+    int getBoundRowCount() const { return static_cast<int>(bound_.size()); }
+    int getPoolSize() const { return static_cast<int>(bound_.size() + spare_.size()); }
+    std::shared_ptr<UIComponent> getRowComponent(int row) const; // nullptr unless bound
+
+    // === Core UIComponent Interface ===
+    void layout() override;
+    void render() override;
+    void handleEvent(const SDL_Event& event) override;
+    std::shared_ptr<UIComponent> hitTest(int x, int y) const;
+
+private:
+    RowFactory factory_;
+    RowBinder binder_;
+    RowHeightFunction rowHeightFunction_;
+    int rowCount_ = 0;
+    int rowHeight_ = DEFAULT_ROW_HEIGHT;
+    int spacing_ = 0;
+    int overscan_ = DEFAULT_OVERSCAN;
+    int scrollOffset_ = 0;
+    std::vector<int> rowOffsets_;          // Row tops plus the end, only with a height function
+
+    std::vector<std::shared_ptr<UIComponent>> bound_; // Rows firstBound_ onwards, in order
+    std::vector<std::shared_ptr<UIComponent>> spare_; // Pooled, not bound to any row
+    int firstBound_ = 0;
+    bool rebindAll_ = false;
+    std::unique_ptr<Layout> layout_;
+
+    void rebuildOffsets();
+    int rowAtContentY(int contentY) const; // Clamped to [0, rowCount_ - 1]
+    void bindRows(int first, int end);
+    void releaseRows();
+};
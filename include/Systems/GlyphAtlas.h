@@ -0,0 +1,77 @@
+#pragma once
+#include <SDL2/SDL.h>
+#include <SDL2/SDL_ttf.h>
+#include <string>
+#include <vector>
+#include <unordered_map>
+
+/**
+ * Glyph atlas text renderer owned by SDLManager
+ * Rasterizes every glyph once per font (a TTF_Font already encodes its point size)
+ * into packed atlas texture pages, then draws strings as batched SDL_RenderGeometry
+ * quads tinted through vertex colors. Replaces the per-call
+ * TTF_RenderUTF8 + SDL_CreateTextureFromSurface path used for UI text.
+ */
+class GlyphAtlas {
+public:
+    explicit GlyphAtlas(SDL_Renderer* renderer);
+    ~GlyphAtlas();
+
+    GlyphAtlas(const GlyphAtlas&) = delete;
+    GlyphAtlas& operator=(const GlyphAtlas&) = delete;
+
+    // Draw a UTF-8 string with its top-left corner at (x, y). Returns false if the
+    // atlas could not be used (caller should fall back to direct TTF rendering)
+    bool drawText(TTF_Font* font, const std::string& text, int x, int y, SDL_Color color);
+
+    // Batched drawing: queue many strings, then submit them with one geometry call per atlas page
+    bool queueText(TTF_Font* font, const std::string& text, int x, int y, SDL_Color color);
+    bool flush();
+
+    // Forget cached glyphs for a font (call before closing it) or for all fonts
+    void releaseFont(TTF_Font* font);
+    void clear();
+
+    // Statistics for debugging and profiling
+    int getPageCount() const;
+    int getGlyphCount() const;
+
+private:
+    struct Glyph {
+        SDL_Rect src = {0, 0, 0, 0};   // Location inside the atlas page
+        int advance = 0;               // Horizontal pen advance in pixels
+        int page = -1;                 // Atlas page index, -1 for glyphs without pixels (whitespace)
+    };
+
+    struct Page {
+        SDL_Texture* texture = nullptr;
+        int shelfX = 0;                // Next free x on the current shelf
+        int shelfY = 0;                // Top of the current shelf
+        int shelfHeight = 0;           // Height of the tallest glyph on the current shelf
+    };
+
+    struct FontAtlas {
+        std::unordered_map<Uint32, Glyph> glyphs;
+        std::vector<Page> pages;
+    };
+
+    struct Batch {
+        SDL_Texture* texture = nullptr;
+        std::vector<SDL_Vertex> vertices;
+        std::vector<int> indices;
+    };
+
+    SDL_Renderer* renderer_;
+    std::unordered_map<TTF_Font*, FontAtlas> fonts_;
+    std::vector<Batch> batches_;       // Reused between flushes to avoid per-frame allocation
+    size_t activeBatches_ = 0;
+    bool geometrySupported_ = true;
+
+    const Glyph* getGlyph(TTF_Font* font, FontAtlas& atlas, Uint32 codepoint);
+    bool rasterizeGlyph(TTF_Font* font, FontAtlas& atlas, Uint32 codepoint, Glyph& glyph);
+    bool allocateRegion(FontAtlas& atlas, int width, int height, int& page, SDL_Rect& region);
+    bool addPage(FontAtlas& atlas);
+    Batch& getBatch(SDL_Texture* texture);
+
+    static Uint32 decodeUTF8(const std::string& text, size_t& index);
+};
@@ -2,8 +2,11 @@
 #include <SDL2/SDL.h>
 #include <SDL2/SDL_ttf.h>
 #include <string>
+#include <memory>
 #include "Constants.h"
 
+class GlyphAtlas;
+
 class SDLManager {
 public:
     SDLManager();
@@ -15,11 +18,13 @@ public:
     SDL_Window* getWindow() const { return window; }
     SDL_Renderer* getRenderer() const { return renderer; }
     TTF_Font* getFont() const { return font; }
+    GlyphAtlas* getGlyphAtlas() const { return glyphAtlas.get(); }
 
 private:
     SDL_Window* window = nullptr;
     SDL_Renderer* renderer = nullptr;
     TTF_Font* font = nullptr;
+    std::unique_ptr<GlyphAtlas> glyphAtlas; // Cached glyph textures for text rendering
     bool initialized = false;
 
     void init();
@@ -0,0 +1,54 @@
+#pragma once
+#include <atomic>
+#include <condition_variable>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/**
+ * Persistent worker threads for data-parallel loops
+ * parallelFor() splits [0, count) across the workers and the calling thread and
+ * blocks until every item is done. Threads are created once and sleep between
+ * jobs, so per-frame or per-turn batches do not pay thread start-up costs.
+ *
+ * Tasks must not call parallelFor() on the same pool (the pool is not reentrant).
+ */
+class WorkerPool {
+public:
+    // threadCount = 0 uses hardware_concurrency() - 1 workers (the caller also works)
+    explicit WorkerPool(int threadCount = 0);
+    ~WorkerPool();
+
+    WorkerPool(const WorkerPool&) = delete;
+    WorkerPool& operator=(const WorkerPool&) = delete;
+
+    // Run task(itemIndex, workerIndex) for every item; workerIndex is in [0, getConcurrency())
+    void parallelFor(int count, const std::function<void(int, int)>& task);
+
+    // Worker threads plus the calling thread
+    int getConcurrency() const { return static_cast<int>(threads_.size()) + 1; }
+
+    // Process-wide pool sized to the machine
+    static WorkerPool& shared();
+
+private:
+    std::vector<std::thread> threads_;
+    std::mutex submitMutex_;             // Serializes parallelFor callers
+    std::mutex mutex_;
+    std::condition_variable wakeCondition_;
+    std::condition_variable doneCondition_;
+
+    // Current job, published under mutex_
+    const std::function<void(int, int)>* task_ = nullptr;
+    int count_ = 0;
+    std::atomic<int> nextItem_{0};
+    int busyWorkers_ = 0;
+    unsigned jobGeneration_ = 0;
+    bool stopping_ = false;
+    std::exception_ptr error_;
+
+    void workerLoop(int workerIndex);
+    void runItems(int workerIndex);
+};
@@ -12,6 +12,10 @@ constexpr Uint32 WINDOW_FLAGS = SDL_WINDOW_SHOWN;
 constexpr Uint32 RENDERER_FLAGS = SDL_RENDERER_ACCELERATED;
 constexpr const char* FONT_PATH = "./assets/font.ttf";
 constexpr int FONT_SIZE = 16;
+constexpr int GLYPH_ATLAS_PAGE_SIZE = 512; // Width/height of each glyph atlas texture page
+constexpr int HEX_LAYER_CHUNK_SIZE = 512;  // Width/height of each cached hex map layer chunk
+constexpr int HEX_LAYER_MAX_CHUNKS = 48;   // Chunk textures kept by a HexGridRenderer (LRU)
+constexpr Uint32 HEX_LAYER_ZOOM_SETTLE_MS = 150; // Zoom held this long before layer chunks are redrawn at it
 
 // UI Colors - Basic
 constexpr SDL_Color BACKGROUND_COLOR = {0, 0, 0, 255}; // Black
@@ -36,6 +36,9 @@ void FocusableButton::render() {
 }
 
 void FocusableButton::handleEvent(const SDL_Event& event) {
+    bool wasHovered = isHovered_;
+    bool wasPressed = isPressed_;
+    
     switch (event.type) {
         case SDL_MOUSEMOTION:
             updateHoverState(event.motion.x, event.motion.y);
@@ -65,6 +68,11 @@ void FocusableButton::handleEvent(const SDL_Event& event) {
             }
             break;
     }
+    
+    // Hover and pressed states change the background
+    if (isHovered_ != wasHovered || isPressed_ != wasPressed) {
+        invalidateRender();
+    }
 }
 
 void FocusableButton::onFocusGained() {
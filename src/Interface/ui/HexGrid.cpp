@@ -1,41 +1,471 @@
 #include "Interface/ui/HexGrid.h"
-#include <queue>
-#include <unordered_set>
+#include "Interface/ui/HexMapFile.h"
+#include "Systems/WorkerPool.h"
 #include <algorithm>
-#include <sstream>
+#include <cstdint>
+#include <iterator>
+#include <mutex>
 
-HexGrid::HexGrid(int width, int height) : width_(width), height_(height) {
+namespace {
+
+// Corners of the unit ring in the order rings are walked: ring r starts at r * RING_CORNERS[0],
+// and side s runs from r * RING_CORNERS[s] towards r * RING_CORNERS[s + 1]
+const int RING_CORNERS[6][3] = {
+    {-1, 0, 1}, {0, -1, 1}, {1, -1, 0}, {1, 0, -1}, {0, 1, -1}, {-1, 1, 0}
+};
+
+// Offset from the ring's center of position 0 <= position < 6 * ring along the ring
+HexCoordinate ringOffset(int ring, int position) {
+    int side = position / ring;
+    int step = position % ring;
+    const int* from = RING_CORNERS[side];
+    const int* to = RING_CORNERS[(side + 1) % 6];
+    return HexCoordinate(from[0] * (ring - step) + to[0] * step,
+                         from[1] * (ring - step) + to[1] * step,
+                         from[2] * (ring - step) + to[2] * step);
+}
+
+// Position along the ring of an offset at distance ring; inverse of ringOffset
+int ringPosition(const HexCoordinate& offset, int ring) {
+    const int components[3] = {offset.x, offset.y, offset.z};
+    for (int side = 0; side < 6; ++side) {
+        // Along a side, the component that is zero at its first corner counts the steps
+        const int* from = RING_CORNERS[side];
+        const int* to = RING_CORNERS[(side + 1) % 6];
+        for (int c = 0; c < 3; ++c) {
+            if (from[c] != 0) continue;
+            int step = components[c] * to[c];
+            if (step >= 0 && step < ring && ringOffset(ring, side * ring + step) == offset) {
+                return side * ring + step;
+            }
+            break;
+        }
+    }
+    return 0;
+}
+
+// The line from a center to ring position `position` at distance `distance` crosses ring
+// `ring` at position position * ring / distance. Returns the nearest ring position in first;
+// when the line runs exactly between two hexes returns true, and second is the other one.
+bool lineCrossing(int position, int distance, int ring, int& first, int& second) {
+    int64_t scaled = static_cast<int64_t>(position) * ring;
+    first = static_cast<int>(scaled / distance);
+    int64_t twiceRemainder = 2 * (scaled - static_cast<int64_t>(first) * distance);
+    second = (first + 1) % (6 * ring);
+    if (twiceRemainder > distance) {
+        first = second;
+    }
+    return twiceRemainder == distance;
+}
+
+// Ring angle as a fraction, a full turn being 6
+struct Angle {
+    int64_t num, den;
+    
+    bool operator<(const Angle& other) const { return num * other.den < other.num * den; }
+};
+
+// Open interval of ring angle that no line passes
+struct Shadow {
+    Angle lo, hi;
+};
+
+} // namespace
+
+/**
+ * Memoized visibility queries, keyed by tile indices and valid for one line-of-sight revision
+ */
+struct HexGrid::VisibilityCache {
+    static constexpr size_t MAX_ENTRIES = 1 << 16;
+    
+    std::mutex mutex;
+    uint64_t revision = 0;
+    std::unordered_map<uint64_t, bool> lineOfSight;            // (from, to) -> visible
+    std::unordered_map<uint64_t, std::vector<int>> fieldOfView; // (origin, range) -> tiles
+    
+    static uint64_t key(int a, int b) {
+        return (static_cast<uint64_t>(static_cast<uint32_t>(a)) << 32) | static_cast<uint32_t>(b);
+    }
+    
+    // Call with mutex held; drops everything computed for an older grid state
+    void validate(uint64_t currentRevision) {
+        if (revision != currentRevision) {
+            lineOfSight.clear();
+            fieldOfView.clear();
+            revision = currentRevision;
+        }
+    }
+};
+
+/**
+ * Flow fields by goal tile index, valid for one movement revision
+ */
+struct HexGrid::FlowFieldCache {
+    static constexpr size_t MAX_ENTRIES = 16;   // A 512x512 field is about 1.3 MB
+    
+    std::mutex mutex;
+    uint64_t revision = 0;
+    std::unordered_map<int, std::shared_ptr<const FlowField>> fields;
+    
+    // Call with mutex held
+    void validate(uint64_t currentRevision) {
+        if (revision != currentRevision) {
+            fields.clear();
+            revision = currentRevision;
+        }
+    }
+};
+
+/**
+ * Tile change records shared by all change cursors
+ * records[i] has sequence number base + i. A tile changed again before any cursor has read
+ * its newest record is merged into that record, so a busy tile costs one record per drain.
+ */
+struct HexGrid::ChangeJournal {
+    struct Cursor {
+        int id;
+        uint64_t position;      // Sequence number of the next record to read
+        bool needsRescan;
+    };
+    
+    std::vector<TileChangeRecord> records;
+    uint64_t base = 0;
+    std::vector<uint64_t> newest;       // Per tile: sequence + 1 of its latest record, 0 if none
+    std::vector<int> drainSlots;        // Per tile scratch for merging records, -1 when unused
+    std::vector<Cursor> cursors;
+    int nextCursorId = 1;
+    
+    uint64_t end() const { return base + records.size(); }
+    
+    Cursor* findCursor(int id) {
+        for (Cursor& cursor : cursors) {
+            if (cursor.id == id) return &cursor;
+        }
+        return nullptr;
+    }
+    
+    void reset(int tileCount) {
+        base = end();
+        records.clear();
+        newest.assign(tileCount, 0);
+        drainSlots.assign(tileCount, -1);
+        for (Cursor& cursor : cursors) {
+            cursor.position = base;
+            cursor.needsRescan = true;
+        }
+    }
+    
+    void record(int index, uint8_t changes) {
+        uint64_t furthest = base;
+        for (const Cursor& cursor : cursors) {
+            furthest = std::max(furthest, cursor.position);
+        }
+        
+        uint64_t latest = newest[index];
+        if (latest > furthest) {
+            records[latest - 1 - base].changes |= changes;
+            return;
+        }
+        records.push_back({index, changes});
+        newest[index] = end();
+        
+        // A subscriber that stopped draining must not grow the journal without bound; once its
+        // backlog costs more than a full scan it is sent back to rescanning
+        size_t backlogLimit = newest.size() * 2 + 512;
+        if (records.size() > backlogLimit * 2) {
+            for (Cursor& cursor : cursors) {
+                if (end() - cursor.position > backlogLimit) {
+                    cursor.position = end();
+                    cursor.needsRescan = true;
+                }
+            }
+            compact();
+        }
+    }
+    
+    // Drop records every cursor has read once they make up half the journal
+    void compact() {
+        uint64_t slowest = end();
+        for (const Cursor& cursor : cursors) {
+            slowest = std::min(slowest, cursor.position);
+        }
+        size_t consumed = static_cast<size_t>(slowest - base);
+        if (consumed > 0 && consumed * 2 >= records.size()) {
+            records.erase(records.begin(), records.begin() + consumed);
+            base = slowest;
+        }
+    }
+};
+
+HexGrid::HexGrid(int width, int height)
+    : width_(width), height_(height), flowFieldCache_(std::make_unique<FlowFieldCache>()) {
     initializeGrid();
 }
 
+HexGrid::~HexGrid() = default;
+
 void HexGrid::resize(int width, int height) {
     width_ = width;
     height_ = height;
-    tiles_.clear();
     initializeGrid();
 }
 
 void HexGrid::clear() {
-    for (auto& [coord, tile] : tiles_) {
-        tile->setTerrainType(TerrainType::PLAIN);
-        tile->setHeight(0);
-        tile->setOccupied(false);
-        tile->setHighlighted(false);
+    for (int index = 0; index < getTileCount(); ++index) {
+        HexTile& tile = tiles_[index];
+        tile.setTerrainType(TerrainType::PLAIN);
+        tile.setHeight(0);
+        tile.setOccupied(false);
+        tile.setHighlighted(false);
+        syncTile(index);
     }
+    highlightedTiles_.clear();
+    highlightTracked_.assign(tiles_.size(), false);
 }
 
 void HexGrid::initializeGrid() {
-    tiles_.clear();
+    createTiles();
+    syncAllTiles();
+}
+
+void HexGrid::createTiles() {
+    width_ = std::max(0, width_);
+    height_ = std::max(0, height_);
+    tiles_ = makeTiles(width_, height_);
+    buildNeighbors();
+}
+
+std::vector<HexTile> HexGrid::makeTiles(int width, int height) {
+    std::vector<HexTile> tiles;
+    tiles.reserve(static_cast<size_t>(width) * height);
     
     // Initialize grid using offset coordinates and convert to hex coordinates
-    for (int row = 0; row < height_; ++row) {
-        for (int col = 0; col < width_; ++col) {
-            HexCoordinate coord = HexCoordinate::fromOffset(col, row);
-            tiles_[coord] = std::make_unique<HexTile>(coord, TerrainType::PLAIN);
+    for (int row = 0; row < height; ++row) {
+        for (int col = 0; col < width; ++col) {
+            tiles.emplace_back(HexCoordinate::fromOffset(col, row), TerrainType::PLAIN);
+        }
+    }
+    return tiles;
+}
+
+void HexGrid::buildNeighbors() {
+    // Precompute neighbor indices so traversals never recompute coordinates
+    neighbors_.assign(tiles_.size() * 6, -1);
+    for (int index = 0; index < getTileCount(); ++index) {
+        for (int direction = 0; direction < 6; ++direction) {
+            neighbors_[index * 6 + direction] = getTileIndex(tiles_[index].getCoordinate().getNeighbor(direction));
         }
     }
 }
 
+void HexGrid::syncAllTiles() {
+    // Start from zeroed hot data so syncTile() can update the cost histograms uniformly
+    terrain_.assign(tiles_.size(), TerrainType::PLAIN);
+    heights_.assign(tiles_.size(), 0);
+    movementCosts_.assign(tiles_.size(), 0);
+    flags_.assign(tiles_.size(), 0);
+    costCounts_.fill(0);
+    passableCostCounts_.fill(0);
+    costCounts_[0] = getTileCount();
+    
+    // Statistics also start from the zeroed hot data: every tile a flagless plain
+    statisticsChunksX_ = (width_ + STATISTICS_CHUNK_SIZE - 1) / STATISTICS_CHUNK_SIZE;
+    int statisticsChunksY = (height_ + STATISTICS_CHUNK_SIZE - 1) / STATISTICS_CHUNK_SIZE;
+    statistics_ = StatisticsCounts();
+    statisticsChunks_.assign(static_cast<size_t>(statisticsChunksX_) * statisticsChunksY, StatisticsCounts());
+    for (int index = 0; index < getTileCount(); ++index) {
+        countTile(index, TerrainType::PLAIN, 0, 1);
+    }
+    
+    highlightedTiles_.clear();
+    highlightTracked_.assign(tiles_.size(), false);
+    notifyChanges_ = false;
+    for (int index = 0; index < getTileCount(); ++index) {
+        syncTile(index);
+    }
+    notifyChanges_ = true;
+    ++movementRevision_;
+    
+    notifyChange(-1, CHANGE_LAYOUT);
+}
+
+void HexGrid::syncTile(int index, uint8_t extraChanges) {
+    const HexTile& tile = tiles_[index];
+    const TileProperties& props = tile.getProperties();
+    
+    bool wasBlocking = flags_[index] & TILE_HIDDEN;
+    TerrainType oldTerrain = terrain_[index];
+    int8_t oldHeight = heights_[index];
+    uint8_t oldCost = movementCosts_[index];
+    uint8_t oldFlags = flags_[index];
+    
+    // Remove the old values from the cost histograms
+    costCounts_[movementCosts_[index]]--;
+    if (flags_[index] & TILE_PASSABLE) {
+        passableCostCounts_[movementCosts_[index]]--;
+    }
+    
+    terrain_[index] = tile.getTerrainType();
+    heights_[index] = HexMapFormat::packHeight(tile.getHeight());
+    movementCosts_[index] = static_cast<uint8_t>(std::max(0, std::min(255, props.movementCost)));
+    
+    uint8_t flags = computeTileFlags(tile);
+    flags_[index] = flags;
+    
+    if (terrain_[index] != oldTerrain || flags != oldFlags) {
+        countTile(index, oldTerrain, oldFlags, -1);
+        countTile(index, terrain_[index], flags, 1);
+    }
+    
+    costCounts_[movementCosts_[index]]++;
+    if (flags & TILE_PASSABLE) {
+        passableCostCounts_[movementCosts_[index]]++;
+    }
+    
+    if (tile.isHighlighted()) {
+        trackHighlight(index);
+    }
+    
+    if (wasBlocking != static_cast<bool>(flags & TILE_HIDDEN)) {
+        ++lineOfSightRevision_;
+    }
+    if (movementCosts_[index] != oldCost || heights_[index] != oldHeight ||
+        ((flags ^ oldFlags) & TILE_PASSABLE)) {
+        ++movementRevision_;
+    }
+    
+    if (notifyChanges_ && (!changeListeners_.empty() || changeJournal_)) {
+        uint8_t changes = extraChanges;
+        if (terrain_[index] != oldTerrain) changes |= CHANGE_TERRAIN;
+        if (heights_[index] != oldHeight) changes |= CHANGE_HEIGHT;
+        if (movementCosts_[index] != oldCost) changes |= CHANGE_MOVEMENT_COST;
+        if (flags != oldFlags) changes |= CHANGE_FLAGS;
+        if (changes) {
+            notifyChange(index, changes);
+        }
+    }
+}
+
+uint8_t HexGrid::computeTileFlags(const HexTile& tile) {
+    const TileProperties& props = tile.getProperties();
+    uint8_t flags = 0;
+    if (props.passable) flags |= TILE_PASSABLE;
+    if (props.hidden) flags |= TILE_HIDDEN;
+    if (tile.isOccupied()) flags |= TILE_OCCUPIED;
+    if (props.buildable) flags |= TILE_BUILDABLE;
+    if (props.supplyPoint) flags |= TILE_SUPPLY;
+    return flags;
+}
+
+int HexGrid::addChangeListener(TileChangeListener listener) {
+    int id = nextListenerId_++;
+    changeListeners_.emplace_back(id, std::move(listener));
+    return id;
+}
+
+void HexGrid::removeChangeListener(int listenerId) {
+    changeListeners_.erase(std::remove_if(changeListeners_.begin(), changeListeners_.end(),
+                                          [listenerId](const auto& entry) { return entry.first == listenerId; }),
+                           changeListeners_.end());
+}
+
+int HexGrid::openChangeCursor() {
+    if (!changeJournal_) {
+        changeJournal_ = std::make_unique<ChangeJournal>();
+        changeJournal_->reset(getTileCount());
+    }
+    int id = changeJournal_->nextCursorId++;
+    changeJournal_->cursors.push_back({id, changeJournal_->end(), false});
+    return id;
+}
+
+void HexGrid::closeChangeCursor(int cursorId) {
+    if (!changeJournal_) return;
+    
+    auto& cursors = changeJournal_->cursors;
+    cursors.erase(std::remove_if(cursors.begin(), cursors.end(),
+                                 [cursorId](const ChangeJournal::Cursor& cursor) { return cursor.id == cursorId; }),
+                  cursors.end());
+    if (cursors.empty()) {
+        changeJournal_.reset();   // Stop recording until someone subscribes again
+    } else {
+        changeJournal_->compact();
+    }
+}
+
+bool HexGrid::drainChanges(int cursorId, std::vector<TileChangeRecord>& changes) {
+    changes.clear();
+    ChangeJournal::Cursor* cursor = changeJournal_ ? changeJournal_->findCursor(cursorId) : nullptr;
+    if (!cursor) return false;
+    
+    ChangeJournal& journal = *changeJournal_;
+    if (cursor->needsRescan) {
+        cursor->needsRescan = false;
+        cursor->position = journal.end();
+        return false;
+    }
+    
+    // Records written after another cursor drained can repeat a tile; merge them here
+    for (uint64_t sequence = cursor->position; sequence < journal.end(); ++sequence) {
+        const TileChangeRecord& record = journal.records[sequence - journal.base];
+        int& slot = journal.drainSlots[record.index];
+        if (slot < 0) {
+            slot = static_cast<int>(changes.size());
+            changes.push_back(record);
+        } else {
+            changes[slot].changes |= record.changes;
+        }
+    }
+    for (const TileChangeRecord& record : changes) {
+        journal.drainSlots[record.index] = -1;
+    }
+    
+    cursor->position = journal.end();
+    journal.compact();
+    return true;
+}
+
+void HexGrid::notifyChange(int index, uint8_t changes) {
+    if (changeJournal_) {
+        if (index < 0) {
+            changeJournal_->reset(getTileCount());
+        } else {
+            changeJournal_->record(index, changes);
+        }
+    }
+    for (const auto& entry : changeListeners_) {
+        entry.second(index, changes);
+    }
+}
+
+int HexGrid::getMaxStepCost(bool passableOnly) const {
+    const std::array<int, 256>& counts = passableOnly ? passableCostCounts_ : costCounts_;
+    for (int cost = 255; cost > 0; --cost) {
+        if (counts[cost] > 0) {
+            return cost + 3; // Heights span 0-3
+        }
+    }
+    return 3;
+}
+
+int HexGrid::getTileIndex(const HexCoordinate& coord) const {
+    return tileIndexIn(coord, width_, height_);
+}
+
+int HexGrid::tileIndexIn(const HexCoordinate& coord, int width, int height) {
+    if (!coord.isValid()) {
+        return -1;
+    }
+    
+    // Cube to odd-r offset, inverse of HexCoordinate::fromOffset
+    int row = coord.z;
+    int col = coord.x + (row - (row & 1)) / 2;
+    if (col < 0 || col >= width || row < 0 || row >= height) {
+        return -1;
+    }
+    return row * width + col;
+}
+
 HexCoordinate HexGrid::offsetToHex(int col, int row) const {
     return HexCoordinate::fromOffset(col, row);
 }
@@ -48,38 +478,62 @@ void HexGrid::offsetToHex(int col, int row, int& x, int& y, int& z) const {
 }
 
 HexTile* HexGrid::getTile(const HexCoordinate& coord) {
-    auto it = tiles_.find(coord);
-    return (it != tiles_.end()) ? it->second.get() : nullptr;
+    int index = getTileIndex(coord);
+    return (index >= 0) ? &tiles_[index] : nullptr;
 }
 
 const HexTile* HexGrid::getTile(const HexCoordinate& coord) const {
-    auto it = tiles_.find(coord);
-    return (it != tiles_.end()) ? it->second.get() : nullptr;
+    int index = getTileIndex(coord);
+    return (index >= 0) ? &tiles_[index] : nullptr;
 }
 
 void HexGrid::setTile(const HexCoordinate& coord, const HexTile& tile) {
-    if (isValidCoordinate(coord)) {
-        tiles_[coord] = std::make_unique<HexTile>(tile);
+    int index = getTileIndex(coord);
+    if (index >= 0) {
+        tiles_[index] = tile;
+        tiles_[index].coordinate_ = coord;
+        syncTile(index);
     }
 }
 
 void HexGrid::setTerrain(const HexCoordinate& coord, TerrainType terrain) {
-    auto* tile = getTile(coord);
-    if (tile) {
-        tile->setTerrainType(terrain);
+    int index = getTileIndex(coord);
+    if (index >= 0) {
+        tiles_[index].setTerrainType(terrain);
+        syncTile(index);
     }
 }
 
-bool HexGrid::isValidCoordinate(const HexCoordinate& coord) const {
-    return tiles_.find(coord) != tiles_.end();
+void HexGrid::setHeight(const HexCoordinate& coord, int height) {
+    int index = getTileIndex(coord);
+    if (index >= 0) {
+        tiles_[index].setHeight(height);
+        syncTile(index);
+    }
+}
+
+void HexGrid::setOccupant(const HexCoordinate& coord, const std::string& unitId) {
+    int index = getTileIndex(coord);
+    if (index >= 0) {
+        bool changed = tiles_[index].getOccupantId() != unitId;
+        tiles_[index].setOccupant(unitId);
+        syncTile(index, changed ? CHANGE_OCCUPANT : 0);
+    }
+}
+
+void HexGrid::refreshTile(const HexCoordinate& coord) {
+    int index = getTileIndex(coord);
+    if (index >= 0) {
+        syncTile(index);
+    }
 }
 
 std::vector<HexCoordinate> HexGrid::getAllCoordinates() const {
     std::vector<HexCoordinate> coords;
     coords.reserve(tiles_.size());
     
-    for (const auto& [coord, tile] : tiles_) {
-        coords.push_back(coord);
+    for (const auto& tile : tiles_) {
+        coords.push_back(tile.getCoordinate());
     }
     
     return coords;
@@ -87,155 +541,193 @@ std::vector<HexCoordinate> HexGrid::getAllCoordinates() const {
 
 PathfindingResult HexGrid::findPath(const HexCoordinate& start, const HexCoordinate& goal,
                                    std::function<bool(const HexTile&)> isPassable) const {
-    if (!isValidCoordinate(start) || !isValidCoordinate(goal)) {
-        return PathfindingResult();
-    }
+    // One workspace per thread: legacy callers get the reusable search state for free
+    thread_local PathfindingWorkspace workspace;
     
-    if (!isPassable) {
-        isPassable = [this](const HexTile& tile) { return isDefaultPassable(tile); };
-    }
-    
-    std::priority_queue<PathNode, std::vector<PathNode>, std::greater<PathNode>> openSet;
-    std::unordered_set<HexCoordinate> closedSet;
-    std::unordered_map<HexCoordinate, PathNode> nodeMap;
-    
-    PathNode startNode;
-    startNode.coord = start;
-    startNode.gCost = 0;
-    startNode.hCost = calculateHeuristic(start, goal);
-    
-    openSet.push(startNode);
-    nodeMap[start] = startNode;
-    
-    while (!openSet.empty()) {
-        PathNode current = openSet.top();
-        openSet.pop();
-        
-        if (current.coord == goal) {
-            // Reconstruct path
-            std::vector<HexCoordinate> path;
-            HexCoordinate pathCoord = goal;
-            int totalCost = current.gCost;
-            
-            while (pathCoord != start) {
-                path.push_back(pathCoord);
-                pathCoord = nodeMap[pathCoord].parent;
-            }
-            path.push_back(start);
-            
-            std::reverse(path.begin(), path.end());
-            return PathfindingResult(path, totalCost);
-        }
-        
-        closedSet.insert(current.coord);
-        
-        // Check all neighbors
-        for (const HexCoordinate& neighbor : current.coord.getNeighbors()) {
-            if (!isValidCoordinate(neighbor) || closedSet.count(neighbor)) {
-                continue;
-            }
-            
-            const HexTile* neighborTile = getTile(neighbor);
-            if (!neighborTile || !isPassable(*neighborTile)) {
-                continue;
-            }
-            
-            const HexTile* currentTile = getTile(current.coord);
-            int tentativeGCost = current.gCost + 
-                HexTileUtils::calculateMovementCost(*currentTile, *neighborTile);
-            
-            auto neighborIt = nodeMap.find(neighbor);
-            if (neighborIt == nodeMap.end() || tentativeGCost < neighborIt->second.gCost) {
-                PathNode neighborNode;
-                neighborNode.coord = neighbor;
-                neighborNode.gCost = tentativeGCost;
-                neighborNode.hCost = calculateHeuristic(neighbor, goal);
-                neighborNode.parent = current.coord;
-                
-                nodeMap[neighbor] = neighborNode;
-                openSet.push(neighborNode);
-            }
-        }
+    PathfindingResult result;
+    if (isPassable) {
+        findPath(start, goal, workspace, result, isPassable);
+    } else {
+        findPath(start, goal, workspace, result);
     }
-    
-    return PathfindingResult(); // No path found
+    return result;
 }
 
 MovementRange HexGrid::calculateMovementRange(const HexCoordinate& start, int movementPoints,
                                             std::function<bool(const HexTile&)> isPassable) const {
-    MovementRange range(movementPoints);
+    thread_local PathfindingWorkspace workspace;
+    thread_local MovementField field;
     
-    if (!isValidCoordinate(start)) {
-        return range;
+    if (isPassable) {
+        calculateMovementRange(start, movementPoints, workspace, field, isPassable);
+    } else {
+        calculateMovementRange(start, movementPoints, workspace, field);
     }
     
-    if (!isPassable) {
-        isPassable = [this](const HexTile& tile) { return isDefaultPassable(tile); };
+    MovementRange range(movementPoints);
+    range.reachableTiles.reserve(field.tiles.size());
+    for (int i = 0; i < field.size(); ++i) {
+        range.reachableTiles[tiles_[field.tiles[i]].getCoordinate()] = field.costs[i];
     }
+    return range;
+}
+
+void HexGrid::calculateMovementRanges(const std::vector<MovementRequest>& requests,
+                                      std::vector<MovementField>& results,
+                                      WorkerPool* pool) const {
+    results.resize(requests.size());
     
-    std::priority_queue<std::pair<int, HexCoordinate>, 
-                       std::vector<std::pair<int, HexCoordinate>>,
-                       std::greater<std::pair<int, HexCoordinate>>> queue;
+    // The grid is shared read-only; every worker thread searches with its own workspace
+    WorkerPool& workers = pool ? *pool : WorkerPool::shared();
+    workers.parallelFor(static_cast<int>(requests.size()), [&](int item, int) {
+        thread_local PathfindingWorkspace workspace;
+        const MovementRequest& request = requests[item];
+        if (request.isPassable) {
+            calculateMovementRange(request.start, request.movementPoints, workspace, results[item],
+                                   request.isPassable);
+        } else {
+            calculateMovementRange(request.start, request.movementPoints, workspace, results[item]);
+        }
+    });
+}
+
+std::vector<MovementField> HexGrid::calculateMovementRanges(const std::vector<MovementRequest>& requests,
+                                                            WorkerPool* pool) const {
+    std::vector<MovementField> results;
+    calculateMovementRanges(requests, results, pool);
+    return results;
+}
+
+void HexGrid::computeFlowField(const std::vector<HexCoordinate>& goals, PathfindingWorkspace& workspace,
+                               FlowField& field) const {
+    field.goals.clear();
+    field.costs.assign(tiles_.size(), FlowField::UNREACHABLE);
+    field.directions.assign(tiles_.size(), FlowField::NO_DIRECTION);
+    field.movementRevision = movementRevision_;
     
-    range.reachableTiles[start] = 0;
-    queue.push({0, start});
+    // Edges run backwards and always end on a passable tile, so passable step costs bound them
+    int maxStepCost = getMaxStepCost(true);
+    bool useBuckets = searchQueue_ == SearchQueue::BucketQueue ||
+                      (searchQueue_ == SearchQueue::Auto && maxStepCost <= MAX_BUCKET_QUEUE_COST);
+    if (useBuckets) {
+        workspace.beginBuckets(getTileCount(), maxStepCost);
+    } else {
+        workspace.begin(getTileCount());
+    }
     
-    while (!queue.empty()) {
-        auto [currentCost, currentCoord] = queue.top();
-        queue.pop();
-        
-        if (currentCost > movementPoints) {
+    for (const HexCoordinate& goal : goals) {
+        int index = getTileIndex(goal);
+        if (index < 0 || !(flags_[index] & TILE_PASSABLE)) {
             continue;
         }
-        
-        if (currentCost > range.reachableTiles[currentCoord]) {
-            continue; // Already found a better path to this tile
+        bool added = useBuckets ? workspace.relaxBucket(index, 0, -1) : workspace.relax(index, 0, 0, -1);
+        if (added) {
+            field.goals.push_back(index);
+        }
+    }
+    
+    while (true) {
+        int current;
+        if (useBuckets) {
+            current = workspace.popMinBucket();
+            if (current < 0) break;
+        } else {
+            if (!workspace.hasOpenNodes()) break;
+            current = workspace.popMin();
         }
         
-        const HexTile* currentTile = getTile(currentCoord);
-        if (!currentTile) continue;
+        int currentCost = workspace.getCost(current);
+        field.costs[current] = currentCost;
+        const int* neighbors = &neighbors_[current * 6];
         
-        for (const HexCoordinate& neighbor : currentCoord.getNeighbors()) {
-            if (!isValidCoordinate(neighbor)) {
-                continue;
+        int next = workspace.getParent(current);
+        if (next >= 0) {
+            for (int direction = 0; direction < 6; ++direction) {
+                if (neighbors[direction] == next) {
+                    field.directions[current] = static_cast<int8_t>(direction);
+                    break;
+                }
             }
-            
-            const HexTile* neighborTile = getTile(neighbor);
-            if (!neighborTile || !isPassable(*neighborTile)) {
+        }
+        
+        // Impassable tiles get a way out but no routes through them
+        if (!(flags_[current] & TILE_PASSABLE)) {
+            continue;
+        }
+        
+        for (int direction = 0; direction < 6; ++direction) {
+            int neighbor = neighbors[direction];
+            if (neighbor < 0 || workspace.isClosed(neighbor)) {
                 continue;
             }
             
-            int newCost = currentCost + HexTileUtils::calculateMovementCost(*currentTile, *neighborTile);
-            
-            if (newCost <= movementPoints) {
-                auto it = range.reachableTiles.find(neighbor);
-                if (it == range.reachableTiles.end() || newCost < it->second) {
-                    range.reachableTiles[neighbor] = newCost;
-                    queue.push({newCost, neighbor});
-                }
+            int newCost = currentCost + getStepCost(neighbor, current);
+            if (useBuckets) {
+                workspace.relaxBucket(neighbor, newCost, current);
+            } else {
+                workspace.relax(neighbor, newCost, newCost, current);
             }
         }
     }
+}
+
+FlowField HexGrid::computeFlowField(const std::vector<HexCoordinate>& goals) const {
+    PathfindingWorkspace workspace;
+    FlowField field;
+    computeFlowField(goals, workspace, field);
+    return field;
+}
+
+std::shared_ptr<const FlowField> HexGrid::getFlowField(const HexCoordinate& goal) const {
+    int goalIndex = getTileIndex(goal);
+    if (goalIndex < 0) {
+        return nullptr;
+    }
     
-    return range;
+    {
+        std::lock_guard<std::mutex> lock(flowFieldCache_->mutex);
+        flowFieldCache_->validate(movementRevision_);
+        auto it = flowFieldCache_->fields.find(goalIndex);
+        if (it != flowFieldCache_->fields.end()) {
+            return it->second;
+        }
+    }
+    
+    // Computed outside the lock; concurrent callers for the same goal may both compute it
+    auto field = std::make_shared<FlowField>(computeFlowField({goal}));
+    
+    std::lock_guard<std::mutex> lock(flowFieldCache_->mutex);
+    if (flowFieldCache_->fields.size() >= FlowFieldCache::MAX_ENTRIES) {
+        flowFieldCache_->fields.clear();
+    }
+    flowFieldCache_->fields[goalIndex] = field;
+    return field;
 }
 
 std::vector<HexCoordinate> HexGrid::calculateAttackRange(const HexCoordinate& attacker, int range,
                                                         bool requireLineOfSight) const {
     std::vector<HexCoordinate> attackRange;
     
-    if (!isValidCoordinate(attacker)) {
+    int attackerIndex = getTileIndex(attacker);
+    if (attackerIndex < 0) {
         return attackRange;
     }
     
-    auto coordinatesInRange = attacker.getCoordinatesInRange(range);
-    
-    for (const HexCoordinate& coord : coordinatesInRange) {
-        if (!isValidCoordinate(coord) || coord == attacker) {
-            continue;
-        }
+    if (requireLineOfSight) {
+        thread_local std::vector<int> visible;
+        computeFieldOfView(attacker, range, visible);
         
-        if (!requireLineOfSight || hasLineOfSight(attacker, coord)) {
+        attackRange.reserve(visible.size());
+        for (int index : visible) {
+            if (index != attackerIndex) {
+                attackRange.push_back(getCoordinateAt(index));
+            }
+        }
+        return attackRange;
+    }
+    
+    for (const HexCoordinate& coord : attacker.getCoordinatesInRange(range)) {
+        if (coord != attacker && isValidCoordinate(coord)) {
             attackRange.push_back(coord);
         }
     }
@@ -244,44 +736,249 @@ std::vector<HexCoordinate> HexGrid::calculateAttackRange(const HexCoordinate& at
 }
 
 bool HexGrid::hasLineOfSight(const HexCoordinate& from, const HexCoordinate& to) const {
-    auto path = getLineOfSightPath(from, to);
+    int distance = from.distanceTo(to);
     
-    // Check if any tile in the path (except start and end) blocks line of sight
-    for (size_t i = 1; i < path.size() - 1; ++i) {
-        const HexTile* tile = getTile(path[i]);
-        if (tile && tile->blocksLineOfSight()) {
-            return false;
+    uint64_t cacheKey = 0;
+    bool cacheable = false;
+    if (visibilityCache_) {
+        int fromIndex = getTileIndex(from);
+        int toIndex = getTileIndex(to);
+        if (fromIndex >= 0 && toIndex >= 0) {
+            cacheable = true;
+            cacheKey = VisibilityCache::key(fromIndex, toIndex);
+            std::lock_guard<std::mutex> lock(visibilityCache_->mutex);
+            visibilityCache_->validate(lineOfSightRevision_);
+            auto it = visibilityCache_->lineOfSight.find(cacheKey);
+            if (it != visibilityCache_->lineOfSight.end()) {
+                return it->second;
+            }
         }
     }
     
-    return true;
+    bool visible = !isLineBlocked(from, to, distance);
+    
+    if (cacheable) {
+        std::lock_guard<std::mutex> lock(visibilityCache_->mutex);
+        if (visibilityCache_->lineOfSight.size() >= VisibilityCache::MAX_ENTRIES) {
+            visibilityCache_->lineOfSight.clear();
+        }
+        visibilityCache_->lineOfSight[cacheKey] = visible;
+    }
+    
+    return visible;
 }
 
 std::vector<HexCoordinate> HexGrid::getLineOfSightPath(const HexCoordinate& from, const HexCoordinate& to) const {
     std::vector<HexCoordinate> path;
     
     int distance = from.distanceTo(to);
+    path.push_back(from);
     if (distance == 0) {
-        path.push_back(from);
         return path;
     }
     
-    // Use linear interpolation to get path
-    for (int i = 0; i <= distance; ++i) {
-        float t = (distance == 0) ? 0.0f : static_cast<float>(i) / static_cast<float>(distance);
-        HexCoordinate coord = from.lerp(to, t);
-        path.push_back(coord);
+    // Same line as hasLineOfSight; where it runs between two hexes the path takes the first
+    int position = ringPosition(to - from, distance);
+    for (int ring = 1; ring < distance; ++ring) {
+        int first, second;
+        lineCrossing(position, distance, ring, first, second);
+        path.push_back(from + ringOffset(ring, first));
     }
+    path.push_back(to);
     
     return path;
 }
 
+void HexGrid::computeFieldOfView(const HexCoordinate& origin, int range, std::vector<int>& visible) const {
+    visible.clear();
+    
+    int originIndex = getTileIndex(origin);
+    if (originIndex < 0 || range < 0) {
+        return;
+    }
+    
+    if (!visibilityCache_) {
+        sweepFieldOfView(originIndex, range, visible);
+        return;
+    }
+    
+    uint64_t cacheKey = VisibilityCache::key(originIndex, range);
+    {
+        std::lock_guard<std::mutex> lock(visibilityCache_->mutex);
+        visibilityCache_->validate(lineOfSightRevision_);
+        auto it = visibilityCache_->fieldOfView.find(cacheKey);
+        if (it != visibilityCache_->fieldOfView.end()) {
+            visible = it->second;
+            return;
+        }
+    }
+    
+    sweepFieldOfView(originIndex, range, visible);
+    
+    std::lock_guard<std::mutex> lock(visibilityCache_->mutex);
+    if (visibilityCache_->fieldOfView.size() >= VisibilityCache::MAX_ENTRIES / 16) {
+        visibilityCache_->fieldOfView.clear();
+    }
+    visibilityCache_->fieldOfView[cacheKey] = visible;
+}
+
+std::vector<HexCoordinate> HexGrid::computeFieldOfView(const HexCoordinate& origin, int range) const {
+    thread_local std::vector<int> visible;
+    computeFieldOfView(origin, range, visible);
+    
+    std::vector<HexCoordinate> coords;
+    coords.reserve(visible.size());
+    for (int index : visible) {
+        coords.push_back(getCoordinateAt(index));
+    }
+    return coords;
+}
+
+bool HexGrid::isLineBlocked(const HexCoordinate& from, const HexCoordinate& to, int distance) const {
+    auto blocksAt = [&](int ring, int position) {
+        int index = getTileIndex(from + ringOffset(ring, position));
+        return index >= 0 && blocksLineOfSightAt(index);
+    };
+    
+    // The end points never block; a line running between two hexes needs both to block
+    int position = distance > 1 ? ringPosition(to - from, distance) : 0;
+    for (int ring = 1; ring < distance; ++ring) {
+        int first, second;
+        bool between = lineCrossing(position, distance, ring, first, second);
+        if (blocksAt(ring, first) && (!between || blocksAt(ring, second))) {
+            return true;
+        }
+    }
+    return false;
+}
+
+void HexGrid::sweepFieldOfView(int originIndex, int range, std::vector<int>& visible) const {
+    thread_local std::vector<Shadow> shadows;
+    thread_local std::vector<Shadow> added;
+    thread_local std::vector<Shadow> merged;
+    thread_local std::vector<uint8_t> ringBlocks;
+    shadows.clear();
+    
+    const HexCoordinate& origin = getCoordinateAt(originIndex);
+    visible.push_back(originIndex);
+    
+    // Ring position p of ring k sits at angle p / k, and a line to it crosses ring i at
+    // position p * i / k (see isLineBlocked). Shadows are kept sorted and disjoint, so each
+    // ring is checked against them in one pass.
+    for (int ring = 1; ring <= range; ++ring) {
+        const int count = 6 * ring;
+        ringBlocks.assign(count, 0);
+        
+        size_t cursor = 0;
+        HexCoordinate hex = origin + ringOffset(ring, 0);
+        for (int side = 0; side < 6; ++side) {
+            for (int step = 0; step < ring; ++step) {
+                int position = side * ring + step;
+                Angle angle = {position, ring};
+                while (cursor < shadows.size() && !(angle < shadows[cursor].hi)) {
+                    ++cursor;
+                }
+                bool shadowed = cursor < shadows.size() && shadows[cursor].lo < angle;
+                
+                int index = getTileIndex(hex);
+                if (index >= 0) {
+                    if (!shadowed) {
+                        visible.push_back(index);
+                    }
+                    ringBlocks[position] = blocksLineOfSightAt(index);
+                }
+                hex = hex.getNeighbor(side);
+            }
+        }
+        
+        int start = 0;
+        while (start < count && ringBlocks[start]) ++start;
+        if (start == count) {
+            break;      // A closed ring of blockers hides everything beyond it
+        }
+        
+        // A run of blockers at positions first..last stops the lines crossing this ring strictly
+        // between first - 1/2 and last + 1/2; a line through either end still passes the clear
+        // hex beside it. Runs are collected starting from a clear position so none is split.
+        added.clear();
+        for (int position = start; position < start + count; ) {
+            if (!ringBlocks[position % count]) {
+                ++position;
+                continue;
+            }
+            int first = position;
+            while (position < start + count && ringBlocks[position % count]) ++position;
+            int last = position - 1;
+            if (first >= count) {
+                first -= count;
+                last -= count;
+            }
+            
+            // Also add the copy a turn away when the run covers angle 0
+            const int64_t den = 2 * ring;
+            const int64_t turn = 2 * count;
+            Shadow shadow = {{2 * first - 1, den}, {2 * last + 1, den}};
+            added.push_back(shadow);
+            if (shadow.lo.num < 0) {
+                added.push_back({{shadow.lo.num + turn, den}, {shadow.hi.num + turn, den}});
+            } else if (shadow.hi.num > turn) {
+                added.push_back({{shadow.lo.num - turn, den}, {shadow.hi.num - turn, den}});
+            }
+        }
+        if (added.empty()) {
+            continue;
+        }
+        
+        auto startsBefore = [](const Shadow& a, const Shadow& b) { return a.lo < b.lo; };
+        std::sort(added.begin(), added.end(), startsBefore);
+        merged.clear();
+        std::merge(shadows.begin(), shadows.end(), added.begin(), added.end(),
+                   std::back_inserter(merged), startsBefore);
+        
+        // Overlapping shadows join; ones that only touch stay apart, since the angle where
+        // they meet is open
+        shadows.clear();
+        for (const Shadow& shadow : merged) {
+            if (!shadows.empty() && shadow.lo < shadows.back().hi) {
+                shadows.back().hi = std::max(shadows.back().hi, shadow.hi);
+            } else {
+                shadows.push_back(shadow);
+            }
+        }
+        
+        if (shadows.front().lo < Angle{0, 1} && !(shadows.front().hi < Angle{6, 1})) {
+            break;      // Every angle is shadowed
+        }
+    }
+}
+
+void HexGrid::setVisibilityCacheEnabled(bool enabled) {
+    if (enabled && !visibilityCache_) {
+        visibilityCache_ = std::make_unique<VisibilityCache>();
+        visibilityCache_->revision = lineOfSightRevision_;
+    } else if (!enabled) {
+        visibilityCache_.reset();
+    }
+}
+
 std::vector<HexCoordinate> HexGrid::getNeighbors(const HexCoordinate& coord) const {
     std::vector<HexCoordinate> neighbors;
     
-    for (const HexCoordinate& neighbor : coord.getNeighbors()) {
-        if (isValidCoordinate(neighbor)) {
-            neighbors.push_back(neighbor);
+    int index = getTileIndex(coord);
+    if (index < 0) {
+        // Off-grid coordinates can still border the grid
+        for (const HexCoordinate& neighbor : coord.getNeighbors()) {
+            if (isValidCoordinate(neighbor)) {
+                neighbors.push_back(neighbor);
+            }
+        }
+        return neighbors;
+    }
+    
+    for (int direction = 0; direction < 6; ++direction) {
+        int neighbor = getNeighborIndex(index, direction);
+        if (neighbor >= 0) {
+            neighbors.push_back(tiles_[neighbor].getCoordinate());
         }
     }
     
@@ -337,17 +1034,33 @@ bool HexGrid::canPlaceFormation(const std::vector<HexCoordinate>& formation) con
 
 void HexGrid::highlightFormation(const std::vector<HexCoordinate>& formation, const SDL_Color& color) {
     for (const HexCoordinate& coord : formation) {
-        if (auto* tile = getTile(coord)) {
-            tile->setHighlighted(true);
-            tile->setHighlightColor(color);
+        int index = getTileIndex(coord);
+        if (index >= 0) {
+            setHighlight(index, color);
         }
     }
 }
 
+void HexGrid::setHighlight(int index, const SDL_Color& color) {
+    HexTile& tile = tiles_[index];
+    tile.setHighlighted(true);
+    tile.setHighlightColor(color);
+    trackHighlight(index);
+}
+
+void HexGrid::trackHighlight(int index) {
+    if (!highlightTracked_[index]) {
+        highlightTracked_[index] = true;
+        highlightedTiles_.push_back(index);
+    }
+}
+
 void HexGrid::clearHighlights() {
-    for (auto& [coord, tile] : tiles_) {
-        tile->setHighlighted(false);
+    for (int index : highlightedTiles_) {
+        tiles_[index].setHighlighted(false);
+        highlightTracked_[index] = false;
     }
+    highlightedTiles_.clear();
 }
 
 bool HexGrid::canBuildBridge(const HexCoordinate& coord) const {
@@ -356,9 +1069,10 @@ bool HexGrid::canBuildBridge(const HexCoordinate& coord) const {
 }
 
 void HexGrid::buildBridge(const HexCoordinate& coord) {
-    auto* tile = getTile(coord);
-    if (tile && canBuildBridge(coord)) {
-        tile->buildBridge();
+    int index = getTileIndex(coord);
+    if (index >= 0 && canBuildBridge(coord)) {
+        tiles_[index].buildBridge();
+        syncTile(index);
     }
 }
 
@@ -368,23 +1082,25 @@ bool HexGrid::canBuildFortification(const HexCoordinate& coord) const {
 }
 
 void HexGrid::buildFortification(const HexCoordinate& coord) {
-    auto* tile = getTile(coord);
-    if (tile && canBuildFortification(coord)) {
-        tile->buildFortification();
+    int index = getTileIndex(coord);
+    if (index >= 0 && canBuildFortification(coord)) {
+        tiles_[index].buildFortification();
+        syncTile(index);
     }
 }
 
 void HexGrid::destroyStructure(const HexCoordinate& coord) {
-    auto* tile = getTile(coord);
-    if (tile) {
-        tile->destroy();
+    int index = getTileIndex(coord);
+    if (index >= 0) {
+        tiles_[index].destroy();
+        syncTile(index);
     }
 }
 
 void HexGrid::processEvents(const std::string& triggerCondition, 
                            const std::unordered_map<std::string, std::string>& context) {
-    for (auto& [coord, tile] : tiles_) {
-        auto events = tile->checkTriggeredEvents(triggerCondition, context);
+    for (auto& tile : tiles_) {
+        auto events = tile.checkTriggeredEvents(triggerCondition, context);
         // Process triggered events (implementation depends on game engine)
         for (const auto& event : events) {
             // Handle event actions based on event.action
@@ -393,35 +1109,58 @@ void HexGrid::processEvents(const std::string& triggerCondition,
     }
 }
 
-int HexGrid::calculateHeuristic(const HexCoordinate& from, const HexCoordinate& to) const {
-    return from.distanceTo(to);
+HexGrid::GridStatistics HexGrid::makeStatistics(const StatisticsCounts& counts, int totalTiles) {
+    GridStatistics stats;
+    stats.totalTiles = totalTiles;
+    for (int type = 0; type < TERRAIN_TYPE_COUNT; ++type) {
+        if (counts.terrain[type] > 0) {
+            stats.terrainCounts[static_cast<TerrainType>(type)] = counts.terrain[type];
+        }
+    }
+    stats.impassableTiles = counts.impassable;
+    stats.buildableTiles = counts.buildable;
+    stats.supplyPoints = counts.supply;
+    return stats;
 }
 
-bool HexGrid::isDefaultPassable(const HexTile& tile) const {
-    return tile.isPassable() && !tile.isOccupied();
+HexGrid::GridStatistics HexGrid::getStatistics() const {
+    return makeStatistics(statistics_, getTileCount());
 }
 
-HexGrid::GridStatistics HexGrid::getStatistics() const {
-    GridStatistics stats;
-    stats.totalTiles = tiles_.size();
+HexGrid::GridStatistics HexGrid::getStatistics(int minCol, int minRow, int maxCol, int maxRow) const {
+    minCol = std::max(minCol, 0);
+    minRow = std::max(minRow, 0);
+    maxCol = std::min(maxCol, width_ - 1);
+    maxRow = std::min(maxRow, height_ - 1);
+    if (minCol > maxCol || minRow > maxRow) {
+        return GridStatistics();
+    }
     
-    for (const auto& [coord, tile] : tiles_) {
-        stats.terrainCounts[tile->getTerrainType()]++;
+    StatisticsCounts counts;
+    for (int chunkY = minRow / STATISTICS_CHUNK_SIZE; chunkY <= maxRow / STATISTICS_CHUNK_SIZE; ++chunkY) {
+        int chunkMinRow = chunkY * STATISTICS_CHUNK_SIZE;
+        int chunkMaxRow = std::min(chunkMinRow + STATISTICS_CHUNK_SIZE, height_) - 1;
         
-        if (!tile->isPassable()) {
-            stats.impassableTiles++;
-        }
-        
-        if (tile->canBuild()) {
-            stats.buildableTiles++;
-        }
-        
-        if (tile->isSupplyPoint()) {
-            stats.supplyPoints++;
+        for (int chunkX = minCol / STATISTICS_CHUNK_SIZE; chunkX <= maxCol / STATISTICS_CHUNK_SIZE; ++chunkX) {
+            int chunkMinCol = chunkX * STATISTICS_CHUNK_SIZE;
+            int chunkMaxCol = std::min(chunkMinCol + STATISTICS_CHUNK_SIZE, width_) - 1;
+            
+            if (chunkMinCol >= minCol && chunkMaxCol <= maxCol && chunkMinRow >= minRow && chunkMaxRow <= maxRow) {
+                counts.add(statisticsChunks_[chunkY * statisticsChunksX_ + chunkX]);
+                continue;
+            }
+            
+            // Partially covered chunk: count its tiles inside the rectangle
+            for (int row = std::max(chunkMinRow, minRow); row <= std::min(chunkMaxRow, maxRow); ++row) {
+                for (int col = std::max(chunkMinCol, minCol); col <= std::min(chunkMaxCol, maxCol); ++col) {
+                    int index = row * width_ + col;
+                    counts.add(terrain_[index], flags_[index], 1);
+                }
+            }
         }
     }
     
-    return stats;
+    return makeStatistics(counts, (maxCol - minCol + 1) * (maxRow - minRow + 1));
 }
 
 void HexGrid::setTerrainArea(const std::vector<HexCoordinate>& coords, TerrainType terrain) {
@@ -432,10 +1171,7 @@ void HexGrid::setTerrainArea(const std::vector<HexCoordinate>& coords, TerrainTy
 
 void HexGrid::setHeightArea(const std::vector<HexCoordinate>& coords, int height) {
     for (const HexCoordinate& coord : coords) {
-        auto* tile = getTile(coord);
-        if (tile) {
-            tile->setHeight(height);
-        }
+        setHeight(coord, height);
     }
 }
 
@@ -480,8 +1216,9 @@ void HexGrid::setupTeutobergBattlefield() {
     clear();
     
     // Fill most of map with forest
-    for (auto& [coord, tile] : tiles_) {
-        tile->setTerrainType(TerrainType::FOREST);
+    for (int index = 0; index < getTileCount(); ++index) {
+        tiles_[index].setTerrainType(TerrainType::FOREST);
+        syncTile(index);
     }
     
     // Create Roman road through center
@@ -498,32 +1235,48 @@ void HexGrid::setupTeutobergBattlefield() {
     }
 }
 
-std::string HexGrid::toJSON() const {
-    std::stringstream ss;
-    ss << "{";
-    ss << "\"width\":" << width_ << ",";
-    ss << "\"height\":" << height_ << ",";
-    ss << "\"tiles\":[";
-    
-    bool first = true;
-    for (const auto& [coord, tile] : tiles_) {
-        if (!first) ss << ",";
-        ss << tile->toJSON();
-        first = false;
+bool HexGrid::saveBinary(const std::string& filename, std::string* error) const {
+    // Side table: tiles the packed arrays plus terrain defaults cannot reproduce
+    std::vector<HexMapTileDetails> details;
+    for (int index = 0; index < getTileCount(); ++index) {
+        if (HexMapFormat::needsDetails(tiles_[index])) {
+            details.push_back(HexMapFormat::makeDetails(index, tiles_[index]));
+        }
     }
     
-    ss << "]}";
-    return ss.str();
+    return HexMapWriter::write(filename, width_, height_, terrain_.data(), heights_.data(), flags_.data(),
+                               movementCosts_.data(), details, error);
 }
 
-void HexGrid::fromJSON(const std::string& json) {
-    // Simple JSON parsing - in a real implementation, you would use nlohmann/json
-    // For now, we'll implement a basic parser
+bool HexGrid::loadBinary(const std::string& filename, std::string* error) {
+    HexMapView map;
+    if (!map.open(filename)) {
+        if (error) *error = map.getError();
+        return false;
+    }
+    return loadBinary(map, error);
+}
+
+bool HexGrid::loadBinary(const HexMapView& map, std::string* error) {
+    std::vector<HexMapTileDetails> details;
+    if (!map.isOpen() || !map.readTileDetails(details)) {
+        if (error) *error = map.isOpen() ? "Hex map tile details are malformed" : "Hex map is not open";
+        return false;
+    }
     
-    // Clear existing grid
-    clear();
+    width_ = map.getWidth();
+    height_ = map.getHeight();
+    createTiles();
     
-    // For this basic implementation, let's just create a default grid
-    // In a full implementation, you would parse the JSON properly
-    initializeGrid();
+    for (int index = 0; index < getTileCount(); ++index) {
+        HexMapFormat::PackedTile packed = {map.getTerrain()[index], map.getHeights()[index],
+                                           map.getFlags()[index], map.getMovementCosts()[index]};
+        HexMapFormat::unpackTile(packed, tiles_[index]);
+    }
+    for (const HexMapTileDetails& entry : details) {
+        HexMapFormat::applyDetails(entry, tiles_[entry.index]);
+    }
+    
+    syncAllTiles();
+    return true;
 }
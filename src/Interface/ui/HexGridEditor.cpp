@@ -2,6 +2,7 @@
 #include "Systems/SDLManager.h"
 #include <algorithm>
 #include <fstream>
+#include <iostream>
 #include <sstream>
 
 const std::vector<TerrainType> HexGridEditor::COMMON_TERRAINS = {
@@ -164,29 +165,67 @@ void HexGridEditor::newMap(int width, int height) {
 }
 
 void HexGridEditor::saveMap(const std::string& filename) const {
-    std::ofstream file(filename);
-    if (file.is_open()) {
-        file << exportToJSON();
-        file.close();
-        
-        if (onMapSaved) {
-            onMapSaved(filename);
+    if (!grid_) return;
+    
+    if (isBinaryMapFile(filename)) {
+        std::string error;
+        if (!grid_->saveBinary(filename, &error)) {
+            std::cerr << "Failed to save map: " << error << std::endl;
+            return;
+        }
+    } else {
+        std::ofstream file(filename);
+        if (!file.is_open()) {
+            std::cerr << "Failed to save map: cannot open " << filename << std::endl;
+            return;
+        }
+        grid_->writeJSON(file);
+        if (!file.flush()) {
+            std::cerr << "Failed to save map: write error on " << filename << std::endl;
+            return;
         }
     }
+    
+    if (onMapSaved) {
+        onMapSaved(filename);
+    }
 }
 
 void HexGridEditor::loadMap(const std::string& filename) {
-    std::ifstream file(filename);
-    if (file.is_open()) {
-        std::stringstream buffer;
-        buffer << file.rdbuf();
-        importFromJSON(buffer.str());
-        file.close();
+    if (!grid_) return;
+    
+    if (isBinaryMapFile(filename)) {
+        std::string error;
+        if (!grid_->loadBinary(filename, &error)) {
+            std::cerr << "Failed to load map: " << error << std::endl;
+            return;
+        }
+        renderer_->setGrid(grid_);
+    } else {
+        std::ifstream file(filename, std::ios::binary);
+        if (!file.is_open()) {
+            std::cerr << "Failed to load map: cannot open " << filename << std::endl;
+            return;
+        }
         
-        if (onMapLoaded) {
-            onMapLoaded(filename);
+        // Parsed straight from the stream; the grid is left unchanged on failure
+        std::string error;
+        if (!grid_->readJSON(file, &error)) {
+            std::cerr << "Failed to load map: " << error << std::endl;
+            return;
         }
+        renderer_->setGrid(grid_);
     }
+    
+    if (onMapLoaded) {
+        onMapLoaded(filename);
+    }
+}
+
+bool HexGridEditor::isBinaryMapFile(const std::string& filename) {
+    static const std::string extension = ".hexmap";
+    return filename.size() >= extension.size() &&
+           filename.compare(filename.size() - extension.size(), extension.size(), extension) == 0;
 }
 
 void HexGridEditor::paintTerrain(const HexCoordinate& coord, TerrainType terrain) {
@@ -207,7 +246,7 @@ void HexGridEditor::paintTerrain(const HexCoordinate& coord, TerrainType terrain
     action.description = "Paint " + HexTileUtils::getTerrainName(terrain);
     
     // Execute change
-    tile->setTerrainType(terrain);
+    grid_->setTerrain(coord, terrain);
     
     addToHistory(action);
     
@@ -257,7 +296,7 @@ void HexGridEditor::floodFillRecursive(const HexCoordinate& coord, TerrainType t
     if (std::find(filled.begin(), filled.end(), coord) != filled.end()) return;
     
     // Fill this tile
-    tile->setTerrainType(newTerrain);
+    grid_->setTerrain(coord, newTerrain);
     filled.push_back(coord);
     
     // Recursively fill neighbors
@@ -282,7 +321,7 @@ void HexGridEditor::adjustHeight(const HexCoordinate& coord, int height) {
     action.newHeight = height;
     action.description = "Set height to " + std::to_string(height);
     
-    tile->setHeight(height);
+    grid_->setHeight(coord, height);
     addToHistory(action);
     
     if (onActionExecuted) {
@@ -305,7 +344,7 @@ void HexGridEditor::placeUnit(const HexCoordinate& coord, const std::string& uni
     action.newUnit = unitType;
     action.description = "Place " + unitType;
     
-    tile->setOccupant(unitType);
+    grid_->setOccupant(coord, unitType);
     addToHistory(action);
     
     if (onActionExecuted) {
@@ -328,7 +367,7 @@ void HexGridEditor::removeUnit(const HexCoordinate& coord) {
     action.newUnit = "";
     action.description = "Remove " + oldUnit;
     
-    tile->setOccupant("");
+    grid_->setOccupant(coord, "");
     addToHistory(action);
     
     if (onActionExecuted) {
@@ -444,28 +483,16 @@ void HexGridEditor::undo() {
     
     // Reverse the action
     switch (action.type) {
-        case EditorAction::TERRAIN_CHANGE: {
-            HexTile* tile = grid_->getTile(action.coordinate);
-            if (tile) {
-                tile->setTerrainType(action.oldTerrain);
-            }
+        case EditorAction::TERRAIN_CHANGE:
+            grid_->setTerrain(action.coordinate, action.oldTerrain);
             break;
-        }
-        case EditorAction::HEIGHT_CHANGE: {
-            HexTile* tile = grid_->getTile(action.coordinate);
-            if (tile) {
-                tile->setHeight(action.oldHeight);
-            }
+        case EditorAction::HEIGHT_CHANGE:
+            grid_->setHeight(action.coordinate, action.oldHeight);
             break;
-        }
         case EditorAction::UNIT_PLACE:
-        case EditorAction::UNIT_REMOVE: {
-            HexTile* tile = grid_->getTile(action.coordinate);
-            if (tile) {
-                tile->setOccupant(action.oldUnit);
-            }
+        case EditorAction::UNIT_REMOVE:
+            grid_->setOccupant(action.coordinate, action.oldUnit);
             break;
-        }
     }
 }
 
@@ -477,28 +504,16 @@ void HexGridEditor::redo() {
     
     // Re-execute the action
     switch (action.type) {
-        case EditorAction::TERRAIN_CHANGE: {
-            HexTile* tile = grid_->getTile(action.coordinate);
-            if (tile) {
-                tile->setTerrainType(action.newTerrain);
-            }
+        case EditorAction::TERRAIN_CHANGE:
+            grid_->setTerrain(action.coordinate, action.newTerrain);
             break;
-        }
-        case EditorAction::HEIGHT_CHANGE: {
-            HexTile* tile = grid_->getTile(action.coordinate);
-            if (tile) {
-                tile->setHeight(action.newHeight);
-            }
+        case EditorAction::HEIGHT_CHANGE:
+            grid_->setHeight(action.coordinate, action.newHeight);
             break;
-        }
         case EditorAction::UNIT_PLACE:
-        case EditorAction::UNIT_REMOVE: {
-            HexTile* tile = grid_->getTile(action.coordinate);
-            if (tile) {
-                tile->setOccupant(action.newUnit);
-            }
+        case EditorAction::UNIT_REMOVE:
+            grid_->setOccupant(action.coordinate, action.newUnit);
             break;
-        }
     }
 }
 
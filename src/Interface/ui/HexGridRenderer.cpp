@@ -1,13 +1,16 @@
 #include "Interface/ui/HexGridRenderer.h"
 #include "Interface/ui/HexTile.h"
+#include "Interface/ui/HexWorld.h"
 #include "Systems/SDLManager.h"
+#include "Systems/GlyphAtlas.h"
+#include "UIConstants.h"
 #include <cmath>
 #include <algorithm>
 #include <iostream>
 
 HexGridRenderer::HexGridRenderer(int x, int y, int width, int height, SDLManager& sdlManager, 
                                 std::shared_ptr<HexGrid> grid)
-    : UIComponent(x, y, width, height, sdlManager), grid_(grid) {
+    : UIComponent(x, y, width, height, sdlManager) {
     // Default configuration suitable for tactical maps
     config_.hexSize = 40.0f;  // Larger hexagons for better visibility
     config_.showGrid = true;
@@ -21,24 +24,71 @@ HexGridRenderer::HexGridRenderer(int x, int y, int width, int height, SDLManager
     
     // Brighter grid lines
     config_.gridColor = {128, 128, 128, 255};
+    
+    setGrid(grid);
+}
+
+HexGridRenderer::~HexGridRenderer() {
+    if (grid_ && changeCursorId_ >= 0) {
+        grid_->closeChangeCursor(changeCursorId_);
+    }
+    setLayerCacheEnabled(false);
+}
+
+void HexGridRenderer::setGrid(std::shared_ptr<HexGrid> grid) {
+    if (grid_ && changeCursorId_ >= 0) {
+        grid_->closeChangeCursor(changeCursorId_);
+        changeCursorId_ = -1;
+    }
+    
+    grid_ = grid;
+    releaseLayerChunks();
+    overviewDirty_ = true;
+    markersDirty_ = true;
+    
+    if (grid_) {
+        changeCursorId_ = grid_->openChangeCursor();
+    }
+}
+
+void HexGridRenderer::applyGridChanges() {
+    if (!grid_ || changeCursorId_ < 0) return;
+    
+    // Edits are applied once per frame, however often a tile changed in between
+    if (!grid_->drainChanges(changeCursorId_, pendingChanges_)) {
+        onTileChanged(-1, HexGrid::CHANGE_LAYOUT);
+        return;
+    }
+    for (const HexGrid::TileChangeRecord& record : pendingChanges_) {
+        onTileChanged(record.index, record.changes);
+    }
 }
 
 void HexGridRenderer::render() {
     if (!grid_) return;
     
-    // Set viewport clipping
-    SDL_Rect clipRect = {x_, y_, width_, height_};
-    SDL_RenderSetClipRect(sdlManager_.getRenderer(), &clipRect);
+    updateWorldPrefetch();
+    
+    // Clip to the viewport within any clip already active (for example a partial redraw)
+    ClipState clip;
+    if (!pushClipRect({x_, y_, width_, height_}, clip)) return;
     
     // Render background
     renderBackground({40, 30, 20, 255}); // Roman parchment-like background
     
-    // Render in order: grid -> tiles -> highlights -> selection -> hover -> animations -> overlays
-    if (config_.showGrid) {
-        renderGrid();
+    applyGridChanges();
+    
+    // Static layer (grid -> tiles): terrain overview when zoomed far out, otherwise cached
+    // chunks, drawn directly if render targets are unavailable
+    DetailLevel detail = getDetailLevel();
+    if (detail.overview) {
+        renderOverview();
+    } else if (!renderCachedMapLayer()) {
+        renderTiles();
     }
     
-    renderTiles();
+    // Dynamic overlay: markers -> highlights -> selection -> hover -> animations -> overlays
+    renderTileMarkers();
     
     if (config_.showHighlights) {
         renderHighlights();
@@ -53,8 +103,7 @@ void HexGridRenderer::render() {
         renderDebugInfo();
     }
     
-    // Clear clipping
-    SDL_RenderSetClipRect(sdlManager_.getRenderer(), nullptr);
+    popClipRect(clip);
 }
 
 void HexGridRenderer::handleEvent(const SDL_Event& event) {
@@ -155,9 +204,9 @@ void HexGridRenderer::hexToWindowCoords(const HexCoordinate& coord, float& windo
 }
 
 void HexGridRenderer::highlightTile(const HexCoordinate& coord, const SDL_Color& color) {
-    if (auto* tile = grid_->getTile(coord)) {
-        tile->setHighlighted(true);
-        tile->setHighlightColor(color);
+    int index = grid_->getTileIndex(coord);
+    if (index >= 0) {
+        grid_->setHighlight(index, color);
     }
 }
 
@@ -168,11 +217,19 @@ void HexGridRenderer::highlightTiles(const std::vector<HexCoordinate>& coords, c
 }
 
 void HexGridRenderer::highlightMovementRange(const HexCoordinate& start, int movementPoints, const SDL_Color& color) {
-    auto range = grid_->calculateMovementRange(start, movementPoints);
+    thread_local PathfindingWorkspace workspace;
+    thread_local MovementField field;
+    
+    grid_->calculateMovementRange(start, movementPoints, workspace, field);
+    highlightMovementRange(field, color);
+}
+
+void HexGridRenderer::highlightMovementRange(const MovementField& field, const SDL_Color& color) {
+    if (!grid_) return;
     
-    for (const auto& [coord, cost] : range.reachableTiles) {
-        if (coord != start) { // Don't highlight starting position
-            highlightTile(coord, color);
+    for (int index : field.tiles) {
+        if (index != field.startIndex) { // Don't highlight starting position
+            grid_->setHighlight(index, color);
         }
     }
 }
@@ -216,128 +273,703 @@ void HexGridRenderer::clearHover() {
     hasHover_ = false;
 }
 
-std::vector<HexCoordinate> HexGridRenderer::getVisibleTiles() const {
-    std::vector<HexCoordinate> visibleTiles;
+const std::vector<HexCoordinate>& HexGridRenderer::getVisibleTiles() const {
+    updateVisibleRegion();
+    
+    // Listed on demand; zoomed-out passes walk the window by index instead
+    VisibleRegion& region = visibleRegion_;
+    if (!region.tilesListed) {
+        visibleTiles_.clear();
+        for (int row = region.window.rowMin; row <= region.window.rowMax; ++row) {
+            for (int col = region.window.colMin[row & 1]; col <= region.window.colMax[row & 1]; ++col) {
+                visibleTiles_.push_back(HexCoordinate::fromOffset(col, row));
+            }
+        }
+        region.tilesListed = true;
+    }
+    return visibleTiles_;
+}
+
+bool HexGridRenderer::isTileVisible(const HexCoordinate& coord) const {
+    if (!grid_ || !grid_->isValidCoordinate(coord)) return false;
     
-    if (!grid_) return visibleTiles;
+    updateVisibleRegion();
     
-    // Calculate screen bounds in world coordinates
+    int col, row;
+    coord.toOffset(col, row);
+    const TileWindow& window = visibleRegion_.window;
+    return row >= window.rowMin && row <= window.rowMax &&
+           col >= window.colMin[row & 1] && col <= window.colMax[row & 1];
+}
+
+void HexGridRenderer::updateVisibleRegion() const {
+    VisibleRegion& region = visibleRegion_;
+    const HexGrid* grid = grid_.get();
+    int gridWidth = grid ? grid->getWidth() : 0;
+    int gridHeight = grid ? grid->getHeight() : 0;
+    
+    if (region.grid == grid && region.gridWidth == gridWidth && region.gridHeight == gridHeight &&
+        region.width == width_ && region.height == height_ &&
+        region.panX == config_.panX && region.panY == config_.panY &&
+        region.zoom == config_.zoomLevel && region.hexSize == config_.hexSize &&
+        region.culling == config_.enableCulling) {
+        return;
+    }
+    
+    region.grid = grid;
+    region.gridWidth = gridWidth;
+    region.gridHeight = gridHeight;
+    region.width = width_;
+    region.height = height_;
+    region.panX = config_.panX;
+    region.panY = config_.panY;
+    region.zoom = config_.zoomLevel;
+    region.hexSize = config_.hexSize;
+    region.culling = config_.enableCulling;
+    
+    TileWindow& window = region.window;
+    if (config_.enableCulling) {
+        // Component bounds in world space
+        float minX = 0, minY = 0;
+        float maxX = width_, maxY = height_;
+        reverseViewTransform(minX, minY);
+        reverseViewTransform(maxX, maxY);
+        computeTileWindow(minX, minY, maxX, maxY, config_.hexSize, window);
+    } else {
+        window.rowMin = 0;
+        window.rowMax = gridHeight - 1;
+        for (int parity = 0; parity < 2; ++parity) {
+            window.colMin[parity] = 0;
+            window.colMax[parity] = gridWidth - 1;
+        }
+    }
+    region.tilesListed = false;
+}
+
+void HexGridRenderer::getViewOffsetBounds(int& minCol, int& minRow, int& maxCol, int& maxRow) const {
     float minX = 0, minY = 0;
     float maxX = width_, maxY = height_;
     reverseViewTransform(minX, minY);
     reverseViewTransform(maxX, maxY);
     
-    // Expand bounds to include partially visible tiles
-    float padding = config_.hexSize * 2.0f;
-    minX -= padding; minY -= padding;
-    maxX += padding; maxY += padding;
+    // Same tile spacing as computeTileWindow, widened by half a column for odd rows
+    const float size = std::max(config_.hexSize, 1.0f);
+    const float columnSpacing = std::sqrt(3.0f) * size;
+    const float rowSpacing = 1.5f * size;
+    minRow = static_cast<int>(std::ceil((minY - size) / rowSpacing));
+    maxRow = static_cast<int>(std::floor((maxY + size) / rowSpacing));
+    minCol = static_cast<int>(std::ceil((minX - columnSpacing / 2.0f) / columnSpacing - 0.5f));
+    maxCol = static_cast<int>(std::floor((maxX + columnSpacing / 2.0f) / columnSpacing));
+}
+
+void HexGridRenderer::setStreamingWorld(HexWorld* world, int originCol, int originRow) {
+    world_ = world;
+    worldOriginCol_ = originCol;
+    worldOriginRow_ = originRow;
+    prefetchedView_[2] = prefetchedView_[3] = -1;   // Queue on the next render
+}
+
+void HexGridRenderer::updateWorldPrefetch() {
+    if (!world_ || !world_->isOpen()) return;
+    
+    int minCol, minRow, maxCol, maxRow;
+    getViewOffsetBounds(minCol, minRow, maxCol, maxRow);
+    const int margin = HexWorld::CHUNK_SIZE / 2;
+    int view[4] = {minCol + worldOriginCol_ - margin, minRow + worldOriginRow_ - margin,
+                   maxCol + worldOriginCol_ + margin, maxRow + worldOriginRow_ + margin};
+    if (std::equal(view, view + 4, prefetchedView_)) return;
     
-    // Check all tiles in grid (optimization: could use spatial indexing)
-    for (const HexCoordinate& coord : grid_->getAllCoordinates()) {
-        float tileX, tileY;
-        hexToScreen(coord, tileX, tileY);  // Use hexToScreen which applies transforms
-        
-        if (tileX >= 0 && tileX <= width_ && tileY >= 0 && tileY <= height_) {
-            visibleTiles.push_back(coord);
-        }
+    std::copy(view, view + 4, prefetchedView_);
+    world_->prefetchRegion(view[0], view[1], view[2], view[3]);
+}
+
+void HexGridRenderer::computeTileWindow(float minX, float minY, float maxX, float maxY, float hexSize,
+                                        TileWindow& window) const {
+    window = TileWindow();
+    if (!grid_ || config_.zoomLevel <= 0.0f || hexSize <= 0.0f) {
+        return;
     }
     
-    return visibleTiles;
+    int gridWidth = grid_->getWidth();
+    int gridHeight = grid_->getHeight();
+    
+    // Tile centers sit at (sqrt(3) * size * (col + (row & 1) / 2), 1.5 * size * row);
+    // keep every tile whose bounding box overlaps the rectangle
+    const float size = hexSize;
+    const float columnSpacing = std::sqrt(3.0f) * size;
+    const float rowSpacing = 1.5f * size;
+    const float halfWidth = columnSpacing / 2.0f;
+    const float halfHeight = size;
+    
+    auto clampToGrid = [](float value, int limit) {
+        return static_cast<int>(std::max(-1.0f, std::min(static_cast<float>(limit), value)));
+    };
+    
+    window.rowMin = std::max(0, clampToGrid(std::ceil((minY - halfHeight) / rowSpacing), gridHeight));
+    window.rowMax = std::min(gridHeight - 1, clampToGrid(std::floor((maxY + halfHeight) / rowSpacing), gridHeight));
+    for (int parity = 0; parity < 2; ++parity) {
+        float shift = parity * 0.5f;
+        window.colMin[parity] = std::max(0, clampToGrid(std::ceil((minX - halfWidth) / columnSpacing - shift), gridWidth));
+        window.colMax[parity] = std::min(gridWidth - 1, clampToGrid(std::floor((maxX + halfWidth) / columnSpacing - shift), gridWidth));
+    }
 }
 
-void HexGridRenderer::renderHexagon(const HexCoordinate& coord, const SDL_Color& fillColor, 
-                                   const SDL_Color& borderColor, float borderThickness) {
-    auto points = getHexagonPointsF(coord);
+SDL_Color HexGridRenderer::getTileFillColor(int index) const {
+    // Terrain and height come from the grid's packed hot arrays
+    SDL_Color tileColor = HexTileUtils::getTerrainColor(grid_->getTerrainAt(index));
     
-    // Fill hexagon
-    SDL_SetRenderDrawColor(sdlManager_.getRenderer(), fillColor.r, fillColor.g, fillColor.b, fillColor.a);
+    // Adjust color based on height (darker for higher elevations)
+    int heightFactor = grid_->getHeightAt(index) * 20;
+    tileColor.r = std::max(0, static_cast<int>(tileColor.r) - heightFactor);
+    tileColor.g = std::max(0, static_cast<int>(tileColor.g) - heightFactor);
+    tileColor.b = std::max(0, static_cast<int>(tileColor.b) - heightFactor);
+    return tileColor;
+}
+
+void HexGridRenderer::getCornerOffsets(SDL_FPoint corners[6], float radius) const {
+    for (int i = 0; i < 6; ++i) {
+        float angle = (i * 60.0f - 30.0f) * M_PI / 180.0f; // Same orientation as getHexagonPointsF
+        corners[i] = {radius * static_cast<float>(cos(angle)), radius * static_cast<float>(sin(angle))};
+    }
+}
+
+void HexGridRenderer::appendHexagonFill(GeometryBatch& batch, float centerX, float centerY,
+                                        const SDL_FPoint corners[6], const SDL_Color& color) {
+    int base = static_cast<int>(batch.vertices.size());
+    for (int i = 0; i < 6; ++i) {
+        batch.vertices.push_back({{centerX + corners[i].x, centerY + corners[i].y}, color, {0.0f, 0.0f}});
+    }
     
-    // Simple polygon fill using triangulation
-    SDL_FPoint center;
-    hexToScreen(coord, center.x, center.y);
+    // Fan over the corners: 4 triangles per hexagon
+    for (int i = 1; i < 5; ++i) {
+        batch.indices.push_back(base);
+        batch.indices.push_back(base + i);
+        batch.indices.push_back(base + i + 1);
+    }
+}
+
+bool HexGridRenderer::getEdgeStyle(bool showGrid, float borderThickness, SDL_Color& color, float& thickness) const {
+    // Borders trace the same edges as grid lines, so one of the two is drawn, never both
+    if (borderThickness > 0.0f) {
+        color = config_.borderColor;
+        thickness = borderThickness;
+        return true;
+    }
+    if (showGrid) {
+        color = config_.gridColor;
+        thickness = 1.0f;
+        return true;
+    }
+    return false;
+}
+
+void HexGridRenderer::appendHexagonOutline(GeometryBatch& batch, float centerX, float centerY,
+                                           const SDL_FPoint corners[6], const SDL_Color& color, float thickness) {
+    float half = thickness / 2.0f;
     
-    for (size_t i = 0; i < points.size(); ++i) {
-        size_t next = (i + 1) % points.size();
+    for (int i = 0; i < 6; ++i) {
+        const SDL_FPoint& from = corners[i];
+        const SDL_FPoint& to = corners[(i + 1) % 6];
         
-        SDL_Vertex vertices[3] = {
-            {{center.x, center.y}, {fillColor.r, fillColor.g, fillColor.b, fillColor.a}},
-            {{points[i].x, points[i].y}, {fillColor.r, fillColor.g, fillColor.b, fillColor.a}},
-            {{points[next].x, points[next].y}, {fillColor.r, fillColor.g, fillColor.b, fillColor.a}}
-        };
+        // Edge as a thin quad, extended by half the thickness so corners join without gaps
+        float dx = to.x - from.x;
+        float dy = to.y - from.y;
+        float length = std::sqrt(dx * dx + dy * dy);
+        if (length <= 0.0f) continue;
+        float ux = dx / length * half;
+        float uy = dy / length * half;
+        
+        float startX = centerX + from.x - ux, startY = centerY + from.y - uy;
+        float endX = centerX + to.x + ux, endY = centerY + to.y + uy;
         
-        SDL_RenderGeometry(sdlManager_.getRenderer(), nullptr, vertices, 3, nullptr, 0);
+        int base = static_cast<int>(batch.vertices.size());
+        batch.vertices.push_back({{startX - uy, startY + ux}, color, {0.0f, 0.0f}});
+        batch.vertices.push_back({{startX + uy, startY - ux}, color, {0.0f, 0.0f}});
+        batch.vertices.push_back({{endX + uy, endY - ux}, color, {0.0f, 0.0f}});
+        batch.vertices.push_back({{endX - uy, endY + ux}, color, {0.0f, 0.0f}});
+        
+        const int quad[6] = {0, 1, 2, 0, 2, 3};
+        for (int index : quad) {
+            batch.indices.push_back(base + index);
+        }
+    }
+}
+
+void HexGridRenderer::submitBatch(GeometryBatch& batch) {
+    if (!batch.indices.empty()) {
+        SDL_RenderGeometry(sdlManager_.getRenderer(), nullptr,
+                           batch.vertices.data(), static_cast<int>(batch.vertices.size()),
+                           batch.indices.data(), static_cast<int>(batch.indices.size()));
+    }
+    batch.clear();
+}
+
+void HexGridRenderer::renderTiles() {
+    if (!grid_) return;
+    
+    const auto& visibleTiles = getVisibleTiles();
+    if (visibleTiles.empty()) return;
+    
+    DetailLevel detail = getDetailLevel();
+    SDL_FPoint corners[6];
+    getCornerOffsets(corners, getHexagonRadius());
+    
+    SDL_Color edgeColor;
+    float edgeThickness;
+    bool edges = detail.borders && getEdgeStyle(config_.showGrid, config_.borderThickness, edgeColor, edgeThickness);
+    
+    fillBatch_.clear();
+    lineBatch_.clear();
+    
+    // One pass builds every fill and edge; both batches keep their capacity between frames
+    for (const HexCoordinate& coord : visibleTiles) {
+        float centerX, centerY;
+        hexToScreen(coord, centerX, centerY);
+        appendHexagonFill(fillBatch_, centerX, centerY, corners, getTileFillColor(grid_->getTileIndex(coord)));
+        if (edges) {
+            appendHexagonOutline(lineBatch_, centerX, centerY, corners, edgeColor, edgeThickness);
+        }
     }
     
-    // Draw border
-    SDL_SetRenderDrawColor(sdlManager_.getRenderer(), borderColor.r, borderColor.g, borderColor.b, borderColor.a);
+    submitBatch(fillBatch_);
+    submitBatch(lineBatch_);
     
-    for (size_t i = 0; i < points.size(); ++i) {
-        size_t next = (i + 1) % points.size();
-        SDL_RenderDrawLineF(sdlManager_.getRenderer(), points[i].x, points[i].y, points[next].x, points[next].y);
+    // Show coordinates if enabled and readable at this zoom
+    if (detail.labels) {
+        for (const HexCoordinate& coord : visibleTiles) {
+            std::string coordText = std::to_string(coord.x) + "," + std::to_string(coord.y) + "," + std::to_string(coord.z);
+            renderTileText(coord, coordText, config_.coordinateTextColor);
+        }
+        
+        if (GlyphAtlas* atlas = sdlManager_.getGlyphAtlas()) {
+            atlas->flush();
+        }
     }
 }
 
-void HexGridRenderer::renderTiles() {
+void HexGridRenderer::renderTileMarkers() {
     if (!grid_) return;
     
-    auto visibleTiles = getVisibleTiles();
-    
-    // Debug: render at least some tiles if we have any coordinates
-    if (visibleTiles.empty() && !grid_->getAllCoordinates().empty()) {
-        // Fallback: render a few tiles around origin
-        for (int x = -2; x <= 2; x++) {
-            for (int z = -2; z <= 2; z++) {
-                int y = -x - z;
-                HexCoordinate coord(x, y, z);
-                if (grid_->isValidCoordinate(coord)) {
-                    visibleTiles.push_back(coord);
-                }
-            }
+    // Units, supply points and formations change often, so they stay out of the cached layer
+    if (getDetailLevel().markers) {
+        for (const HexCoordinate& coord : getVisibleTiles()) {
+            renderTileContent(coord);
         }
+        return;
     }
     
-    for (const HexCoordinate& coord : visibleTiles) {
-        const HexTile* tile = grid_->getTile(coord);
+    // Zoomed out: one small square per unit or supply point, a single call per color. Only the
+    // sparse marker list is walked, from the first visible row to the last.
+    const std::vector<int>& markers = getMarkerTiles();
+    updateVisibleRegion();
+    const TileWindow& window = visibleRegion_.window;
+    const int gridWidth = grid_->getWidth();
+    
+    unitPoints_.clear();
+    supplyPoints_.clear();
+    for (auto it = std::lower_bound(markers.begin(), markers.end(), window.rowMin * gridWidth);
+         it != markers.end(); ++it) {
+        int row = *it / gridWidth;
+        int col = *it % gridWidth;
+        if (row > window.rowMax) break;
+        if (col < window.colMin[row & 1] || col > window.colMax[row & 1]) continue;
         
-        SDL_Color tileColor;
-        if (tile) {
-            // Get terrain color from existing tile
-            tileColor = HexTileUtils::getTerrainColor(tile->getTerrainType());
+        float centerX, centerY;
+        hexToScreen(grid_->getCoordinateAt(*it), centerX, centerY);
+        SDL_FRect point = {centerX - 1.0f, centerY - 1.0f, 2.0f, 2.0f};
+        (grid_->isOccupiedAt(*it) ? unitPoints_ : supplyPoints_).push_back(point);
+    }
+    
+    SDL_Renderer* renderer = sdlManager_.getRenderer();
+    if (!unitPoints_.empty()) {
+        SDL_SetRenderDrawColor(renderer, 255, 0, 0, 255);
+        SDL_RenderFillRectsF(renderer, unitPoints_.data(), static_cast<int>(unitPoints_.size()));
+    }
+    if (!supplyPoints_.empty()) {
+        SDL_SetRenderDrawColor(renderer, 255, 215, 0, 255); // Gold
+        SDL_RenderFillRectsF(renderer, supplyPoints_.data(), static_cast<int>(supplyPoints_.size()));
+    }
+}
+
+HexGridRenderer::DetailLevel HexGridRenderer::getDetailLevel(float zoom) const {
+    DetailLevel detail;
+    detail.labels = config_.showCoordinates && zoom >= config_.lodLabelZoom;
+    detail.borders = zoom >= config_.lodBorderZoom;
+    detail.markers = zoom >= config_.lodMarkerZoom;
+    detail.overview = zoom < config_.lodOverviewZoom;
+    return detail;
+}
+
+void HexGridRenderer::renderOverview() {
+    if (overviewDirty_) {
+        overview_.resize(grid_->getWidth(), grid_->getHeight());
+        for (int row = 0; row < grid_->getHeight(); ++row) {
+            for (int col = 0; col < grid_->getWidth(); ++col) {
+                overview_.setTileColor(col, row, getTileFillColor(row * grid_->getWidth() + col));
+            }
+        }
+        overviewDirty_ = false;
+    }
+    
+    // Overview texels are half a hexagon wide and one row tall; texel (0, 0) starts at the
+    // left edge of tile (0, 0), a quarter hexagon above its center
+    const float size = config_.hexSize;
+    const float zoom = config_.zoomLevel;
+    float originX = -std::sqrt(3.0f) / 2.0f * size;
+    float originY = -0.75f * size;
+    applyViewTransform(originX, originY);
+    
+    overview_.render(sdlManager_.getRenderer(), originX, originY,
+                     std::sqrt(3.0f) / 2.0f * size * zoom, 1.5f * size * zoom, width_, height_);
+}
+
+void HexGridRenderer::setLayerCacheEnabled(bool enabled) {
+    layerCacheEnabled_ = enabled;
+    if (!enabled) {
+        releaseLayerChunks();
+        for (SDL_Texture* texture : freeChunkTextures_) {
+            SDL_DestroyTexture(texture);
+        }
+        freeChunkTextures_.clear();
+    }
+}
+
+void HexGridRenderer::invalidateMapLayer() {
+    for (auto& entry : layerChunks_) {
+        entry.second.dirty = true;
+    }
+}
+
+void HexGridRenderer::releaseLayerChunks() {
+    // Keep textures for reuse: every chunk has the same size
+    for (auto& entry : layerChunks_) {
+        freeChunkTextures_.push_back(entry.second.texture);
+    }
+    layerChunks_.clear();
+    
+    while (static_cast<int>(freeChunkTextures_.size()) > UIConstants::HEX_LAYER_MAX_CHUNKS) {
+        SDL_DestroyTexture(freeChunkTextures_.back());
+        freeChunkTextures_.pop_back();
+    }
+}
+
+HexGridRenderer::LayerSettings HexGridRenderer::makeLayerSettings(float zoom) const {
+    DetailLevel detail = getDetailLevel(zoom);
+    LayerSettings settings;
+    settings.zoom = zoom;
+    settings.hexSize = config_.hexSize;
+    settings.borderThickness = detail.borders ? config_.borderThickness : 0.0f;
+    settings.showGrid = config_.showGrid && detail.borders;
+    settings.showCoordinates = detail.labels;
+    settings.gridColor = config_.gridColor;
+    settings.borderColor = config_.borderColor;
+    settings.textColor = config_.coordinateTextColor;
+    return settings;
+}
+
+bool HexGridRenderer::sameLayerSettings(const LayerSettings& a, const LayerSettings& b) {
+    auto sameColor = [](const SDL_Color& x, const SDL_Color& y) {
+        return x.r == y.r && x.g == y.g && x.b == y.b && x.a == y.a;
+    };
+    return a.zoom == b.zoom && a.hexSize == b.hexSize && a.borderThickness == b.borderThickness &&
+           a.showGrid == b.showGrid && a.showCoordinates == b.showCoordinates &&
+           sameColor(a.gridColor, b.gridColor) && sameColor(a.borderColor, b.borderColor) &&
+           sameColor(a.textColor, b.textColor);
+}
+
+const std::vector<int>& HexGridRenderer::getMarkerTiles() {
+    applyGridChanges();
+    if (markersDirty_) {
+        markerTiles_.clear();
+        for (int index = 0; grid_ && index < grid_->getTileCount(); ++index) {
+            if (grid_->getTileFlags(index) & (HexGrid::TILE_OCCUPIED | HexGrid::TILE_SUPPLY)) {
+                markerTiles_.push_back(index);
+            }
+        }
+        markersDirty_ = false;
+    }
+    return markerTiles_;
+}
+
+void HexGridRenderer::onTileChanged(int index, uint8_t changes) {
+    if (index < 0 || (changes & HexGrid::CHANGE_LAYOUT)) {
+        releaseLayerChunks();
+        overviewDirty_ = true;
+        markersDirty_ = true;
+        return;
+    }
+    
+    if ((changes & HexGrid::CHANGE_FLAGS) && !markersDirty_) {
+        bool marked = grid_->getTileFlags(index) & (HexGrid::TILE_OCCUPIED | HexGrid::TILE_SUPPLY);
+        auto it = std::lower_bound(markerTiles_.begin(), markerTiles_.end(), index);
+        bool listed = it != markerTiles_.end() && *it == index;
+        if (marked && !listed) {
+            markerTiles_.insert(it, index);
+        } else if (!marked && listed) {
+            markerTiles_.erase(it);
+        }
+    }
+    
+    // Markers and highlights are drawn every frame; only fill colors live in the chunks
+    if (!(changes & (HexGrid::CHANGE_TERRAIN | HexGrid::CHANGE_HEIGHT))) {
+        return;
+    }
+    
+    if (!overviewDirty_) {
+        overview_.setTileColor(index % grid_->getWidth(), index / grid_->getWidth(), getTileFillColor(index));
+    }
+    if (layerChunks_.empty()) {
+        return;
+    }
+    
+    float x, y;
+    grid_->getCoordinateAt(index).toScreenCoords(x, y, layerSettings_.hexSize);
+    x *= layerSettings_.zoom;
+    y *= layerSettings_.zoom;
+    
+    // The hexagon plus any label centered on it
+    const float chunkSize = UIConstants::HEX_LAYER_CHUNK_SIZE;
+    float reach = std::max(layerSettings_.hexSize * layerSettings_.zoom, LAYER_LABEL_MARGIN);
+    
+    for (int chunkY = static_cast<int>(std::floor((y - reach) / chunkSize));
+         chunkY <= static_cast<int>(std::floor((y + reach) / chunkSize)); ++chunkY) {
+        for (int chunkX = static_cast<int>(std::floor((x - reach) / chunkSize));
+             chunkX <= static_cast<int>(std::floor((x + reach) / chunkSize)); ++chunkX) {
+            auto it = layerChunks_.find(chunkKey(chunkX, chunkY));
+            if (it != layerChunks_.end()) {
+                it->second.dirty = true;
+            }
+        }
+    }
+}
+
+bool HexGridRenderer::renderCachedMapLayer() {
+    if (!grid_ || !layerCacheEnabled_ || renderTargetsUnavailable_) return false;
+    if (config_.zoomLevel <= 0.0f || config_.hexSize <= 0.0f) return false;
+    
+    SDL_Renderer* renderer = sdlManager_.getRenderer();
+    if (!renderer || !SDL_RenderTargetSupported(renderer)) {
+        renderTargetsUnavailable_ = true;
+        return false;
+    }
+    
+    // Chunk positions are in zoomed world space, so a new zoom level needs a new set. While the
+    // zoom is changing the chunks of the last one are drawn scaled instead; they are redrawn once
+    // the zoom has held for HEX_LAYER_ZOOM_SETTLE_MS. Any other setting change redraws at once.
+    LayerSettings settings = makeLayerSettings(config_.zoomLevel);
+    if (!sameLayerSettings(settings, layerSettings_)) {
+        Uint32 now = SDL_GetTicks();
+        bool zoomOnly = !layerChunks_.empty() &&
+                        sameLayerSettings(makeLayerSettings(layerSettings_.zoom), layerSettings_);
+        if (!zoomOnly || layerZoomTarget_ != config_.zoomLevel) {
+            layerZoomTarget_ = config_.zoomLevel;
+            layerZoomChangedAt_ = now;
+        }
+        if (!zoomOnly || now - layerZoomChangedAt_ >= UIConstants::HEX_LAYER_ZOOM_SETTLE_MS) {
+            layerSettings_ = settings;
+            releaseLayerChunks();
+        }
+    }
+    
+    const int chunkSize = UIConstants::HEX_LAYER_CHUNK_SIZE;
+    const float zoom = layerSettings_.zoom;         // Zoom the chunks are drawn at
+    const float scale = config_.zoomLevel / zoom;   // Chunk pixels to screen pixels
+    const float size = layerSettings_.hexSize;
+    
+    // Visible part of the map in zoomed world space
+    float minX = std::max(-config_.panX / scale, -std::sqrt(3.0f) / 2.0f * size * zoom);
+    float minY = std::max(-config_.panY / scale, -size * zoom);
+    float maxX = std::min((width_ - config_.panX) / scale, std::sqrt(3.0f) * size * grid_->getWidth() * zoom);
+    float maxY = std::min((height_ - config_.panY) / scale, (1.5f * size * (grid_->getHeight() - 1) + size) * zoom);
+    if (minX >= maxX || minY >= maxY) {
+        return true;
+    }
+    
+    int firstChunkX = static_cast<int>(std::floor(minX / chunkSize));
+    int lastChunkX = static_cast<int>(std::floor(maxX / chunkSize));
+    int firstChunkY = static_cast<int>(std::floor(minY / chunkSize));
+    int lastChunkY = static_cast<int>(std::floor(maxY / chunkSize));
+    
+    // Zoomed out so far that the old chunks would not fit the cache: redraw at the new zoom now
+    if (scale != 1.0f &&
+        (lastChunkX - firstChunkX + 1) * (lastChunkY - firstChunkY + 1) > UIConstants::HEX_LAYER_MAX_CHUNKS) {
+        layerSettings_ = settings;
+        releaseLayerChunks();
+        return renderCachedMapLayer();
+    }
+    
+    // Make sure every visible chunk exists and is up to date before drawing any of them
+    ++layerFrame_;
+    for (int chunkY = firstChunkY; chunkY <= lastChunkY; ++chunkY) {
+        for (int chunkX = firstChunkX; chunkX <= lastChunkX; ++chunkX) {
+            LayerChunk& chunk = layerChunks_[chunkKey(chunkX, chunkY)];
             
-            // Adjust color based on height (darker for higher elevations)
-            int heightFactor = tile->getHeight() * 20;
-            tileColor.r = std::max(0, static_cast<int>(tileColor.r) - heightFactor);
-            tileColor.g = std::max(0, static_cast<int>(tileColor.g) - heightFactor);
-            tileColor.b = std::max(0, static_cast<int>(tileColor.b) - heightFactor);
-        } else {
-            // Default color for empty tiles (light gray)
-            tileColor = {180, 180, 180, 255};
+            if (!chunk.texture) {
+                if (!freeChunkTextures_.empty()) {
+                    chunk.texture = freeChunkTextures_.back();
+                    freeChunkTextures_.pop_back();
+                } else {
+                    chunk.texture = SDL_CreateTexture(renderer, SDL_PIXELFORMAT_RGBA32,
+                                                      SDL_TEXTUREACCESS_TARGET, chunkSize, chunkSize);
+                    if (!chunk.texture) {
+                        std::cerr << "Hex layer chunk creation failed: " << SDL_GetError() << std::endl;
+                        layerChunks_.erase(chunkKey(chunkX, chunkY));
+                        renderTargetsUnavailable_ = true;
+                        setLayerCacheEnabled(false);
+                        return false;
+                    }
+                    SDL_SetTextureBlendMode(chunk.texture, SDL_BLENDMODE_BLEND);
+                }
+                chunk.dirty = true;
+            }
+            
+            if (chunk.dirty) {
+                renderLayerChunk(chunk, chunkX, chunkY);
+                chunk.dirty = false;
+            }
+            chunk.lastUsed = layerFrame_;
         }
-        
-        renderHexagon(coord, tileColor, config_.borderColor);
-        
-        // Render tile-specific content (only if tile exists)
-        if (tile) {
-            renderTileContent(coord);
+    }
+    
+    // Panning only blits; zooming blits scaled
+    for (int chunkY = firstChunkY; chunkY <= lastChunkY; ++chunkY) {
+        for (int chunkX = firstChunkX; chunkX <= lastChunkX; ++chunkX) {
+            const LayerChunk& chunk = layerChunks_[chunkKey(chunkX, chunkY)];
+            if (scale == 1.0f) {
+                SDL_Rect dst = {
+                    static_cast<int>(std::lround(chunkX * chunkSize + config_.panX)),
+                    static_cast<int>(std::lround(chunkY * chunkSize + config_.panY)),
+                    chunkSize, chunkSize
+                };
+                SDL_RenderCopy(renderer, chunk.texture, nullptr, &dst);
+            } else {
+                SDL_FRect dst = {
+                    chunkX * chunkSize * scale + config_.panX,
+                    chunkY * chunkSize * scale + config_.panY,
+                    chunkSize * scale, chunkSize * scale
+                };
+                SDL_RenderCopyF(renderer, chunk.texture, nullptr, &dst);
+            }
+        }
+    }
+    
+    // Evict least recently used chunks that are off screen
+    int excess = static_cast<int>(layerChunks_.size()) - UIConstants::HEX_LAYER_MAX_CHUNKS;
+    while (excess-- > 0) {
+        auto oldest = layerChunks_.end();
+        for (auto it = layerChunks_.begin(); it != layerChunks_.end(); ++it) {
+            if (it->second.lastUsed < layerFrame_ &&
+                (oldest == layerChunks_.end() || it->second.lastUsed < oldest->second.lastUsed)) {
+                oldest = it;
+            }
+        }
+        if (oldest == layerChunks_.end()) break;
+        SDL_DestroyTexture(oldest->second.texture);
+        layerChunks_.erase(oldest);
+    }
+    
+    return true;
+}
+
+void HexGridRenderer::renderLayerChunk(LayerChunk& chunk, int chunkX, int chunkY) {
+    SDL_Renderer* renderer = sdlManager_.getRenderer();
+    SDL_Texture* previousTarget = SDL_GetRenderTarget(renderer);
+    
+    // Switching render targets resets clipping; the caller's clip is restored afterwards
+    SDL_Rect previousClip;
+    bool clipped = SDL_RenderIsClipEnabled(renderer) == SDL_TRUE;
+    SDL_RenderGetClipRect(renderer, &previousClip);
+    
+    SDL_SetRenderTarget(renderer, chunk.texture);
+    SDL_SetRenderDrawColor(renderer, 0, 0, 0, 0);
+    SDL_RenderClear(renderer);
+    
+    const float chunkSize = UIConstants::HEX_LAYER_CHUNK_SIZE;
+    // Drawn at the chunk set's zoom, not the live one: while a zoom settles they are blitted scaled
+    const float zoom = layerSettings_.zoom;
+    const float size = layerSettings_.hexSize;
+    const float originX = chunkX * chunkSize;
+    const float originY = chunkY * chunkSize;
+    
+    // Tile center relative to the chunk's top-left corner
+    auto chunkPosition = [&](int col, int row, float& x, float& y) {
+        HexCoordinate::fromOffset(col, row).toScreenCoords(x, y, size);
+        x = x * zoom - originX;
+        y = y * zoom - originY;
+    };
+    
+    TileWindow window;
+    computeTileWindow(originX / zoom, originY / zoom, (originX + chunkSize) / zoom, (originY + chunkSize) / zoom,
+                      size, window);
+    
+    SDL_FPoint corners[6];
+    getCornerOffsets(corners, getHexagonRadius(size, zoom));
+    float x, y;
+    
+    // Same pass as renderTiles(), with the level of detail in layerSettings_
+    SDL_Color edgeColor;
+    float edgeThickness;
+    bool edges = getEdgeStyle(layerSettings_.showGrid, layerSettings_.borderThickness, edgeColor, edgeThickness);
+    
+    fillBatch_.clear();
+    lineBatch_.clear();
+    for (int row = window.rowMin; row <= window.rowMax; ++row) {
+        for (int col = window.colMin[row & 1]; col <= window.colMax[row & 1]; ++col) {
+            chunkPosition(col, row, x, y);
+            appendHexagonFill(fillBatch_, x, y, corners, getTileFillColor(row * grid_->getWidth() + col));
+            if (edges) {
+                appendHexagonOutline(lineBatch_, x, y, corners, edgeColor, edgeThickness);
+            }
         }
+    }
+    submitBatch(fillBatch_);
+    submitBatch(lineBatch_);
+    
+    if (layerSettings_.showCoordinates) {
+        // Labels can be wider than a hexagon; include those spilling in from neighboring chunks
+        TileWindow labelWindow;
+        float margin = LAYER_LABEL_MARGIN / zoom;
+        computeTileWindow(originX / zoom - margin, originY / zoom - margin,
+                          (originX + chunkSize) / zoom + margin, (originY + chunkSize) / zoom + margin,
+                          size, labelWindow);
         
-        // Show coordinates if enabled
-        if (config_.showCoordinates) {
-            std::string coordText = std::to_string(coord.x) + "," + std::to_string(coord.y) + "," + std::to_string(coord.z);
-            renderTileText(coord, coordText, config_.coordinateTextColor);
+        GlyphAtlas* atlas = sdlManager_.getGlyphAtlas();
+        for (int row = labelWindow.rowMin; row <= labelWindow.rowMax; ++row) {
+            for (int col = labelWindow.colMin[row & 1]; col <= labelWindow.colMax[row & 1]; ++col) {
+                HexCoordinate coord = HexCoordinate::fromOffset(col, row);
+                std::string coordText = std::to_string(coord.x) + "," + std::to_string(coord.y) + "," + std::to_string(coord.z);
+                
+                int textWidth, textHeight;
+                getTextSize(coordText, textWidth, textHeight);
+                chunkPosition(col, row, x, y);
+                int textX = static_cast<int>(x - textWidth / 2);
+                int textY = static_cast<int>(y - textHeight / 2);
+                
+                if (!atlas || !atlas->queueText(sdlManager_.getFont(), coordText, textX, textY, config_.coordinateTextColor)) {
+                    renderText(coordText, textX - x_, textY - y_, config_.coordinateTextColor);
+                }
+            }
+        }
+        if (atlas) {
+            atlas->flush();
         }
     }
+    
+    SDL_SetRenderTarget(renderer, previousTarget);
+    SDL_RenderSetClipRect(renderer, clipped ? &previousClip : nullptr);
 }
 
 void HexGridRenderer::renderTileContent(const HexCoordinate& coord) {
-    const HexTile* tile = grid_->getTile(coord);
-    if (!tile) return;
+    int index = grid_->getTileIndex(coord);
+    if (index < 0) return;
     
     float centerX, centerY;
     hexToScreen(coord, centerX, centerY);
     
+    uint8_t flags = grid_->getTileFlags(index);
+    
     // Render occupation indicator
-    if (tile->isOccupied()) {
+    if (flags & HexGrid::TILE_OCCUPIED) {
         SDL_SetRenderDrawColor(sdlManager_.getRenderer(), 255, 0, 0, 128);
         float radius = config_.hexSize * config_.zoomLevel * 0.3f;
         
@@ -351,7 +983,7 @@ void HexGridRenderer::renderTileContent(const HexCoordinate& coord) {
     }
     
     // Render special markers
-    if (tile->isSupplyPoint()) {
+    if (flags & HexGrid::TILE_SUPPLY) {
         SDL_SetRenderDrawColor(sdlManager_.getRenderer(), 255, 215, 0, 255); // Gold
         SDL_Rect rect = {
             static_cast<int>(centerX - 3),
@@ -361,7 +993,7 @@ void HexGridRenderer::renderTileContent(const HexCoordinate& coord) {
         SDL_RenderFillRect(sdlManager_.getRenderer(), &rect);
     }
     
-    if (tile->isFormationTile()) {
+    if (grid_->getTileByIndex(index)->isFormationTile()) {
         SDL_SetRenderDrawColor(sdlManager_.getRenderer(), 128, 0, 128, 128); // Purple
         renderHexagonOutline(coord, {128, 0, 128, 128}, 2.0f);
     }
@@ -370,15 +1002,21 @@ void HexGridRenderer::renderTileContent(const HexCoordinate& coord) {
 void HexGridRenderer::renderHighlights() {
     if (!grid_) return;
     
-    auto visibleTiles = getVisibleTiles();
+    SDL_FPoint corners[6];
+    getCornerOffsets(corners, getHexagonRadius());
+    lineBatch_.clear();
     
-    for (const HexCoordinate& coord : visibleTiles) {
-        const HexTile* tile = grid_->getTile(coord);
-        if (!tile || !tile->isHighlighted()) continue;
+    // Only the tracked highlights are visited, not every visible tile
+    for (int index : grid_->getHighlightedTiles()) {
+        const HexTile* tile = grid_->getTileByIndex(index);
+        if (!tile->isHighlighted() || !isTileVisible(tile->getCoordinate())) continue;
         
-        SDL_Color highlightColor = tile->getHighlightColor();
-        renderHexagonOutline(coord, highlightColor, 3.0f);
+        float centerX, centerY;
+        hexToScreen(tile->getCoordinate(), centerX, centerY);
+        appendHexagonOutline(lineBatch_, centerX, centerY, corners, tile->getHighlightColor(), 3.0f);
     }
+    
+    submitBatch(lineBatch_);
 }
 
 void HexGridRenderer::renderSelection() {
@@ -396,20 +1034,15 @@ void HexGridRenderer::renderHover() {
 }
 
 void HexGridRenderer::renderHexagonOutline(const HexCoordinate& coord, const SDL_Color& color, float thickness) {
-    auto points = getHexagonPointsF(coord);
+    SDL_FPoint corners[6];
+    getCornerOffsets(corners, getHexagonRadius());
     
-    SDL_SetRenderDrawColor(sdlManager_.getRenderer(), color.r, color.g, color.b, color.a);
+    float centerX, centerY;
+    hexToScreen(coord, centerX, centerY);
     
-    for (size_t i = 0; i < points.size(); ++i) {
-        size_t next = (i + 1) % points.size();
-        
-        // Draw thick line by drawing multiple parallel lines
-        for (int offset = -static_cast<int>(thickness/2); offset <= static_cast<int>(thickness/2); ++offset) {
-            SDL_RenderDrawLineF(sdlManager_.getRenderer(), 
-                               points[i].x + offset, points[i].y + offset,
-                               points[next].x + offset, points[next].y + offset);
-        }
-    }
+    lineBatch_.clear();
+    appendHexagonOutline(lineBatch_, centerX, centerY, corners, color, thickness);
+    submitBatch(lineBatch_);
 }
 
 std::vector<SDL_FPoint> HexGridRenderer::getHexagonPointsF(const HexCoordinate& coord) const {
@@ -542,27 +1175,6 @@ void HexGridRenderer::handleKeyPress(SDL_Keycode key) {
     }
 }
 
-void HexGridRenderer::renderGrid() {
-    if (!grid_) return;
-    
-    SDL_SetRenderDrawColor(sdlManager_.getRenderer(), 
-                          config_.gridColor.r, config_.gridColor.g, 
-                          config_.gridColor.b, config_.gridColor.a);
-    
-    auto visibleTiles = getVisibleTiles();
-    
-    for (const HexCoordinate& coord : visibleTiles) {
-        auto points = getHexagonPointsF(coord);
-        
-        for (size_t i = 0; i < points.size(); ++i) {
-            size_t next = (i + 1) % points.size();
-            SDL_RenderDrawLineF(sdlManager_.getRenderer(), 
-                               points[i].x, points[i].y, 
-                               points[next].x, points[next].y);
-        }
-    }
-}
-
 void HexGridRenderer::renderTileText(const HexCoordinate& coord, const std::string& text, const SDL_Color& color) {
     // Use the same coordinate system as hexagon rendering for consistency
     float centerX, centerY;
@@ -580,6 +1192,12 @@ void HexGridRenderer::renderTileText(const HexCoordinate& coord, const std::stri
     int textX = static_cast<int>(windowX - textWidth / 2);
     int textY = static_cast<int>(windowY - textHeight / 2);
     
+    // Queue on the glyph atlas so all labels share one draw call; renderTiles flushes
+    GlyphAtlas* atlas = sdlManager_.getGlyphAtlas();
+    if (atlas && atlas->queueText(sdlManager_.getFont(), text, x_ + textX, y_ + textY, color)) {
+        return;
+    }
+    
     renderText(text, textX, textY, color);
 }
 
@@ -0,0 +1,434 @@
+#include "Interface/ui/HexMapFile.h"
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace {
+
+// Side table encoding: native-order integers, strings as uint32 length + bytes
+class DetailsEncoder {
+public:
+    explicit DetailsEncoder(std::vector<uint8_t>& out) : out_(out) {}
+
+    template<typename T>
+    void put(T value) {
+        size_t offset = out_.size();
+        out_.resize(offset + sizeof(T));
+        std::memcpy(out_.data() + offset, &value, sizeof(T));
+    }
+
+    void putString(const std::string& value) {
+        put<uint32_t>(static_cast<uint32_t>(value.size()));
+        out_.insert(out_.end(), value.begin(), value.end());
+    }
+
+private:
+    std::vector<uint8_t>& out_;
+};
+
+class DetailsDecoder {
+public:
+    DetailsDecoder(const uint8_t* data, size_t size) : data_(data), size_(size) {}
+
+    template<typename T>
+    bool get(T& value) {
+        if (size_ - position_ < sizeof(T)) return false;
+        std::memcpy(&value, data_ + position_, sizeof(T));
+        position_ += sizeof(T);
+        return true;
+    }
+
+    bool getBool(bool& value) {
+        uint8_t byte;
+        if (!get(byte)) return false;
+        value = byte != 0;
+        return true;
+    }
+
+    bool getString(std::string& value) {
+        uint32_t length;
+        if (!get(length) || size_ - position_ < length) return false;
+        value.assign(reinterpret_cast<const char*>(data_ + position_), length);
+        position_ += length;
+        return true;
+    }
+
+private:
+    const uint8_t* data_;
+    size_t size_;
+    size_t position_ = 0;
+};
+
+size_t alignSection(size_t offset) {
+    return (offset + HexMapFormat::SECTION_ALIGNMENT - 1) / HexMapFormat::SECTION_ALIGNMENT *
+           HexMapFormat::SECTION_ALIGNMENT;
+}
+
+const TileProperties& defaultProperties(TerrainType terrain) {
+    static const std::vector<TileProperties> defaults = [] {
+        std::vector<TileProperties> table;
+        for (int type = 0; type < TERRAIN_TYPE_COUNT; ++type) {
+            table.push_back(HexTileUtils::getDefaultProperties(static_cast<TerrainType>(type)));
+        }
+        return table;
+    }();
+    return defaults[static_cast<int>(terrain)];
+}
+
+} // namespace
+
+HexMapFormat::PackedTile HexMapFormat::packTile(const HexTile& tile) {
+    PackedTile packed;
+    packed.terrain = tile.getTerrainType();
+    packed.height = packHeight(tile.getHeight());
+    packed.flags = HexGrid::computeTileFlags(tile);
+    packed.movementCost = static_cast<uint8_t>(std::max(0, std::min(255, tile.getMovementCost())));
+    return packed;
+}
+
+void HexMapFormat::unpackTile(const PackedTile& packed, HexTile& tile) {
+    tile.setTerrainType(packed.terrain);
+    tile.setHeight(packed.height);
+    tile.setOccupied(packed.flags & HexGrid::TILE_OCCUPIED);
+
+    TileProperties& props = tile.getProperties();
+    props.passable = packed.flags & HexGrid::TILE_PASSABLE;
+    props.hidden = packed.flags & HexGrid::TILE_HIDDEN;
+    props.buildable = packed.flags & HexGrid::TILE_BUILDABLE;
+    props.supplyPoint = packed.flags & HexGrid::TILE_SUPPLY;
+    props.movementCost = packed.movementCost;
+}
+
+bool HexMapFormat::needsDetails(const HexTile& tile) {
+    const TileProperties& props = tile.getProperties();
+    const TileProperties& base = defaultProperties(tile.getTerrainType());
+    return props.defensiveBonus != base.defensiveBonus || props.evasionBonus != base.evasionBonus ||
+           props.rangedAccuracyPenalty != base.rangedAccuracyPenalty || props.destructible != base.destructible ||
+           props.movementCost < 0 || props.movementCost > 255 || !props.specialTag.empty() ||
+           !tile.getOccupantId().empty() || !tile.getEvents().empty();
+}
+
+HexMapTileDetails HexMapFormat::makeDetails(int index, const HexTile& tile) {
+    return {index, tile.getProperties(), tile.getOccupantId(), tile.getEvents()};
+}
+
+void HexMapFormat::applyDetails(const HexMapTileDetails& details, HexTile& tile) {
+    tile.setProperties(details.properties);
+    if (!details.occupantId.empty()) {
+        tile.setOccupant(details.occupantId);
+    }
+    for (const TileEvent& event : details.events) {
+        tile.addEvent(event);
+    }
+}
+
+HexMapView::~HexMapView() {
+    close();
+}
+
+bool HexMapView::fail(const std::string& message) {
+    close();
+    error_ = message;
+    return false;
+}
+
+bool HexMapView::open(const std::string& filename) {
+    close();
+    error_.clear();
+
+#ifndef _WIN32
+    int fd = ::open(filename.c_str(), O_RDONLY);
+    if (fd < 0) {
+        return fail("Cannot open " + filename);
+    }
+    struct stat info;
+    if (fstat(fd, &info) != 0) {
+        ::close(fd);
+        return fail("Cannot stat " + filename);
+    }
+    size_ = static_cast<size_t>(info.st_size);
+    if (size_ > 0) {
+        void* mapping = mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (mapping != MAP_FAILED) {
+            data_ = static_cast<const uint8_t*>(mapping);
+            mapped_ = true;
+        }
+    }
+    ::close(fd);
+#endif
+
+    if (!data_) {
+        std::ifstream file(filename, std::ios::binary | std::ios::ate);
+        if (!file.is_open()) {
+            return fail("Cannot open " + filename);
+        }
+        buffer_.resize(static_cast<size_t>(file.tellg()));
+        file.seekg(0);
+        if (!file.read(reinterpret_cast<char*>(buffer_.data()), buffer_.size())) {
+            return fail("Cannot read " + filename);
+        }
+        // Keep data_ non-null for an empty file so the header check reports it
+        data_ = buffer_.empty() ? reinterpret_cast<const uint8_t*>("") : buffer_.data();
+        size_ = buffer_.size();
+    }
+
+    // Header
+    HexMapFormat::Header header;
+    if (size_ < sizeof(header)) {
+        return fail("Not a hex map: file too small");
+    }
+    std::memcpy(&header, data_, sizeof(header));
+    if (header.magic != HexMapFormat::MAGIC) {
+        return fail("Not a hex map: bad magic");
+    }
+    if (header.byteOrderMark != HexMapFormat::BYTE_ORDER_MARK) {
+        return fail("Hex map was written with a different byte order");
+    }
+    if (header.version != HexMapFormat::VERSION) {
+        return fail("Unsupported hex map version " + std::to_string(header.version));
+    }
+    if (header.fileSize != size_) {
+        return fail("Hex map is truncated");
+    }
+    if (header.width < 0 || header.height < 0 ||
+        static_cast<int64_t>(header.width) * header.height > HexMapFormat::MAX_TILE_COUNT) {
+        return fail("Hex map has invalid dimensions");
+    }
+    width_ = header.width;
+    height_ = header.height;
+
+    // Section directory
+    size_t directoryEnd = sizeof(header) + static_cast<size_t>(header.sectionCount) * sizeof(HexMapFormat::Section);
+    if (header.sectionCount > 1024 || directoryEnd > size_) {
+        return fail("Hex map section directory is truncated");
+    }
+    size_t tileCount = static_cast<size_t>(getTileCount());
+    for (uint32_t i = 0; i < header.sectionCount; ++i) {
+        HexMapFormat::Section section;
+        std::memcpy(&section, data_ + sizeof(header) + i * sizeof(section), sizeof(section));
+        if (section.offset > size_ || section.size > size_ - section.offset) {
+            return fail("Hex map section " + std::to_string(section.type) + " is out of bounds");
+        }
+
+        const uint8_t* start = data_ + section.offset;
+        bool isArray = section.type >= HexMapFormat::SECTION_TERRAIN &&
+                       section.type <= HexMapFormat::SECTION_MOVEMENT_COST;
+        if (isArray && section.size != tileCount) {
+            return fail("Hex map section " + std::to_string(section.type) + " has the wrong size");
+        }
+
+        switch (section.type) {
+            case HexMapFormat::SECTION_TERRAIN:
+                // Reject unknown terrain once here so readers can index by terrain freely
+                for (size_t tile = 0; tile < tileCount; ++tile) {
+                    if (start[tile] >= TERRAIN_TYPE_COUNT) {
+                        return fail("Hex map has an unknown terrain type");
+                    }
+                }
+                terrain_ = reinterpret_cast<const TerrainType*>(start);
+                break;
+            case HexMapFormat::SECTION_HEIGHT:
+                heights_ = reinterpret_cast<const int8_t*>(start);
+                break;
+            case HexMapFormat::SECTION_FLAGS:
+                flags_ = start;
+                break;
+            case HexMapFormat::SECTION_MOVEMENT_COST:
+                movementCosts_ = start;
+                break;
+            case HexMapFormat::SECTION_TILE_DETAILS:
+                details_ = start;
+                detailsSize_ = static_cast<size_t>(section.size);
+                break;
+            default:
+                break;  // Sections from newer writers are skipped
+        }
+    }
+
+    if (tileCount > 0 && (!terrain_ || !heights_ || !flags_ || !movementCosts_)) {
+        return fail("Hex map is missing a tile array section");
+    }
+    return true;
+}
+
+void HexMapView::close() {
+#ifndef _WIN32
+    if (mapped_) {
+        munmap(const_cast<uint8_t*>(data_), size_);
+    }
+#endif
+    mapped_ = false;
+    data_ = nullptr;
+    size_ = 0;
+    buffer_.clear();
+    buffer_.shrink_to_fit();
+
+    width_ = 0;
+    height_ = 0;
+    terrain_ = nullptr;
+    heights_ = nullptr;
+    flags_ = nullptr;
+    movementCosts_ = nullptr;
+    details_ = nullptr;
+    detailsSize_ = 0;
+}
+
+bool HexMapView::readTileDetails(std::vector<HexMapTileDetails>& details) const {
+    details.clear();
+    if (!details_) return true;
+
+    DetailsDecoder in(details_, detailsSize_);
+    uint32_t count;
+    if (!in.get(count)) return false;
+
+    for (uint32_t i = 0; i < count; ++i) {
+        HexMapTileDetails entry;
+        TileProperties& props = entry.properties;
+        int32_t index, movementCost, defensiveBonus, evasionBonus, rangedAccuracyPenalty;
+        uint32_t eventCount;
+
+        if (!in.get(index) || !in.getBool(props.passable) || !in.getBool(props.buildable) ||
+            !in.getBool(props.hidden) || !in.getBool(props.supplyPoint) || !in.getBool(props.destructible) ||
+            !in.get(movementCost) || !in.get(defensiveBonus) || !in.get(evasionBonus) ||
+            !in.get(rangedAccuracyPenalty) || !in.getString(props.specialTag) ||
+            !in.getString(entry.occupantId) || !in.get(eventCount)) {
+            return false;
+        }
+        if (index < 0 || index >= getTileCount()) return false;
+        entry.index = index;
+        props.movementCost = movementCost;
+        props.defensiveBonus = defensiveBonus;
+        props.evasionBonus = evasionBonus;
+        props.rangedAccuracyPenalty = rangedAccuracyPenalty;
+
+        for (uint32_t e = 0; e < eventCount; ++e) {
+            TileEvent event;
+            int32_t turnDelay;
+            uint32_t parameterCount;
+            if (!in.getString(event.eventId) || !in.getString(event.triggerCondition) ||
+                !in.getString(event.action) || !in.get(turnDelay) || !in.getBool(event.triggered) ||
+                !in.get(parameterCount)) {
+                return false;
+            }
+            event.turnDelay = turnDelay;
+            for (uint32_t p = 0; p < parameterCount; ++p) {
+                std::string key, value;
+                if (!in.getString(key) || !in.getString(value)) return false;
+                event.parameters[key] = value;
+            }
+            entry.events.push_back(std::move(event));
+        }
+        details.push_back(std::move(entry));
+    }
+    return true;
+}
+
+bool HexMapWriter::write(const std::string& filename, int width, int height,
+                         const TerrainType* terrain, const int8_t* heights,
+                         const uint8_t* flags, const uint8_t* movementCosts,
+                         const std::vector<HexMapTileDetails>& details,
+                         std::string* error) {
+    auto fillRow = [&](HexMapFormat::SectionType section, int row, uint8_t* out) {
+        size_t offset = static_cast<size_t>(row) * width;
+        switch (section) {
+            case HexMapFormat::SECTION_TERRAIN: std::memcpy(out, terrain + offset, width); break;
+            case HexMapFormat::SECTION_HEIGHT: std::memcpy(out, heights + offset, width); break;
+            case HexMapFormat::SECTION_FLAGS: std::memcpy(out, flags + offset, width); break;
+            case HexMapFormat::SECTION_MOVEMENT_COST: std::memcpy(out, movementCosts + offset, width); break;
+            default: break;
+        }
+    };
+    return write(filename, width, height, fillRow, details, error);
+}
+
+bool HexMapWriter::write(const std::string& filename, int width, int height, const RowSource& fillRow,
+                         const std::vector<HexMapTileDetails>& details, std::string* error) {
+    std::vector<uint8_t> detailBytes;
+    DetailsEncoder out(detailBytes);
+    out.put<uint32_t>(static_cast<uint32_t>(details.size()));
+    for (const HexMapTileDetails& entry : details) {
+        const TileProperties& props = entry.properties;
+        out.put<int32_t>(entry.index);
+        out.put<uint8_t>(props.passable);
+        out.put<uint8_t>(props.buildable);
+        out.put<uint8_t>(props.hidden);
+        out.put<uint8_t>(props.supplyPoint);
+        out.put<uint8_t>(props.destructible);
+        out.put<int32_t>(props.movementCost);
+        out.put<int32_t>(props.defensiveBonus);
+        out.put<int32_t>(props.evasionBonus);
+        out.put<int32_t>(props.rangedAccuracyPenalty);
+        out.putString(props.specialTag);
+        out.putString(entry.occupantId);
+        out.put<uint32_t>(static_cast<uint32_t>(entry.events.size()));
+        for (const TileEvent& event : entry.events) {
+            out.putString(event.eventId);
+            out.putString(event.triggerCondition);
+            out.putString(event.action);
+            out.put<int32_t>(event.turnDelay);
+            out.put<uint8_t>(event.triggered);
+            out.put<uint32_t>(static_cast<uint32_t>(event.parameters.size()));
+            for (const auto& parameter : event.parameters) {
+                out.putString(parameter.first);
+                out.putString(parameter.second);
+            }
+        }
+    }
+
+    // Array sections are produced a row at a time; the side table is written as encoded
+    size_t tileCount = static_cast<size_t>(width) * height;
+    const HexMapFormat::SectionType types[] = {
+        HexMapFormat::SECTION_TERRAIN, HexMapFormat::SECTION_HEIGHT, HexMapFormat::SECTION_FLAGS,
+        HexMapFormat::SECTION_MOVEMENT_COST, HexMapFormat::SECTION_TILE_DETAILS
+    };
+    constexpr uint32_t sectionCount = sizeof(types) / sizeof(types[0]);
+
+    HexMapFormat::Section sections[sectionCount];
+    size_t offset = sizeof(HexMapFormat::Header) + sizeof(sections);
+    for (uint32_t i = 0; i < sectionCount; ++i) {
+        size_t size = types[i] == HexMapFormat::SECTION_TILE_DETAILS ? detailBytes.size() : tileCount;
+        offset = alignSection(offset);
+        sections[i] = {types[i], 0, offset, size};
+        offset += size;
+    }
+
+    HexMapFormat::Header header = {HexMapFormat::MAGIC, HexMapFormat::VERSION, HexMapFormat::BYTE_ORDER_MARK,
+                                   sectionCount, width, height, offset};
+
+    std::ofstream file(filename, std::ios::binary | std::ios::trunc);
+    if (!file.is_open()) {
+        if (error) *error = "Cannot create " + filename;
+        return false;
+    }
+    file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    file.write(reinterpret_cast<const char*>(sections), sizeof(sections));
+
+    static const char padding[HexMapFormat::SECTION_ALIGNMENT] = {};
+    std::vector<uint8_t> row(static_cast<size_t>(width));
+    size_t written = sizeof(header) + sizeof(sections);
+    for (uint32_t i = 0; i < sectionCount; ++i) {
+        file.write(padding, sections[i].offset - written);
+        if (types[i] == HexMapFormat::SECTION_TILE_DETAILS) {
+            file.write(reinterpret_cast<const char*>(detailBytes.data()), detailBytes.size());
+        } else {
+            for (int y = 0; y < height; ++y) {
+                fillRow(types[i], y, row.data());
+                file.write(reinterpret_cast<const char*>(row.data()), row.size());
+            }
+        }
+        written = sections[i].offset + sections[i].size;
+    }
+
+    if (!file) {
+        if (error) *error = "Cannot write " + filename;
+        return false;
+    }
+    return true;
+}
@@ -0,0 +1,456 @@
+#include "Interface/ui/HexGrid.h"
+#include <nlohmann/json.hpp>
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <functional>
+#include <iostream>
+#include <new>
+#include <sstream>
+
+/**
+ * Streaming JSON serialization for HexGrid and HexTile
+ * The writers emit straight to an ostream; the readers are nlohmann/json SAX handlers
+ * that fill tiles in place, so neither side builds a per-tile string or a document tree.
+ */
+
+namespace {
+
+// Largest width * height a JSON map may declare (4096 x 4096). The tiles are allocated as soon as
+// the dimensions are read, so this bounds what a corrupt file can make the reader allocate;
+// larger maps belong in .hexmap files, streamed through HexWorld.
+constexpr int64_t MAX_JSON_TILE_COUNT = int64_t(1) << 24;
+
+void writeString(std::ostream& out, const std::string& value) {
+    out << '"';
+    for (char c : value) {
+        switch (c) {
+            case '"': out << "\\\""; break;
+            case '\\': out << "\\\\"; break;
+            case '\b': out << "\\b"; break;
+            case '\f': out << "\\f"; break;
+            case '\n': out << "\\n"; break;
+            case '\r': out << "\\r"; break;
+            case '\t': out << "\\t"; break;
+            default:
+                if (static_cast<unsigned char>(c) < 0x20) {
+                    char escaped[8];
+                    std::snprintf(escaped, sizeof(escaped), "\\u%04x", static_cast<unsigned char>(c));
+                    out << escaped;
+                } else {
+                    out << c;
+                }
+        }
+    }
+    out << '"';
+}
+
+const char* boolText(bool value) {
+    return value ? "true" : "false";
+}
+
+/**
+ * Fields of the tile currently being read. Tile keys may come in any order, so they
+ * are collected here and applied at the end of the object: terrain first (it resets
+ * the properties to its defaults), then the explicit overrides.
+ */
+struct TileRecord {
+    enum Field : uint32_t {
+        X = 1 << 0, Y = 1 << 1, Z = 1 << 2, PASSABLE = 1 << 3, BUILDABLE = 1 << 4, HIDDEN = 1 << 5,
+        SUPPLY = 1 << 6, DESTRUCTIBLE = 1 << 7, MOVEMENT_COST = 1 << 8, DEFENSE = 1 << 9,
+        EVASION = 1 << 10, RANGED_PENALTY = 1 << 11, TAG = 1 << 12
+    };
+
+    uint32_t present = 0;
+    int x = 0, y = 0, z = 0;
+    int terrain = 0;
+    int height = 0;
+    bool occupied = false;
+    TileProperties props;
+    std::string occupantId;
+    std::vector<TileEvent> events;
+
+    void reset() {
+        present = 0;
+        terrain = 0;
+        height = 0;
+        occupied = false;
+        props.specialTag.clear();
+        occupantId.clear();
+        events.clear();
+    }
+
+    void applyTo(HexTile& tile) const {
+        tile.setTerrainType(static_cast<TerrainType>(terrain));
+        tile.setHeight(height);
+
+        TileProperties& target = tile.getProperties();
+        if (present & PASSABLE) target.passable = props.passable;
+        if (present & BUILDABLE) target.buildable = props.buildable;
+        if (present & HIDDEN) target.hidden = props.hidden;
+        if (present & SUPPLY) target.supplyPoint = props.supplyPoint;
+        if (present & DESTRUCTIBLE) target.destructible = props.destructible;
+        if (present & MOVEMENT_COST) target.movementCost = props.movementCost;
+        if (present & DEFENSE) target.defensiveBonus = props.defensiveBonus;
+        if (present & EVASION) target.evasionBonus = props.evasionBonus;
+        if (present & RANGED_PENALTY) target.rangedAccuracyPenalty = props.rangedAccuracyPenalty;
+        if (present & TAG) target.specialTag = props.specialTag;
+
+        tile.setOccupied(occupied);
+        if (!occupantId.empty()) {
+            tile.setOccupant(occupantId);
+        }
+        for (const TileEvent& event : events) {
+            tile.addEvent(event);
+        }
+    }
+};
+
+/**
+ * SAX handler for a map document ({"width", "height", "tiles": [...]}) or, with
+ * tileDocument set, a single tile object. Unknown keys are skipped.
+ */
+class HexMapSaxReader : public nlohmann::json_sax<nlohmann::json> {
+public:
+    using BeginMap = std::function<bool(int width, int height, std::string& error)>; // false rejects
+    using FindTile = std::function<HexTile*(const HexCoordinate& coord)>;
+
+    HexMapSaxReader(bool tileDocument, BeginMap beginMap, FindTile findTile)
+        : tileDocument_(tileDocument), beginMap_(std::move(beginMap)), findTile_(std::move(findTile)) {}
+
+    const std::string& getError() const { return error_; }
+
+    bool null() override { return true; }
+    bool boolean(bool value) override { return onValue(value ? 1 : 0, value, nullptr); }
+    bool number_integer(number_integer_t value) override { return onValue(value, value != 0, nullptr); }
+    bool number_unsigned(number_unsigned_t value) override {
+        return onValue(static_cast<int64_t>(std::min<number_unsigned_t>(value, INT32_MAX)), value != 0, nullptr);
+    }
+    bool number_float(number_float_t value, const string_t& text) override {
+        // Clamped before the conversion, which is undefined for doubles outside int64_t
+        if (!std::isfinite(value)) return fail("Number " + text + " is out of range");
+        value = std::max<number_float_t>(INT32_MIN, std::min<number_float_t>(INT32_MAX, value));
+        return onValue(static_cast<int64_t>(value), value != 0, nullptr);
+    }
+    bool string(string_t& value) override { return onValue(0, false, &value); }
+    bool binary(binary_t&) override { return true; }
+
+    bool key(string_t& value) override {
+        key_ = value;
+        return true;
+    }
+
+    bool start_object(std::size_t) override {
+        Context context = Context::Skip;
+        if (stack_.empty()) {
+            context = tileDocument_ ? Context::Tile : Context::Map;
+        } else if (stack_.back() == Context::Tiles) {
+            context = Context::Tile;
+        } else if (stack_.back() == Context::Events) {
+            context = Context::Event;
+            event_ = TileEvent();
+        } else if (stack_.back() == Context::Event && key_ == "parameters") {
+            context = Context::Parameters;
+        }
+
+        if (context == Context::Tile) {
+            tile_.reset();
+        }
+        stack_.push_back(context);
+        return true;
+    }
+
+    bool end_object() override {
+        Context context = stack_.back();
+        stack_.pop_back();
+
+        if (context == Context::Tile) {
+            return finishTile();
+        }
+        if (context == Context::Event) {
+            tile_.events.push_back(std::move(event_));
+        }
+        return true;
+    }
+
+    bool start_array(std::size_t) override {
+        Context context = Context::Skip;
+        if (!stack_.empty() && stack_.back() == Context::Map && key_ == "tiles") {
+            if (!mapStarted_) {
+                return fail("\"width\" and \"height\" must come before \"tiles\"");
+            }
+            context = Context::Tiles;
+        } else if (!stack_.empty() && stack_.back() == Context::Tile && key_ == "events") {
+            context = Context::Events;
+        }
+        stack_.push_back(context);
+        return true;
+    }
+
+    bool end_array() override {
+        stack_.pop_back();
+        return true;
+    }
+
+    bool parse_error(std::size_t, const std::string&, const nlohmann::detail::exception& ex) override {
+        return fail(ex.what());
+    }
+
+private:
+    enum class Context { Map, Tiles, Tile, Events, Event, Parameters, Skip };
+
+    bool tileDocument_;
+    BeginMap beginMap_;
+    FindTile findTile_;
+    std::vector<Context> stack_;
+    std::string key_;
+    std::string error_;
+
+    int width_ = 0;
+    int height_ = 0;
+    bool hasWidth_ = false;
+    bool hasHeight_ = false;
+    bool mapStarted_ = false;
+    TileRecord tile_;
+    TileEvent event_;
+
+    bool fail(const std::string& message) {
+        if (error_.empty()) error_ = message;
+        return false;
+    }
+
+    bool onValue(int64_t number, bool flag, std::string* text) {
+        if (stack_.empty()) return true;
+
+        int value = static_cast<int>(std::max<int64_t>(INT32_MIN, std::min<int64_t>(INT32_MAX, number)));
+        switch (stack_.back()) {
+            case Context::Map:
+                if (key_ == "width") {
+                    width_ = value;
+                    hasWidth_ = true;
+                } else if (key_ == "height") {
+                    height_ = value;
+                    hasHeight_ = true;
+                }
+                if (!mapStarted_ && hasWidth_ && hasHeight_) {
+                    mapStarted_ = true;
+                    std::string message;
+                    if (!beginMap_(width_, height_, message)) return fail(message);
+                }
+                break;
+            case Context::Tile:
+                setTileField(value, flag, text);
+                break;
+            case Context::Event:
+                if (key_ == "id" && text) event_.eventId = *text;
+                else if (key_ == "trigger" && text) event_.triggerCondition = *text;
+                else if (key_ == "action" && text) event_.action = *text;
+                else if (key_ == "triggered") event_.triggered = flag;
+                else if (key_ == "turnDelay") event_.turnDelay = value;
+                break;
+            case Context::Parameters:
+                if (text) event_.parameters[key_] = *text;
+                break;
+            default:
+                break;
+        }
+        return true;
+    }
+
+    void setTileField(int value, bool flag, std::string* text) {
+        TileRecord& tile = tile_;
+        TileProperties& props = tile.props;
+        if (key_ == "x") { tile.x = value; tile.present |= TileRecord::X; }
+        else if (key_ == "y") { tile.y = value; tile.present |= TileRecord::Y; }
+        else if (key_ == "z") { tile.z = value; tile.present |= TileRecord::Z; }
+        else if (key_ == "terrain") tile.terrain = value;
+        else if (key_ == "height") tile.height = value;
+        else if (key_ == "passable") { props.passable = flag; tile.present |= TileRecord::PASSABLE; }
+        else if (key_ == "buildable") { props.buildable = flag; tile.present |= TileRecord::BUILDABLE; }
+        else if (key_ == "hidden") { props.hidden = flag; tile.present |= TileRecord::HIDDEN; }
+        else if (key_ == "supplyPoint") { props.supplyPoint = flag; tile.present |= TileRecord::SUPPLY; }
+        else if (key_ == "destructible") { props.destructible = flag; tile.present |= TileRecord::DESTRUCTIBLE; }
+        else if (key_ == "movementCost") { props.movementCost = value; tile.present |= TileRecord::MOVEMENT_COST; }
+        else if (key_ == "defensiveBonus") { props.defensiveBonus = value; tile.present |= TileRecord::DEFENSE; }
+        else if (key_ == "evasionBonus") { props.evasionBonus = value; tile.present |= TileRecord::EVASION; }
+        else if (key_ == "rangedAccuracyPenalty") {
+            props.rangedAccuracyPenalty = value;
+            tile.present |= TileRecord::RANGED_PENALTY;
+        }
+        else if (key_ == "specialTag" && text) { props.specialTag = *text; tile.present |= TileRecord::TAG; }
+        else if (key_ == "occupied") tile.occupied = flag;
+        else if (key_ == "occupantId" && text) tile.occupantId = *text;
+    }
+
+    bool finishTile() {
+        constexpr uint32_t coordinates = TileRecord::X | TileRecord::Y | TileRecord::Z;
+        if ((tile_.present & coordinates) != coordinates) {
+            return fail("Tile is missing its x, y or z coordinate");
+        }
+        if (tile_.terrain < 0 || tile_.terrain >= TERRAIN_TYPE_COUNT) {
+            return fail("Tile has unknown terrain type " + std::to_string(tile_.terrain));
+        }
+
+        // Tiles outside the grid are ignored, like HexGrid::setTile
+        if (HexTile* tile = findTile_(HexCoordinate(tile_.x, tile_.y, tile_.z))) {
+            tile_.applyTo(*tile);
+        }
+        return true;
+    }
+};
+
+template<typename Input>
+bool parseHexMap(Input&& input, HexMapSaxReader& reader) {
+    return nlohmann::json::sax_parse(std::forward<Input>(input), &reader);
+}
+
+} // namespace
+
+void HexTile::writeJSON(std::ostream& out) const {
+    out << "{\"x\":" << coordinate_.x
+        << ",\"y\":" << coordinate_.y
+        << ",\"z\":" << coordinate_.z
+        << ",\"terrain\":" << static_cast<int>(terrainType_)
+        << ",\"height\":" << height_
+        << ",\"passable\":" << boolText(properties_.passable)
+        << ",\"buildable\":" << boolText(properties_.buildable)
+        << ",\"hidden\":" << boolText(properties_.hidden)
+        << ",\"supplyPoint\":" << boolText(properties_.supplyPoint)
+        << ",\"destructible\":" << boolText(properties_.destructible)
+        << ",\"movementCost\":" << properties_.movementCost
+        << ",\"defensiveBonus\":" << properties_.defensiveBonus
+        << ",\"evasionBonus\":" << properties_.evasionBonus
+        << ",\"rangedAccuracyPenalty\":" << properties_.rangedAccuracyPenalty
+        << ",\"specialTag\":";
+    writeString(out, properties_.specialTag);
+
+    // Unit state and events are only written when present
+    if (occupied_) {
+        out << ",\"occupied\":true";
+    }
+    if (!occupantId_.empty()) {
+        out << ",\"occupantId\":";
+        writeString(out, occupantId_);
+    }
+    if (!events_.empty()) {
+        out << ",\"events\":[";
+        for (size_t i = 0; i < events_.size(); ++i) {
+            const TileEvent& event = events_[i];
+            if (i > 0) out << ',';
+            out << "{\"id\":";
+            writeString(out, event.eventId);
+            out << ",\"trigger\":";
+            writeString(out, event.triggerCondition);
+            out << ",\"action\":";
+            writeString(out, event.action);
+            out << ",\"triggered\":" << boolText(event.triggered)
+                << ",\"turnDelay\":" << event.turnDelay
+                << ",\"parameters\":{";
+            bool first = true;
+            for (const auto& parameter : event.parameters) {
+                if (!first) out << ',';
+                writeString(out, parameter.first);
+                out << ':';
+                writeString(out, parameter.second);
+                first = false;
+            }
+            out << "}}";
+        }
+        out << ']';
+    }
+    out << '}';
+}
+
+std::string HexTile::toJSON() const {
+    std::ostringstream out;
+    writeJSON(out);
+    return out.str();
+}
+
+HexTile HexTile::fromJSON(const std::string& json) {
+    HexTile tile(HexCoordinate(0, 0, 0));
+    HexMapSaxReader reader(true, nullptr, [&tile](const HexCoordinate& coord) {
+        tile.coordinate_ = coord;
+        return &tile;
+    });
+    if (!parseHexMap(json, reader)) {
+        std::cerr << "Failed to parse hex tile: " << reader.getError() << std::endl;
+    }
+    return tile;
+}
+
+void HexGrid::writeJSON(std::ostream& out) const {
+    out << "{\"width\":" << width_ << ",\"height\":" << height_ << ",\"tiles\":[";
+    for (int index = 0; index < getTileCount(); ++index) {
+        if (index > 0) out << ',';
+        tiles_[index].writeJSON(out);
+    }
+    out << "]}";
+}
+
+std::string HexGrid::toJSON() const {
+    std::ostringstream out;
+    writeJSON(out);
+    return out.str();
+}
+
+template<typename Input>
+bool HexGrid::parseJSON(Input&& input, std::string* error) {
+    // Tiles are read into a separate buffer so a failed load leaves the grid unchanged
+    int width = 0;
+    int height = 0;
+    std::vector<HexTile> tiles;
+    bool started = false;
+    HexMapSaxReader reader(false,
+        [&](int mapWidth, int mapHeight, std::string& message) {
+            if (mapWidth <= 0 || mapHeight <= 0 ||
+                static_cast<int64_t>(mapWidth) * mapHeight > MAX_JSON_TILE_COUNT) {
+                message = "Map has invalid dimensions " + std::to_string(mapWidth) + "x" + std::to_string(mapHeight) +
+                          " (JSON maps hold 1 to " + std::to_string(MAX_JSON_TILE_COUNT) + " tiles)";
+                return false;
+            }
+            try {
+                tiles = makeTiles(mapWidth, mapHeight);
+            } catch (const std::bad_alloc&) {
+                message = "Map is too large to load";
+                return false;
+            }
+            width = mapWidth;
+            height = mapHeight;
+            started = true;
+            return true;
+        },
+        [&](const HexCoordinate& coord) -> HexTile* {
+            int index = tileIndexIn(coord, width, height);
+            return index >= 0 ? &tiles[index] : nullptr;
+        });
+
+    bool parsed = parseHexMap(std::forward<Input>(input), reader);
+    if (parsed && !started) {
+        if (error) *error = "Map has no width and height";
+        return false;
+    }
+    if (!parsed) {
+        if (error) *error = reader.getError();
+        return false;
+    }
+
+    width_ = width;
+    height_ = height;
+    tiles_ = std::move(tiles);
+    buildNeighbors();
+    syncAllTiles();
+    return true;
+}
+
+bool HexGrid::readJSON(std::istream& in, std::string* error) {
+    return parseJSON(in, error);
+}
+
+void HexGrid::fromJSON(const std::string& json) {
+    std::string error;
+    if (!parseJSON(json, &error)) {
+        std::cerr << "Failed to load hex map: " << error << std::endl;
+    }
+}
@@ -0,0 +1,215 @@
+#include "Interface/ui/HexOverviewLayer.h"
+#include "UIConstants.h"
+#include <algorithm>
+#include <cmath>
+
+namespace {
+// Chunks stay aligned to whole texels down to the level where a chunk is one texel wide
+int maxLevelCount() {
+    int count = 1;
+    for (int size = UIConstants::HEX_LAYER_CHUNK_SIZE; size > 1; size >>= 1) {
+        ++count;
+    }
+    return count;
+}
+}
+
+HexOverviewLayer::~HexOverviewLayer() {
+    releaseTextures();
+}
+
+void HexOverviewLayer::resize(int columns, int rows) {
+    releaseTextures();
+    levels_.clear();
+    chunks_.clear();
+    chunksX_ = chunksY_ = 0;
+    mipmapsDirty_ = true;
+
+    if (columns <= 0 || rows <= 0) return;
+
+    int width = columns * 2 + 1;   // Odd rows reach one texel further right
+    int height = rows;
+    int levelLimit = maxLevelCount();
+    while (static_cast<int>(levels_.size()) < levelLimit) {
+        Level level;
+        level.width = width;
+        level.height = height;
+        level.pixels.assign(static_cast<size_t>(width) * height * 4, 0);
+        levels_.push_back(std::move(level));
+
+        if (width == 1 && height == 1) break;
+        width = std::max(1, (width + 1) / 2);
+        height = std::max(1, (height + 1) / 2);
+    }
+
+    const int chunkSize = UIConstants::HEX_LAYER_CHUNK_SIZE;
+    chunksX_ = (levels_[0].width + chunkSize - 1) / chunkSize;
+    chunksY_ = (levels_[0].height + chunkSize - 1) / chunkSize;
+    chunks_.resize(static_cast<size_t>(chunksX_) * chunksY_);
+}
+
+void HexOverviewLayer::setTileColor(int col, int row, const SDL_Color& color) {
+    if (levels_.empty()) return;
+
+    Level& base = levels_[0];
+    const int chunkSize = UIConstants::HEX_LAYER_CHUNK_SIZE;
+    int firstX = col * 2 + (row & 1);
+
+    for (int x = firstX; x < firstX + 2 && x < base.width; ++x) {
+        uint8_t* texel = &base.pixels[(static_cast<size_t>(row) * base.width + x) * 4];
+        texel[0] = color.r;
+        texel[1] = color.g;
+        texel[2] = color.b;
+        texel[3] = color.a;
+
+        chunks_[(row / chunkSize) * chunksX_ + x / chunkSize].staleLevels = ~0u;
+
+        // After the first full build, keep the chain current one parent texel per level
+        if (!mipmapsDirty_) {
+            for (int level = 1, parentX = x >> 1, parentY = row >> 1; level < getLevelCount();
+                 ++level, parentX >>= 1, parentY >>= 1) {
+                downsampleTexel(level, parentX, parentY);
+            }
+        }
+    }
+}
+
+void HexOverviewLayer::updateMipmaps() {
+    if (!mipmapsDirty_) return;
+
+    for (int level = 1; level < getLevelCount(); ++level) {
+        for (int y = 0; y < levels_[level].height; ++y) {
+            for (int x = 0; x < levels_[level].width; ++x) {
+                downsampleTexel(level, x, y);
+            }
+        }
+    }
+
+    for (Chunk& chunk : chunks_) {
+        chunk.staleLevels = ~0u;
+    }
+    mipmapsDirty_ = false;
+}
+
+void HexOverviewLayer::downsampleTexel(int level, int x, int y) {
+    const Level& source = levels_[level - 1];
+    Level& target = levels_[level];
+
+    // Alpha-weighted average so transparent edge texels do not darken the border
+    int sum[3] = {0, 0, 0};
+    int alphaSum = 0;
+    int samples = 0;
+    for (int sy = y * 2; sy < std::min(y * 2 + 2, source.height); ++sy) {
+        for (int sx = x * 2; sx < std::min(x * 2 + 2, source.width); ++sx) {
+            const uint8_t* texel = &source.pixels[(static_cast<size_t>(sy) * source.width + sx) * 4];
+            for (int channel = 0; channel < 3; ++channel) {
+                sum[channel] += texel[channel] * texel[3];
+            }
+            alphaSum += texel[3];
+            ++samples;
+        }
+    }
+
+    uint8_t* texel = &target.pixels[(static_cast<size_t>(y) * target.width + x) * 4];
+    for (int channel = 0; channel < 3; ++channel) {
+        texel[channel] = alphaSum > 0 ? static_cast<uint8_t>(sum[channel] / alphaSum) : 0;
+    }
+    texel[3] = samples > 0 ? static_cast<uint8_t>(alphaSum / samples) : 0;
+}
+
+SDL_Color HexOverviewLayer::getTexel(int level, int x, int y) const {
+    const Level& source = levels_[level];
+    const uint8_t* texel = &source.pixels[(static_cast<size_t>(y) * source.width + x) * 4];
+    return {texel[0], texel[1], texel[2], texel[3]};
+}
+
+int HexOverviewLayer::chooseLevel(float texelSize) const {
+    int level = 0;
+    while (texelSize < 0.5f && level + 1 < getLevelCount()) {
+        texelSize *= 2.0f;
+        ++level;
+    }
+    return level;
+}
+
+void HexOverviewLayer::render(SDL_Renderer* renderer, float originX, float originY,
+                              float texelWidth, float texelHeight, int viewWidth, int viewHeight) {
+    if (levels_.empty() || texelWidth <= 0.0f || texelHeight <= 0.0f) return;
+
+    updateMipmaps();
+
+    const int chunkSize = UIConstants::HEX_LAYER_CHUNK_SIZE;
+    const int level = chooseLevel(std::min(texelWidth, texelHeight));
+    const float chunkWidth = chunkSize * texelWidth;
+    const float chunkHeight = chunkSize * texelHeight;
+
+    // Chunks overlapping the view
+    int firstX = std::max(0, static_cast<int>(std::floor(-originX / chunkWidth)));
+    int lastX = std::min(chunksX_ - 1, static_cast<int>(std::floor((viewWidth - originX) / chunkWidth)));
+    int firstY = std::max(0, static_cast<int>(std::floor(-originY / chunkHeight)));
+    int lastY = std::min(chunksY_ - 1, static_cast<int>(std::floor((viewHeight - originY) / chunkHeight)));
+
+    for (int chunkY = firstY; chunkY <= lastY; ++chunkY) {
+        for (int chunkX = firstX; chunkX <= lastX; ++chunkX) {
+            Chunk& chunk = chunks_[chunkY * chunksX_ + chunkX];
+            if (chunk.textures.size() <= static_cast<size_t>(level)) {
+                chunk.textures.resize(level + 1, nullptr);
+            }
+            if (!chunk.textures[level] || (chunk.staleLevels >> level) & 1) {
+                uploadChunk(renderer, chunkX, chunkY, level);
+            }
+            if (!chunk.textures[level]) continue;
+
+            // Level texels cover 2^level base texels; round both edges so neighbors share them
+            const Level& source = levels_[level];
+            int texelX = (chunkX * chunkSize) >> level;
+            int texelY = (chunkY * chunkSize) >> level;
+            int texelsWide = std::min(chunkSize >> level, source.width - texelX);
+            int texelsHigh = std::min(chunkSize >> level, source.height - texelY);
+
+            int left = static_cast<int>(std::lround(originX + (texelX << level) * texelWidth));
+            int top = static_cast<int>(std::lround(originY + (texelY << level) * texelHeight));
+            int right = static_cast<int>(std::lround(originX + ((texelX + texelsWide) << level) * texelWidth));
+            int bottom = static_cast<int>(std::lround(originY + ((texelY + texelsHigh) << level) * texelHeight));
+
+            SDL_Rect dst = {left, top, right - left, bottom - top};
+            SDL_RenderCopy(renderer, chunk.textures[level], nullptr, &dst);
+        }
+    }
+}
+
+void HexOverviewLayer::uploadChunk(SDL_Renderer* renderer, int chunkX, int chunkY, int level) {
+    const int chunkSize = UIConstants::HEX_LAYER_CHUNK_SIZE;
+    const Level& source = levels_[level];
+    Chunk& chunk = chunks_[chunkY * chunksX_ + chunkX];
+
+    int texelX = (chunkX * chunkSize) >> level;
+    int texelY = (chunkY * chunkSize) >> level;
+    int texelsWide = std::min(chunkSize >> level, source.width - texelX);
+    int texelsHigh = std::min(chunkSize >> level, source.height - texelY);
+
+    SDL_Texture*& texture = chunk.textures[level];
+    if (!texture) {
+        texture = SDL_CreateTexture(renderer, SDL_PIXELFORMAT_RGBA32, SDL_TEXTUREACCESS_STATIC,
+                                    texelsWide, texelsHigh);
+        if (!texture) return;
+        SDL_SetTextureBlendMode(texture, SDL_BLENDMODE_BLEND);
+    }
+
+    // Upload straight from the level image; the pitch skips the rest of each row
+    const uint8_t* pixels = &source.pixels[(static_cast<size_t>(texelY) * source.width + texelX) * 4];
+    SDL_UpdateTexture(texture, nullptr, pixels, source.width * 4);
+    chunk.staleLevels &= ~(1u << level);
+}
+
+void HexOverviewLayer::releaseTextures() {
+    for (Chunk& chunk : chunks_) {
+        for (SDL_Texture* texture : chunk.textures) {
+            if (texture) {
+                SDL_DestroyTexture(texture);
+            }
+        }
+        chunk.textures.clear();
+        chunk.staleLevels = ~0u;
+    }
+}
@@ -0,0 +1,466 @@
+#include "Interface/ui/HexPathHierarchy.h"
+#include <algorithm>
+#include <climits>
+#include <numeric>
+
+namespace {
+
+constexpr int UNREACHABLE = INT_MAX;
+constexpr int LONG_ENTRANCE_RUN = 6;    // Runs at least this long get an entrance at each end
+
+int findRoot(std::vector<int>& parents, int item) {
+    while (parents[item] != item) {
+        item = parents[item] = parents[parents[item]];
+    }
+    return item;
+}
+
+} // namespace
+
+HexPathHierarchy::HexPathHierarchy(HexGrid& grid, int clusterSize)
+    : grid_(grid), clusterSize_(std::max(2, clusterSize)) {
+    cursorId_ = grid_.openChangeCursor();
+    rebuildAll();
+}
+
+HexPathHierarchy::~HexPathHierarchy() {
+    grid_.closeChangeCursor(cursorId_);
+}
+
+int HexPathHierarchy::getEntranceCount() const {
+    int count = 0;
+    for (const Cluster& cluster : clusters_) {
+        count += static_cast<int>(cluster.entrances.size());
+    }
+    return count;
+}
+
+template<typename Fn>
+void HexPathHierarchy::forEachAdjacentCluster(int clusterId, Fn&& fn) const {
+    // Hex neighbors are at most one row and column away, so only the 8 surrounding clusters touch
+    int clusterX = clusterId % clustersX_;
+    int clusterY = clusterId / clustersX_;
+    for (int y = std::max(0, clusterY - 1); y <= std::min(clustersY_ - 1, clusterY + 1); ++y) {
+        for (int x = std::max(0, clusterX - 1); x <= std::min(clustersX_ - 1, clusterX + 1); ++x) {
+            if (x != clusterX || y != clusterY) {
+                fn(y * clustersX_ + x);
+            }
+        }
+    }
+}
+
+void HexPathHierarchy::rebuildAll() {
+    width_ = grid_.getWidth();
+    height_ = grid_.getHeight();
+    clustersX_ = (width_ + clusterSize_ - 1) / clusterSize_;
+    clustersY_ = (height_ + clusterSize_ - 1) / clusterSize_;
+
+    clusters_.assign(clustersX_ * clustersY_, Cluster());
+    for (int clusterId = 0; clusterId < getClusterCount(); ++clusterId) {
+        Cluster& cluster = clusters_[clusterId];
+        cluster.minCol = (clusterId % clustersX_) * clusterSize_;
+        cluster.minRow = (clusterId / clustersX_) * clusterSize_;
+        cluster.maxCol = std::min(width_, cluster.minCol + clusterSize_) - 1;
+        cluster.maxRow = std::min(height_, cluster.minRow + clusterSize_) - 1;
+    }
+    entranceSlot_.assign(grid_.getTileCount(), -1);
+    dirtyClusters_.assign(clusters_.size(), 0);
+
+    borders_.clear();
+    for (int clusterId = 0; clusterId < getClusterCount(); ++clusterId) {
+        forEachAdjacentCluster(clusterId, [&](int other) {
+            if (other > clusterId) buildBorder(clusterId, other);
+        });
+    }
+    for (int clusterId = 0; clusterId < getClusterCount(); ++clusterId) {
+        buildCluster(clusterId);
+    }
+}
+
+void HexPathHierarchy::update() {
+    if (!grid_.drainChanges(cursorId_, changes_) || grid_.getWidth() != width_ || grid_.getHeight() != height_) {
+        rebuildAll();
+        return;
+    }
+
+    // A changed tile can move entrances on any border it touches and step costs into it
+    // from the neighboring clusters
+    const uint8_t relevant = HexGrid::CHANGE_TERRAIN | HexGrid::CHANGE_HEIGHT | HexGrid::CHANGE_FLAGS |
+                             HexGrid::CHANGE_MOVEMENT_COST;
+    std::vector<int> dirty;
+    auto markDirty = [&](int clusterId) {
+        if (!dirtyClusters_[clusterId]) {
+            dirtyClusters_[clusterId] = 1;
+            dirty.push_back(clusterId);
+        }
+    };
+    for (const HexGrid::TileChangeRecord& record : changes_) {
+        if (!(record.changes & relevant)) continue;
+        markDirty(getClusterOf(record.index));
+        for (int direction = 0; direction < 6; ++direction) {
+            int neighbor = grid_.getNeighborIndex(record.index, direction);
+            if (neighbor >= 0) markDirty(getClusterOf(neighbor));
+        }
+    }
+    if (dirty.empty()) return;
+
+    // Borders of dirty clusters change, and with them the entrances of every cluster beside one
+    std::vector<int> rebuild = dirty;
+    for (int clusterId : dirty) {
+        forEachAdjacentCluster(clusterId, [&](int other) {
+            if (dirtyClusters_[other] != 1 || other > clusterId) buildBorder(clusterId, other);
+            if (dirtyClusters_[other] == 0) {
+                dirtyClusters_[other] = 2;
+                rebuild.push_back(other);
+            }
+        });
+    }
+    for (int clusterId : rebuild) {
+        buildCluster(clusterId);
+        dirtyClusters_[clusterId] = 0;
+    }
+}
+
+void HexPathHierarchy::buildBorder(int a, int b) {
+    const Cluster& lower = clusters_[std::min(a, b)];
+    int higher = std::max(a, b);
+
+    // Passable tile pairs facing each other across the border, found from the lower cluster's edge
+    std::vector<std::pair<int, int>> crossings;
+    for (int row = lower.minRow; row <= lower.maxRow; ++row) {
+        bool edgeRow = row == lower.minRow || row == lower.maxRow;
+        int step = edgeRow ? 1 : std::max(1, lower.maxCol - lower.minCol);
+        for (int col = lower.minCol; col <= lower.maxCol; col += step) {
+            int tile = row * width_ + col;
+            if (!isOpen(tile)) continue;
+            for (int direction = 0; direction < 6; ++direction) {
+                int neighbor = grid_.getNeighborIndex(tile, direction);
+                if (neighbor >= 0 && getClusterOf(neighbor) == higher && isOpen(neighbor)) {
+                    crossings.push_back({tile, neighbor});
+                }
+            }
+        }
+    }
+
+    int64_t key = getBorderKey(a, b);
+    if (crossings.empty()) {
+        borders_.erase(key);
+        return;
+    }
+    std::sort(crossings.begin(), crossings.end());
+
+    // Group crossings into runs whose tiles touch on both sides, so any crossing of a run can
+    // be swapped for the run's entrance without leaving the two clusters
+    auto touches = [this](int x, int y) {
+        if (x == y) return true;
+        for (int direction = 0; direction < 6; ++direction) {
+            if (grid_.getNeighborIndex(x, direction) == y) return true;
+        }
+        return false;
+    };
+    std::vector<int> runs(crossings.size());
+    std::iota(runs.begin(), runs.end(), 0);
+    for (size_t i = 0; i < crossings.size(); ++i) {
+        for (size_t j = i + 1; j < crossings.size(); ++j) {
+            if (touches(crossings[i].first, crossings[j].first) && touches(crossings[i].second, crossings[j].second)) {
+                runs[findRoot(runs, static_cast<int>(j))] = findRoot(runs, static_cast<int>(i));
+            }
+        }
+    }
+
+    std::vector<std::pair<int, int>>& selected = borders_[key];
+    selected.clear();
+    for (size_t i = 0; i < crossings.size(); ++i) {
+        if (findRoot(runs, static_cast<int>(i)) != static_cast<int>(i)) continue;
+
+        std::vector<size_t> members;
+        for (size_t j = 0; j < crossings.size(); ++j) {
+            if (findRoot(runs, static_cast<int>(j)) == static_cast<int>(i)) members.push_back(j);
+        }
+        if (members.size() >= LONG_ENTRANCE_RUN) {
+            selected.push_back(crossings[members.front()]);
+            selected.push_back(crossings[members.back()]);
+        } else {
+            selected.push_back(crossings[members[members.size() / 2]]);
+        }
+    }
+}
+
+void HexPathHierarchy::buildCluster(int clusterId) {
+    Cluster& cluster = clusters_[clusterId];
+    for (int tile : cluster.entrances) {
+        entranceSlot_[tile] = -1;
+    }
+    cluster.entrances.clear();
+    cluster.links.clear();
+
+    forEachAdjacentCluster(clusterId, [&](int other) {
+        auto border = borders_.find(getBorderKey(clusterId, other));
+        if (border == borders_.end()) return;
+
+        for (const auto& crossing : border->second) {
+            int inside = clusterId < other ? crossing.first : crossing.second;
+            int outside = clusterId < other ? crossing.second : crossing.first;
+            if (entranceSlot_[inside] < 0) {
+                entranceSlot_[inside] = static_cast<int>(cluster.entrances.size());
+                cluster.entrances.push_back(inside);
+                cluster.links.emplace_back();
+            }
+            cluster.links[entranceSlot_[inside]].push_back({outside, grid_.getStepCost(inside, outside)});
+        }
+    });
+
+    int count = static_cast<int>(cluster.entrances.size());
+    cluster.costs.assign(static_cast<size_t>(count) * count, UNREACHABLE);
+    for (int from = 0; from < count; ++from) {
+        searchCluster(cluster, cluster.entrances[from], false);
+        for (int to = 0; to < count; ++to) {
+            if (searchWorkspace_.isVisited(cluster.entrances[to])) {
+                cluster.costs[from * count + to] = searchWorkspace_.getCost(cluster.entrances[to]);
+            }
+        }
+    }
+    ++rebuiltClusters_;
+}
+
+void HexPathHierarchy::searchCluster(const Cluster& cluster, int source, bool reverse) {
+    searchWorkspace_.begin(grid_.getTileCount());
+    searchWorkspace_.relax(source, 0, 0, -1);
+
+    while (searchWorkspace_.hasOpenNodes()) {
+        int current = searchWorkspace_.popMin();
+        int currentCost = searchWorkspace_.getCost(current);
+
+        for (int direction = 0; direction < 6; ++direction) {
+            int neighbor = grid_.getNeighborIndex(current, direction);
+            if (neighbor < 0 || !isInCluster(neighbor, cluster) || searchWorkspace_.isClosed(neighbor) ||
+                !isOpen(neighbor)) {
+                continue;
+            }
+            int cost = currentCost + (reverse ? grid_.getStepCost(neighbor, current) : grid_.getStepCost(current, neighbor));
+            searchWorkspace_.relax(neighbor, cost, cost, current);
+        }
+    }
+}
+
+bool HexPathHierarchy::refineInCluster(const Cluster& cluster, int from, int to, std::vector<int>& tiles) {
+    const HexCoordinate& goal = grid_.getCoordinateAt(to);
+    searchWorkspace_.begin(grid_.getTileCount());
+    searchWorkspace_.relax(from, 0, 0, -1);
+
+    while (searchWorkspace_.hasOpenNodes()) {
+        int current = searchWorkspace_.popMin();
+        if (current == to) {
+            size_t first = tiles.size();
+            for (int index = to; index != from; index = searchWorkspace_.getParent(index)) {
+                tiles.push_back(index);
+            }
+            std::reverse(tiles.begin() + first, tiles.end());
+            return true;
+        }
+
+        int currentCost = searchWorkspace_.getCost(current);
+        for (int direction = 0; direction < 6; ++direction) {
+            int neighbor = grid_.getNeighborIndex(current, direction);
+            if (neighbor < 0 || !isInCluster(neighbor, cluster) || searchWorkspace_.isClosed(neighbor) ||
+                !isOpen(neighbor)) {
+                continue;
+            }
+            int cost = currentCost + grid_.getStepCost(current, neighbor);
+            searchWorkspace_.relax(neighbor, cost, cost + grid_.getCoordinateAt(neighbor).distanceTo(goal), current);
+        }
+    }
+    return false;
+}
+
+bool HexPathHierarchy::findRoute(const HexCoordinate& start, const HexCoordinate& goal, Route& route) {
+    update();
+    route.waypoints.clear();
+    route.totalCost = 0;
+    route.found = false;
+    lastExpanded_ = 0;
+
+    int startIndex = grid_.getTileIndex(start);
+    int goalIndex = grid_.getTileIndex(goal);
+    if (startIndex < 0 || goalIndex < 0) {
+        return false;
+    }
+    if (startIndex == goalIndex) {
+        route.waypoints.push_back(startIndex);
+        route.found = true;
+        return true;
+    }
+    if (!isOpen(goalIndex)) {
+        return false;
+    }
+
+    // Temporary edges: start to its cluster's entrances, the goal cluster's entrances to the goal
+    int startClusterId = getClusterOf(startIndex);
+    int goalClusterId = getClusterOf(goalIndex);
+    const Cluster& startCluster = clusters_[startClusterId];
+    const Cluster& goalCluster = clusters_[goalClusterId];
+
+    searchCluster(goalCluster, goalIndex, true);
+    goalCosts_.assign(goalCluster.entrances.size(), UNREACHABLE);
+    for (size_t slot = 0; slot < goalCluster.entrances.size(); ++slot) {
+        if (searchWorkspace_.isVisited(goalCluster.entrances[slot])) {
+            goalCosts_[slot] = searchWorkspace_.getCost(goalCluster.entrances[slot]);
+        }
+    }
+
+    searchCluster(startCluster, startIndex, false);
+    startCosts_.assign(startCluster.entrances.size(), UNREACHABLE);
+    for (size_t slot = 0; slot < startCluster.entrances.size(); ++slot) {
+        if (searchWorkspace_.isVisited(startCluster.entrances[slot])) {
+            startCosts_[slot] = searchWorkspace_.getCost(startCluster.entrances[slot]);
+        }
+    }
+    int directCost = (startClusterId == goalClusterId && searchWorkspace_.isVisited(goalIndex))
+                   ? searchWorkspace_.getCost(goalIndex) : UNREACHABLE;
+
+    // A closed start is never an entrance, so link its steps into other clusters directly
+    int linkCount = 0;
+    if (!isOpen(startIndex)) {
+        for (int direction = 0; direction < 6; ++direction) {
+            int neighbor = grid_.getNeighborIndex(startIndex, direction);
+            if (neighbor < 0 || getClusterOf(neighbor) == startClusterId || !isOpen(neighbor)) continue;
+
+            if (linkCount == static_cast<int>(startLinks_.size())) startLinks_.emplace_back();
+            StartLink& link = startLinks_[linkCount++];
+            const Cluster& cluster = clusters_[getClusterOf(neighbor)];
+            link.tile = neighbor;
+            link.stepCost = grid_.getStepCost(startIndex, neighbor);
+
+            searchCluster(cluster, neighbor, false);
+            link.costs.assign(cluster.entrances.size(), UNREACHABLE);
+            for (size_t slot = 0; slot < cluster.entrances.size(); ++slot) {
+                if (searchWorkspace_.isVisited(cluster.entrances[slot])) {
+                    link.costs[slot] = searchWorkspace_.getCost(cluster.entrances[slot]);
+                }
+            }
+            link.goalCost = (getClusterOf(neighbor) == goalClusterId && searchWorkspace_.isVisited(goalIndex))
+                          ? searchWorkspace_.getCost(goalIndex) : UNREACHABLE;
+        }
+    }
+
+    // A* over the entrance graph, nodes keyed by tile index
+    PathfindingWorkspace& workspace = abstractWorkspace_;
+    workspace.begin(grid_.getTileCount());
+    workspace.relax(startIndex, 0, start.distanceTo(goal), -1);
+
+    while (workspace.hasOpenNodes()) {
+        int current = workspace.popMin();
+        ++lastExpanded_;
+
+        if (current == goalIndex) {
+            route.totalCost = workspace.getCost(current);
+            for (int index = goalIndex; index >= 0; index = workspace.getParent(index)) {
+                route.waypoints.push_back(index);
+            }
+            std::reverse(route.waypoints.begin(), route.waypoints.end());
+            route.found = true;
+            return true;
+        }
+
+        int currentCost = workspace.getCost(current);
+        auto relaxEdge = [&](int tile, int edgeCost) {
+            if (edgeCost == UNREACHABLE) return;
+            int cost = currentCost + edgeCost;
+            workspace.relax(tile, cost, cost + grid_.getCoordinateAt(tile).distanceTo(goal), current);
+        };
+
+        if (current == startIndex) {
+            for (size_t slot = 0; slot < startCluster.entrances.size(); ++slot) {
+                relaxEdge(startCluster.entrances[slot], startCosts_[slot]);
+            }
+            relaxEdge(goalIndex, directCost);
+            for (int link = 0; link < linkCount; ++link) {
+                relaxEdge(startLinks_[link].tile, startLinks_[link].stepCost);
+            }
+        }
+        for (int link = 0; link < linkCount; ++link) {
+            if (startLinks_[link].tile != current) continue;
+            const Cluster& cluster = clusters_[getClusterOf(current)];
+            for (size_t other = 0; other < cluster.entrances.size(); ++other) {
+                relaxEdge(cluster.entrances[other], startLinks_[link].costs[other]);
+            }
+            relaxEdge(goalIndex, startLinks_[link].goalCost);
+        }
+
+        int slot = entranceSlot_[current];
+        if (slot >= 0) {
+            int clusterId = getClusterOf(current);
+            const Cluster& cluster = clusters_[clusterId];
+            size_t count = cluster.entrances.size();
+            for (size_t other = 0; other < count; ++other) {
+                relaxEdge(cluster.entrances[other], cluster.costs[slot * count + other]);
+            }
+            for (const auto& link : cluster.links[slot]) {
+                relaxEdge(link.first, link.second);
+            }
+            if (clusterId == goalClusterId) {
+                relaxEdge(goalIndex, goalCosts_[slot]);
+            }
+        }
+    }
+    return false;
+}
+
+bool HexPathHierarchy::refineSegment(const Route& route, int segment, std::vector<HexCoordinate>& tiles) {
+    update();
+    if (segment < 0 || segment + 1 >= static_cast<int>(route.waypoints.size())) {
+        return false;
+    }
+    int from = route.waypoints[segment];
+    int to = route.waypoints[segment + 1];
+    if (from >= grid_.getTileCount() || to >= grid_.getTileCount()) {
+        return false;
+    }
+
+    refinedTiles_.clear();
+    if (getClusterOf(from) == getClusterOf(to)) {
+        if (!refineInCluster(clusters_[getClusterOf(from)], from, to, refinedTiles_)) return false;
+    } else {
+        // Border link between neighboring entrances
+        if (!isOpen(to)) return false;
+        refinedTiles_.push_back(to);
+    }
+
+    for (int index : refinedTiles_) {
+        tiles.push_back(grid_.getCoordinateAt(index));
+    }
+    return true;
+}
+
+bool HexPathHierarchy::findPath(const HexCoordinate& start, const HexCoordinate& goal, PathfindingResult& result) {
+    result.path.clear();
+    result.totalCost = 0;
+    result.pathFound = false;
+
+    if (!findRoute(start, goal, route_)) {
+        return false;
+    }
+    result.path.push_back(start);
+    for (int segment = 0; segment + 1 < static_cast<int>(route_.waypoints.size()); ++segment) {
+        if (!refineSegment(route_, segment, result.path)) {
+            result.path.clear();
+            return false;
+        }
+    }
+
+    // Summed from the refined tiles so the cost always matches the returned path
+    int previous = grid_.getTileIndex(result.path.front());
+    for (size_t step = 1; step < result.path.size(); ++step) {
+        int index = grid_.getTileIndex(result.path[step]);
+        result.totalCost += grid_.getStepCost(previous, index);
+        previous = index;
+    }
+    result.pathFound = true;
+    return true;
+}
+
+PathfindingResult HexPathHierarchy::findPath(const HexCoordinate& start, const HexCoordinate& goal) {
+    PathfindingResult result;
+    findPath(start, goal, result);
+    return result;
+}
@@ -1,5 +1,4 @@
 #include "Interface/ui/HexTile.h"
-#include <sstream>
 #include <algorithm>
 
 HexTile::HexTile(const HexCoordinate& coord, TerrainType terrain) 
@@ -85,24 +84,6 @@ void HexTile::destroy() {
     }
 }
 
-std::string HexTile::toJSON() const {
-    std::stringstream ss;
-    ss << "{";
-    ss << "\"x\":" << coordinate_.x << ",";
-    ss << "\"y\":" << coordinate_.y << ",";
-    ss << "\"z\":" << coordinate_.z << ",";
-    ss << "\"terrain\":" << static_cast<int>(terrainType_) << ",";
-    ss << "\"height\":" << height_ << ",";
-    ss << "\"passable\":" << (properties_.passable ? "true" : "false") << ",";
-    ss << "\"buildable\":" << (properties_.buildable ? "true" : "false") << ",";
-    ss << "\"hidden\":" << (properties_.hidden ? "true" : "false") << ",";
-    ss << "\"movementCost\":" << properties_.movementCost << ",";
-    ss << "\"defensiveBonus\":" << properties_.defensiveBonus << ",";
-    ss << "\"specialTag\":\"" << properties_.specialTag << "\"";
-    ss << "}";
-    return ss.str();
-}
-
 // Utility functions implementation
 TileProperties HexTileUtils::getDefaultProperties(TerrainType terrain) {
     TileProperties props;
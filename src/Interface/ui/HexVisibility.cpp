@@ -0,0 +1,139 @@
+#include "Interface/ui/HexVisibility.h"
+#include "Systems/WorkerPool.h"
+#include <algorithm>
+
+HexVisibilityMap::HexVisibilityMap(const HexGrid& grid) : grid_(grid) {
+    recomputeAll(nullptr);
+}
+
+void HexVisibilityMap::setObservers(const std::vector<VisibilityObserver>& observers, WorkerPool* pool) {
+    observers_.clear();
+    observerSlots_.clear();
+    observers_.reserve(observers.size());
+
+    for (const VisibilityObserver& observer : observers) {
+        observerSlots_[observer.id] = observers_.size();
+        observers_.push_back({observer, {}});
+    }
+
+    recomputeAll(pool);
+}
+
+void HexVisibilityMap::addObserver(const VisibilityObserver& observer) {
+    // Stored sweeps and counts index the old layout after a resize
+    if (layoutChanged()) {
+        recomputeAll(nullptr);
+    }
+    if (observerSlots_.count(observer.id)) {
+        removeObserver(observer.id);
+    }
+
+    observerSlots_[observer.id] = observers_.size();
+    observers_.push_back({observer, {}});
+
+    ObserverState& state = observers_.back();
+    grid_.computeFieldOfView(state.observer.position, state.observer.sightRange, state.visibleTiles);
+    addVisibility(state.visibleTiles);
+}
+
+void HexVisibilityMap::moveObserver(int id, const HexCoordinate& position) {
+    auto it = observerSlots_.find(id);
+    if (it == observerSlots_.end()) return;
+
+    ObserverState& state = observers_[it->second];
+    if (state.observer.position == position) return;
+    if (layoutChanged()) {
+        state.observer.position = position;
+        recomputeAll(nullptr);
+        return;
+    }
+
+    // Only this observer's contribution changes
+    removeVisibility(state.visibleTiles);
+    state.observer.position = position;
+    grid_.computeFieldOfView(position, state.observer.sightRange, state.visibleTiles);
+    addVisibility(state.visibleTiles);
+}
+
+void HexVisibilityMap::removeObserver(int id) {
+    auto it = observerSlots_.find(id);
+    if (it == observerSlots_.end()) return;
+
+    size_t slot = it->second;
+    bool relayout = layoutChanged();
+    if (!relayout) {
+        removeVisibility(observers_[slot].visibleTiles);
+    }
+    observerSlots_.erase(it);
+
+    // Swap-remove to keep observers_ dense
+    if (slot + 1 != observers_.size()) {
+        observers_[slot] = std::move(observers_.back());
+        observerSlots_[observers_[slot].observer.id] = slot;
+    }
+    observers_.pop_back();
+
+    if (relayout) {
+        recomputeAll(nullptr);
+    }
+}
+
+bool HexVisibilityMap::update(WorkerPool* pool) {
+    if (grid_.getLineOfSightRevision() == lineOfSightRevision_ && !layoutChanged()) {
+        return false;
+    }
+    recomputeAll(pool);
+    return true;
+}
+
+bool HexVisibilityMap::isVisible(const HexCoordinate& coord) const {
+    int index = grid_.getTileIndex(coord);
+    return index >= 0 && index < tileCount_ && isVisible(index);
+}
+
+void HexVisibilityMap::applyToGrid(HexGrid& grid) const {
+    int count = std::min(grid.getTileCount(), tileCount_);
+    for (int index = 0; index < count; ++index) {
+        grid.getTileByIndex(index)->setVisible(isVisible(index));
+    }
+}
+
+void HexVisibilityMap::recomputeAll(WorkerPool* pool) {
+    tileCount_ = grid_.getTileCount();
+    gridWidth_ = grid_.getWidth();
+    gridHeight_ = grid_.getHeight();
+    lineOfSightRevision_ = grid_.getLineOfSightRevision();
+
+    // Per-observer sweeps are independent and only read the grid
+    WorkerPool& workers = pool ? *pool : WorkerPool::shared();
+    workers.parallelFor(static_cast<int>(observers_.size()), [this](int item, int) {
+        ObserverState& state = observers_[item];
+        grid_.computeFieldOfView(state.observer.position, state.observer.sightRange, state.visibleTiles);
+    });
+
+    observerCounts_.assign(tileCount_, 0);
+    visibleBits_.assign((tileCount_ + 63) / 64, 0);
+    visibleCount_ = 0;
+
+    for (const ObserverState& state : observers_) {
+        addVisibility(state.visibleTiles);
+    }
+}
+
+void HexVisibilityMap::addVisibility(const std::vector<int>& tiles) {
+    for (int index : tiles) {
+        if (observerCounts_[index]++ == 0) {
+            visibleBits_[index >> 6] |= uint64_t(1) << (index & 63);
+            ++visibleCount_;
+        }
+    }
+}
+
+void HexVisibilityMap::removeVisibility(const std::vector<int>& tiles) {
+    for (int index : tiles) {
+        if (--observerCounts_[index] == 0) {
+            visibleBits_[index >> 6] &= ~(uint64_t(1) << (index & 63));
+            --visibleCount_;
+        }
+    }
+}
@@ -0,0 +1,456 @@
+#include "Interface/ui/HexWorld.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#endif
+
+namespace {
+
+// Replace target with source in one step, so a crash leaves either file intact. std::rename
+// does this on POSIX but fails on Windows when the target exists.
+bool replaceFile(const std::string& source, const std::string& target) {
+#ifdef _WIN32
+    return MoveFileExA(source.c_str(), target.c_str(), MOVEFILE_REPLACE_EXISTING | MOVEFILE_WRITE_THROUGH) != 0;
+#else
+    return std::rename(source.c_str(), target.c_str()) == 0;
+#endif
+}
+
+} // namespace
+
+HexWorld::HexWorld(int chunkBudget)
+    : chunkBudget_(std::max(1, chunkBudget)) {
+    worker_ = std::thread(&HexWorld::workerLoop, this);
+}
+
+HexWorld::~HexWorld() {
+    close();
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stopping_ = true;
+    }
+    wake_.notify_all();
+    worker_.join();
+}
+
+bool HexWorld::open(const std::string& filename, std::string* error) {
+    close();
+
+    if (!map_.open(filename)) {
+        if (error) *error = map_.getError();
+        return false;
+    }
+    std::vector<HexMapTileDetails> details;
+    if (!map_.readTileDetails(details)) {
+        if (error) *error = "Hex map tile details are malformed";
+        map_.close();
+        return false;
+    }
+
+    chunksX_ = (getWidth() + CHUNK_SIZE - 1) / CHUNK_SIZE;
+    chunksY_ = (getHeight() + CHUNK_SIZE - 1) / CHUNK_SIZE;
+
+    // The side table is small next to the arrays; keep it decoded, bucketed by chunk
+    for (HexMapTileDetails& entry : details) {
+        baseDetails_[getChunkIndex(entry.index % getWidth(), entry.index / getWidth())].push_back(std::move(entry));
+    }
+    return true;
+}
+
+void HexWorld::close() {
+    cancelPrefetch();
+    chunks_.clear();
+    packedChunks_.clear();
+    baseDetails_.clear();
+    lastChunkIndex_ = -1;
+    lastChunk_ = nullptr;
+    chunksX_ = chunksY_ = 0;
+    chunkLoads_ = chunksPrefetched_ = 0;
+    map_.close();
+}
+
+const HexTile* HexWorld::getTile(int col, int row) {
+    if (!isValidOffset(col, row)) return nullptr;
+
+    Chunk* chunk = acquireChunk(getChunkIndex(col, row));
+    return &chunk->tiles[(row - chunk->chunkY * CHUNK_SIZE) * chunk->cols + col - chunk->chunkX * CHUNK_SIZE];
+}
+
+const HexTile* HexWorld::getTile(const HexCoordinate& coord) {
+    int col, row;
+    coord.toOffset(col, row);
+    return getTile(col, row);
+}
+
+HexTile* HexWorld::editTile(int col, int row) {
+    if (!isValidOffset(col, row)) return nullptr;
+
+    Chunk* chunk = acquireChunk(getChunkIndex(col, row));
+    chunk->modified = true;
+    return &chunk->tiles[(row - chunk->chunkY * CHUNK_SIZE) * chunk->cols + col - chunk->chunkX * CHUNK_SIZE];
+}
+
+HexTile* HexWorld::editTile(const HexCoordinate& coord) {
+    int col, row;
+    coord.toOffset(col, row);
+    return editTile(col, row);
+}
+
+bool HexWorld::isChunkResident(int col, int row) const {
+    return isValidOffset(col, row) && chunks_.count(getChunkIndex(col, row)) > 0;
+}
+
+void HexWorld::setChunkBudget(int chunks) {
+    chunkBudget_ = std::max(1, chunks);
+    evictToBudget(-1);
+}
+
+HexWorld::Chunk* HexWorld::acquireChunk(int chunkIndex) {
+    if (chunkIndex != lastChunkIndex_) {
+        auto it = chunks_.find(chunkIndex);
+        if (it == chunks_.end()) {
+            auto packed = packedChunks_.find(chunkIndex);
+            installChunk(chunkIndex, buildChunk(chunkIndex, packed != packedChunks_.end() ? packed->second.get() : nullptr));
+            ++chunkLoads_;
+            evictToBudget(chunkIndex);
+            it = chunks_.find(chunkIndex);
+        }
+        lastChunkIndex_ = chunkIndex;
+        lastChunk_ = it->second.get();
+    }
+    lastChunk_->lastUse = ++useCounter_;
+    return lastChunk_;
+}
+
+std::unique_ptr<HexWorld::Chunk> HexWorld::buildChunk(int chunkIndex, const PackedChunk* packed) const {
+    auto chunk = std::make_unique<Chunk>();
+    chunk->chunkX = chunkIndex % chunksX_;
+    chunk->chunkY = chunkIndex / chunksX_;
+    chunk->cols = std::min(CHUNK_SIZE, getWidth() - chunk->chunkX * CHUNK_SIZE);
+    chunk->rows = std::min(CHUNK_SIZE, getHeight() - chunk->chunkY * CHUNK_SIZE);
+    chunk->tiles.reserve(static_cast<size_t>(chunk->cols) * chunk->rows);
+
+    int firstCol = chunk->chunkX * CHUNK_SIZE;
+    int firstRow = chunk->chunkY * CHUNK_SIZE;
+    for (int localRow = 0; localRow < chunk->rows; ++localRow) {
+        for (int localCol = 0; localCol < chunk->cols; ++localCol) {
+            int col = firstCol + localCol;
+            int row = firstRow + localRow;
+            HexMapFormat::PackedTile tile;
+            if (packed) {
+                tile = packed->tiles[localRow * chunk->cols + localCol];
+            } else {
+                int index = row * getWidth() + col;
+                tile = {map_.getTerrain()[index], map_.getHeights()[index],
+                        map_.getFlags()[index], map_.getMovementCosts()[index]};
+            }
+            chunk->tiles.emplace_back(HexCoordinate::fromOffset(col, row), tile.terrain);
+            HexMapFormat::unpackTile(tile, chunk->tiles.back());
+        }
+    }
+
+    const std::vector<HexMapTileDetails>* details = nullptr;
+    if (packed) {
+        details = &packed->details;
+    } else {
+        auto it = baseDetails_.find(chunkIndex);
+        if (it != baseDetails_.end()) details = &it->second;
+    }
+    if (details) {
+        for (const HexMapTileDetails& entry : *details) {
+            int localCol = entry.index % getWidth() - firstCol;
+            int localRow = entry.index / getWidth() - firstRow;
+            HexMapFormat::applyDetails(entry, chunk->tiles[localRow * chunk->cols + localCol]);
+        }
+    }
+    return chunk;
+}
+
+void HexWorld::installChunk(int chunkIndex, std::unique_ptr<Chunk> chunk) {
+    chunk->lastUse = ++useCounter_;
+    chunks_[chunkIndex] = std::move(chunk);
+}
+
+void HexWorld::evictToBudget(int keepChunk) {
+    while (static_cast<int>(chunks_.size()) > chunkBudget_) {
+        auto victim = chunks_.end();
+        for (auto it = chunks_.begin(); it != chunks_.end(); ++it) {
+            if (it->first != keepChunk && (victim == chunks_.end() || it->second->lastUse < victim->second->lastUse)) {
+                victim = it;
+            }
+        }
+        if (victim == chunks_.end()) return;
+
+        if (victim->second->modified) {
+            packChunk(victim->first, *victim->second);
+        }
+        if (victim->first == lastChunkIndex_) {
+            lastChunkIndex_ = -1;
+            lastChunk_ = nullptr;
+        }
+        chunks_.erase(victim);
+    }
+}
+
+void HexWorld::packChunk(int chunkIndex, const Chunk& chunk) {
+    auto packed = std::make_shared<PackedChunk>();
+    packed->tiles.reserve(chunk.tiles.size());
+    for (int localRow = 0; localRow < chunk.rows; ++localRow) {
+        for (int localCol = 0; localCol < chunk.cols; ++localCol) {
+            const HexTile& tile = chunk.tiles[localRow * chunk.cols + localCol];
+            packed->tiles.push_back(HexMapFormat::packTile(tile));
+            if (HexMapFormat::needsDetails(tile)) {
+                int index = (chunk.chunkY * CHUNK_SIZE + localRow) * getWidth() + chunk.chunkX * CHUNK_SIZE + localCol;
+                packed->details.push_back(HexMapFormat::makeDetails(index, tile));
+            }
+        }
+    }
+    packedChunks_[chunkIndex] = std::move(packed);
+}
+
+void HexWorld::prefetchRegion(int minCol, int minRow, int maxCol, int maxRow) {
+    if (!isOpen()) return;
+
+    minCol = std::max(0, minCol);
+    minRow = std::max(0, minRow);
+    maxCol = std::min(getWidth() - 1, maxCol);
+    maxRow = std::min(getHeight() - 1, maxRow);
+    if (minCol > maxCol || minRow > maxRow) return;
+
+    std::vector<int> chunkIndices;
+    for (int chunkY = minRow / CHUNK_SIZE; chunkY <= maxRow / CHUNK_SIZE; ++chunkY) {
+        for (int chunkX = minCol / CHUNK_SIZE; chunkX <= maxCol / CHUNK_SIZE; ++chunkX) {
+            chunkIndices.push_back(chunkY * chunksX_ + chunkX);
+        }
+    }
+    queuePrefetch(chunkIndices, (minCol + maxCol) / 2, (minRow + maxRow) / 2);
+}
+
+void HexWorld::prefetchPath(const HexCoordinate& start, const HexCoordinate& goal, int margin) {
+    if (!isOpen()) return;
+
+    int startCol, startRow, goalCol, goalRow;
+    start.toOffset(startCol, startRow);
+    goal.toOffset(goalCol, goalRow);
+    margin = std::max(0, margin);
+
+    // Sample the straight line at half-chunk steps and take every chunk within margin of a sample
+    int steps = std::max(1, std::max(std::abs(goalCol - startCol), std::abs(goalRow - startRow)) / (CHUNK_SIZE / 2));
+    std::vector<int> chunkIndices;
+    for (int step = 0; step <= steps; ++step) {
+        int col = startCol + (goalCol - startCol) * step / steps;
+        int row = startRow + (goalRow - startRow) * step / steps;
+        int minChunkX = std::max(0, (col - margin) / CHUNK_SIZE);
+        int maxChunkX = std::min(chunksX_ - 1, std::max(0, col + margin) / CHUNK_SIZE);
+        int minChunkY = std::max(0, (row - margin) / CHUNK_SIZE);
+        int maxChunkY = std::min(chunksY_ - 1, std::max(0, row + margin) / CHUNK_SIZE);
+        for (int chunkY = minChunkY; chunkY <= maxChunkY; ++chunkY) {
+            for (int chunkX = minChunkX; chunkX <= maxChunkX; ++chunkX) {
+                chunkIndices.push_back(chunkY * chunksX_ + chunkX);
+            }
+        }
+    }
+    std::sort(chunkIndices.begin(), chunkIndices.end());
+    chunkIndices.erase(std::unique(chunkIndices.begin(), chunkIndices.end()), chunkIndices.end());
+    queuePrefetch(chunkIndices, startCol, startRow);
+}
+
+void HexWorld::queuePrefetch(std::vector<int>& chunkIndices, int centerCol, int centerRow) {
+    // Nearest chunks first, and no more than fit in the budget
+    auto distance = [&](int chunkIndex) {
+        int dx = (chunkIndex % chunksX_) * CHUNK_SIZE + CHUNK_SIZE / 2 - centerCol;
+        int dy = (chunkIndex / chunksX_) * CHUNK_SIZE + CHUNK_SIZE / 2 - centerRow;
+        return dx * dx + dy * dy;
+    };
+    std::stable_sort(chunkIndices.begin(), chunkIndices.end(),
+                     [&](int a, int b) { return distance(a) < distance(b); });
+    if (static_cast<int>(chunkIndices.size()) > chunkBudget_) {
+        chunkIndices.resize(chunkBudget_);
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        for (int chunkIndex : chunkIndices) {
+            if (chunks_.count(chunkIndex) || !queuedChunks_.insert(chunkIndex).second) continue;
+
+            auto packed = packedChunks_.find(chunkIndex);
+            requests_.push_back({chunkIndex, packed != packedChunks_.end() ? packed->second : nullptr, generation_});
+        }
+    }
+    wake_.notify_one();
+}
+
+void HexWorld::update() {
+    std::vector<PrefetchResult> results;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        results.swap(results_);
+    }
+
+    for (PrefetchResult& result : results) {
+        queuedChunks_.erase(result.chunkIndex);
+
+        // Paged in synchronously meanwhile, or edited and evicted since the request was queued
+        auto packed = packedChunks_.find(result.chunkIndex);
+        const PackedChunk* current = packed != packedChunks_.end() ? packed->second.get() : nullptr;
+        if (chunks_.count(result.chunkIndex) || current != result.packed.get()) continue;
+
+        installChunk(result.chunkIndex, std::move(result.chunk));
+        ++chunksPrefetched_;
+    }
+    evictToBudget(lastChunkIndex_);
+}
+
+void HexWorld::waitForPrefetch() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    idle_.wait(lock, [this] { return requests_.empty() && !busy_; });
+}
+
+void HexWorld::cancelPrefetch() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    requests_.clear();
+    ++generation_;
+    idle_.wait(lock, [this] { return !busy_; });
+    results_.clear();
+    queuedChunks_.clear();
+}
+
+void HexWorld::workerLoop() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    while (true) {
+        wake_.wait(lock, [this] { return stopping_ || !requests_.empty(); });
+        if (stopping_) return;
+
+        PrefetchRequest request = std::move(requests_.front());
+        requests_.pop_front();
+        busy_ = true;
+
+        // The mapped file and the decoded side table do not change while the world is open
+        lock.unlock();
+        std::unique_ptr<Chunk> chunk = buildChunk(request.chunkIndex, request.packed.get());
+        lock.lock();
+
+        busy_ = false;
+        if (request.generation == generation_) {
+            results_.push_back({request.chunkIndex, std::move(request.packed), std::move(chunk)});
+        }
+        idle_.notify_all();
+    }
+}
+
+void HexWorld::extractRegion(int minCol, int minRow, int maxCol, int maxRow, HexGrid& grid,
+                             int& originCol, int& originRow) {
+    minCol = std::max(0, minCol);
+    minRow = std::max(0, minRow) & ~1;
+    maxCol = std::min(getWidth() - 1, maxCol);
+    maxRow = std::min(getHeight() - 1, maxRow);
+    originCol = minCol;
+    originRow = minRow;
+
+    grid.resize(std::max(0, maxCol - minCol + 1), std::max(0, maxRow - minRow + 1));
+    if (minCol > maxCol || minRow > maxRow) return;
+
+    // Chunk by chunk, so a region larger than the budget still pages each chunk in once
+    for (int chunkY = minRow / CHUNK_SIZE; chunkY <= maxRow / CHUNK_SIZE; ++chunkY) {
+        for (int chunkX = minCol / CHUNK_SIZE; chunkX <= maxCol / CHUNK_SIZE; ++chunkX) {
+            int rowEnd = std::min(maxRow, chunkY * CHUNK_SIZE + CHUNK_SIZE - 1);
+            int colEnd = std::min(maxCol, chunkX * CHUNK_SIZE + CHUNK_SIZE - 1);
+            for (int row = std::max(minRow, chunkY * CHUNK_SIZE); row <= rowEnd; ++row) {
+                for (int col = std::max(minCol, chunkX * CHUNK_SIZE); col <= colEnd; ++col) {
+                    grid.setTile(HexCoordinate::fromOffset(col - originCol, row - originRow), *getTile(col, row));
+                }
+            }
+        }
+    }
+}
+
+bool HexWorld::save(const std::string& filename, std::string* error) {
+    if (!isOpen()) {
+        if (error) *error = "Hex world is not open";
+        return false;
+    }
+
+    // Side table: resident chunks are scanned, evicted edits and untouched chunks have theirs already
+    std::vector<HexMapTileDetails> details;
+    for (int chunkIndex = 0; chunkIndex < chunksX_ * chunksY_; ++chunkIndex) {
+        auto resident = chunks_.find(chunkIndex);
+        auto packed = packedChunks_.find(chunkIndex);
+        if (resident != chunks_.end()) {
+            const Chunk& chunk = *resident->second;
+            for (int localRow = 0; localRow < chunk.rows; ++localRow) {
+                for (int localCol = 0; localCol < chunk.cols; ++localCol) {
+                    const HexTile& tile = chunk.tiles[localRow * chunk.cols + localCol];
+                    if (HexMapFormat::needsDetails(tile)) {
+                        int index = (chunk.chunkY * CHUNK_SIZE + localRow) * getWidth() + chunk.chunkX * CHUNK_SIZE + localCol;
+                        details.push_back(HexMapFormat::makeDetails(index, tile));
+                    }
+                }
+            }
+        } else if (packed != packedChunks_.end()) {
+            details.insert(details.end(), packed->second->details.begin(), packed->second->details.end());
+        } else {
+            auto base = baseDetails_.find(chunkIndex);
+            if (base != baseDetails_.end()) {
+                details.insert(details.end(), base->second.begin(), base->second.end());
+            }
+        }
+    }
+    std::sort(details.begin(), details.end(),
+              [](const HexMapTileDetails& a, const HexMapTileDetails& b) { return a.index < b.index; });
+
+    auto fillRow = [this](HexMapFormat::SectionType section, int row, uint8_t* out) {
+        auto field = [section](const HexMapFormat::PackedTile& tile) -> uint8_t {
+            switch (section) {
+                case HexMapFormat::SECTION_TERRAIN: return static_cast<uint8_t>(tile.terrain);
+                case HexMapFormat::SECTION_HEIGHT: return static_cast<uint8_t>(tile.height);
+                case HexMapFormat::SECTION_FLAGS: return tile.flags;
+                default: return tile.movementCost;
+            }
+        };
+
+        for (int chunkX = 0; chunkX < chunksX_; ++chunkX) {
+            int chunkIndex = getChunkIndex(chunkX * CHUNK_SIZE, row);
+            int firstCol = chunkX * CHUNK_SIZE;
+            int cols = std::min(CHUNK_SIZE, getWidth() - firstCol);
+            int localRow = row - (row / CHUNK_SIZE) * CHUNK_SIZE;
+
+            auto resident = chunks_.find(chunkIndex);
+            auto packed = packedChunks_.find(chunkIndex);
+            if (resident != chunks_.end()) {
+                for (int col = 0; col < cols; ++col) {
+                    out[firstCol + col] = field(HexMapFormat::packTile(resident->second->tiles[localRow * cols + col]));
+                }
+            } else if (packed != packedChunks_.end()) {
+                for (int col = 0; col < cols; ++col) {
+                    out[firstCol + col] = field(packed->second->tiles[localRow * cols + col]);
+                }
+            } else {
+                size_t index = static_cast<size_t>(row) * getWidth() + firstCol;
+                const void* source = section == HexMapFormat::SECTION_TERRAIN ? static_cast<const void*>(map_.getTerrain() + index)
+                                   : section == HexMapFormat::SECTION_HEIGHT ? static_cast<const void*>(map_.getHeights() + index)
+                                   : section == HexMapFormat::SECTION_FLAGS ? static_cast<const void*>(map_.getFlags() + index)
+                                   : static_cast<const void*>(map_.getMovementCosts() + index);
+                std::copy_n(static_cast<const uint8_t*>(source), cols, out + firstCol);
+            }
+        }
+    };
+
+    // The open file stays mapped while writing, so write beside it and swap at the end
+    std::string temporary = filename + ".tmp";
+    if (!HexMapWriter::write(temporary, getWidth(), getHeight(), fillRow, details, error)) {
+        std::remove(temporary.c_str());
+        return false;
+    }
+    if (!replaceFile(temporary, filename)) {
+        std::remove(temporary.c_str());
+        if (error) *error = "Failed to replace " + filename;
+        return false;
+    }
+    return true;
+}
@@ -17,7 +17,7 @@ void VerticalLayout::layoutChildren(
         if (!child) continue;
         
         // First layout the child itself
-        child->layout();
+        child->updateLayout();
         
         // Then position it within the container
         child->setPosition(containerX, currentY);
@@ -66,7 +66,7 @@ void HorizontalLayout::layoutChildren(
         if (!child) continue;
         
         // First layout the child itself
-        child->layout();
+        child->updateLayout();
         
         // Then position it within the container
         child->setPosition(currentX, containerY);
@@ -127,7 +127,7 @@ void GridLayout::layoutChildren(
             }
             
             // First layout the child itself
-            child->layout();
+            child->updateLayout();
             
             // Calculate position
             int x = containerX + col * (cellWidth + spacing_);
@@ -210,7 +210,7 @@ void BorderLayout::layoutChildren(
     
     // Layout children first
     for (auto& child : children) {
-        if (child) child->layout();
+        if (child) child->updateLayout();
     }
     
     // Calculate available space after accounting for border components
@@ -307,7 +307,7 @@ void FlexLayout::layoutChildren(
     
     // Layout children first
     for (auto& child : children) {
-        if (child) child->layout();
+        if (child) child->updateLayout();
     }
     
     // Filter out null children
@@ -514,7 +514,7 @@ void AbsoluteLayout::layoutChildren(
 ) {
     // Layout children first
     for (auto& child : children) {
-        if (child) child->layout();
+        if (child) child->updateLayout();
     }
     
     // Position components according to their absolute positions
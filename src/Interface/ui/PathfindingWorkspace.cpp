@@ -0,0 +1,164 @@
+#include "Interface/ui/PathfindingWorkspace.h"
+
+void PathfindingWorkspace::begin(int tileCount) {
+    if (static_cast<int>(nodes_.size()) < tileCount) {
+        nodes_.resize(tileCount);
+    }
+    heap_.clear();
+    expanded_ = 0;
+
+    // Generation 0 marks never-used nodes; on wrap-around reset every stamp once
+    if (++generation_ == 0) {
+        for (Node& node : nodes_) {
+            node.generation = 0;
+        }
+        generation_ = 1;
+    }
+}
+
+bool PathfindingWorkspace::relax(int index, int gCost, int priority, int parent) {
+    Node& node = nodes_[index];
+
+    if (node.generation != generation_) {
+        node.generation = generation_;
+        node.gCost = gCost;
+        node.priority = priority;
+        node.parent = parent;
+        node.heapIndex = static_cast<int>(heap_.size());
+        heap_.push_back(index);
+        siftUp(node.heapIndex);
+        return true;
+    }
+
+    if (node.heapIndex == CLOSED || gCost >= node.gCost) {
+        return false;
+    }
+
+    // Decrease-key: the heuristic part of the priority is unchanged
+    node.priority -= node.gCost - gCost;
+    node.gCost = gCost;
+    node.parent = parent;
+    siftUp(node.heapIndex);
+    return true;
+}
+
+int PathfindingWorkspace::popMin() {
+    int index = heap_.front();
+    int last = heap_.back();
+    heap_.pop_back();
+
+    if (!heap_.empty()) {
+        heap_[0] = last;
+        nodes_[last].heapIndex = 0;
+        siftDown(0);
+    }
+
+    nodes_[index].heapIndex = CLOSED;
+    ++expanded_;
+    return index;
+}
+
+void PathfindingWorkspace::beginBuckets(int tileCount, int maxEdgeCost) {
+    begin(tileCount);
+
+    // Every open entry lies within [bucketCost_, bucketCost_ + maxEdgeCost], so a ring of
+    // maxEdgeCost + 1 buckets never mixes two costs in one bucket
+    ringSize_ = maxEdgeCost + 1;
+    if (static_cast<int>(buckets_.size()) < ringSize_) {
+        buckets_.resize(ringSize_);
+    }
+    for (int i = 0; i < ringSize_; ++i) {
+        buckets_[i].clear();
+    }
+    bucketCost_ = 0;
+    pendingEntries_ = 0;
+}
+
+bool PathfindingWorkspace::relaxBucket(int index, int gCost, int parent) {
+    Node& node = nodes_[index];
+
+    if (node.generation == generation_ && (node.heapIndex == CLOSED || gCost >= node.gCost)) {
+        return false;
+    }
+
+    // Improved nodes are pushed again; the old entry is skipped when its bucket drains
+    node.generation = generation_;
+    node.gCost = gCost;
+    node.priority = gCost;
+    node.parent = parent;
+    node.heapIndex = IN_BUCKET;
+    buckets_[gCost % ringSize_].push_back(index);
+    ++pendingEntries_;
+    return true;
+}
+
+int PathfindingWorkspace::popMinBucket() {
+    while (pendingEntries_ > 0) {
+        std::vector<int>& bucket = buckets_[bucketCost_ % ringSize_];
+        if (bucket.empty()) {
+            ++bucketCost_;
+            continue;
+        }
+
+        int index = bucket.back();
+        bucket.pop_back();
+        --pendingEntries_;
+
+        Node& node = nodes_[index];
+        if (node.heapIndex == CLOSED || node.gCost != bucketCost_) {
+            continue; // Stale entry
+        }
+
+        node.heapIndex = CLOSED;
+        ++expanded_;
+        return index;
+    }
+    return -1;
+}
+
+bool PathfindingWorkspace::heapLess(int a, int b) const {
+    const Node& nodeA = nodes_[a];
+    const Node& nodeB = nodes_[b];
+    if (nodeA.priority != nodeB.priority) {
+        return nodeA.priority < nodeB.priority;
+    }
+    // Prefer deeper nodes on ties so A* runs straight at the goal
+    return nodeA.gCost > nodeB.gCost;
+}
+
+void PathfindingWorkspace::siftUp(int position) {
+    int index = heap_[position];
+    while (position > 0) {
+        int parentPosition = (position - 1) / 2;
+        if (!heapLess(index, heap_[parentPosition])) {
+            break;
+        }
+        heap_[position] = heap_[parentPosition];
+        nodes_[heap_[position]].heapIndex = position;
+        position = parentPosition;
+    }
+    heap_[position] = index;
+    nodes_[index].heapIndex = position;
+}
+
+void PathfindingWorkspace::siftDown(int position) {
+    int index = heap_[position];
+    int count = static_cast<int>(heap_.size());
+    while (true) {
+        int child = position * 2 + 1;
+        if (child >= count) {
+            break;
+        }
+        if (child + 1 < count && heapLess(heap_[child + 1], heap_[child])) {
+            ++child;
+        }
+        if (!heapLess(heap_[child], index)) {
+            break;
+        }
+        heap_[position] = heap_[child];
+        nodes_[heap_[position]].heapIndex = position;
+        position = child;
+    }
+    heap_[position] = index;
+    nodes_[index].heapIndex = position;
+}
@@ -8,6 +8,14 @@ SimpleContainer::SimpleContainer(int x, int y, int width, int height, SDLManager
     layout_ = LayoutFactory::vertical();
 }
 
+SimpleContainer::~SimpleContainer() {
+    for (auto& child : children_) {
+        if (child && child->getParent() == this) {
+            child->setParent(nullptr);
+        }
+    }
+}
+
 std::shared_ptr<SimpleContainer> SimpleContainer::createUIContainerReplacement(
     int x, int y, int width, int height, SDLManager& sdl) {
     auto container = std::make_shared<SimpleContainer>(x, y, width, height, sdl);
@@ -30,9 +38,13 @@ std::shared_ptr<SimpleContainer> SimpleContainer::createUILayoutContainerReplace
 void SimpleContainer::addChild(std::shared_ptr<UIComponent> child) {
     if (child) {
         children_.push_back(child);
+        child->setParent(this);
+        hitGridStale_ = true;
+        invalidateLayout();
+        invalidateRender();
         // Auto-layout for forward compatibility with UIContainer/UILayoutContainer
         if (autoLayout_) {
-            layout();
+            updateLayout();
         }
     }
 }
@@ -41,6 +53,12 @@ void SimpleContainer::removeChild(std::shared_ptr<UIComponent> child) {
     auto it = std::find(children_.begin(), children_.end(), child);
     if (it != children_.end()) {
         children_.erase(it);
+        if (child->getParent() == this) {
+            child->setParent(nullptr);
+        }
+        hitGridStale_ = true;
+        invalidateLayout();
+        invalidateRender();
     }
     // Clean layout removal - no dynamic_cast needed
     if (layout_) {
@@ -48,61 +66,77 @@ void SimpleContainer::removeChild(std::shared_ptr<UIComponent> child) {
     }
     // Auto-layout for forward compatibility
     if (autoLayout_) {
-        layout();
+        updateLayout();
     }
 }
 
 void SimpleContainer::clearChildren() {
+    for (auto& child : children_) {
+        if (child && child->getParent() == this) {
+            child->setParent(nullptr);
+        }
+    }
     children_.clear();
+    hitGridStale_ = true;
+    invalidateLayout();
+    invalidateRender();
     if (layout_) {
         layout_->clearComponents();
     }
     // Auto-layout for forward compatibility
     if (autoLayout_) {
-        layout();
+        updateLayout();
     }
 }
 
 void SimpleContainer::setVerticalLayout(int spacing) {
     layout_ = LayoutFactory::vertical(spacing);
+    invalidateLayout();
     // Auto-layout when layout type changes
     if (autoLayout_) {
-        layout();
+        updateLayout();
     }
 }
 
 void SimpleContainer::setHorizontalLayout(int spacing) {
     layout_ = LayoutFactory::horizontal(spacing);
+    invalidateLayout();
     // Auto-layout when layout type changes
     if (autoLayout_) {
-        layout();
+        updateLayout();
     }
 }
 
 void SimpleContainer::setGridLayout(int rows, int cols, int spacing) {
     layout_ = LayoutFactory::grid(rows, cols, spacing);
+    invalidateLayout();
     // Auto-layout when layout type changes
     if (autoLayout_) {
-        layout();
+        updateLayout();
     }
 }
 
 void SimpleContainer::setCustomLayout(std::unique_ptr<Layout> layout) {
     layout_ = std::move(layout);
+    invalidateLayout();
     // Auto-layout when layout type changes
     if (autoLayout_) {
-        this->layout();
+        updateLayout();
     }
 }
 
 void SimpleContainer::setScrollable(bool scrollable) { 
     scrollable_ = scrollable; 
     if (!scrollable_) scrollOffset_ = 0;
+    invalidateLayout();
 }
 
 void SimpleContainer::setScrollOffset(int offset) {
     if (!scrollable_) return;
-    scrollOffset_ = std::max(0, std::min(offset, getMaxScroll()));
+    int clamped = std::max(0, std::min(offset, getMaxScroll()));
+    if (clamped == scrollOffset_) return;
+    scrollOffset_ = clamped;
+    invalidateLayout();
 }
 
 int SimpleContainer::getMaxScroll() const {
@@ -124,24 +158,33 @@ void SimpleContainer::layout() {
     }
     
     layout_->layoutChildren(children_, layoutX, layoutY, width_, height_);
+    
+    // Children moved or resized by the layout lay out again at their final rect
+    for (auto& child : children_) {
+        if (child) child->updateLayout();
+    }
+    hitGridStale_ = true;
 }
 
 void SimpleContainer::render() {
     if (!layout_) return;
     
     // Set up clipping for scrollable content
-    SDL_Rect clip = {x_, y_, width_, height_};
-    SDL_Renderer* renderer = sdlManager_.getRenderer();
-    SDL_RenderSetClipRect(renderer, &clip);
+    ClipState clip;
+    if (!pushClipRect({x_, y_, width_, height_}, clip)) return;
     
     // Render visible children only
     for (auto& child : children_) {
+        // Children outside the clip (for example a partial redraw) are skipped
         if (child && isChildVisible(child)) {
-            child->render();
+            SDL_Rect bounds = child->getRenderBounds();
+            if (SDL_HasIntersection(&bounds, &clip.visible)) {
+                child->render();
+            }
         }
     }
     
-    SDL_RenderSetClipRect(renderer, nullptr);
+    popClipRect(clip);
 }
 
 void SimpleContainer::handleEvent(const SDL_Event& event) {
@@ -163,15 +206,20 @@ std::shared_ptr<UIComponent> SimpleContainer::hitTest(int x, int y) const {
         return nullptr;
     }
     
-    // Test children in reverse order (last added = on top)
-    for (auto it = children_.rbegin(); it != children_.rend(); ++it) {
-        auto& child = *it;
-        if (child && isChildVisible(child) && child->isPointInside(x, y)) {
-            return child;
+    // A dirty container has children that moved since its last layout, so the index is rebuilt
+    if (hitGridStale_ || isLayoutDirty()) {
+        std::vector<SDL_Rect> rects;
+        rects.reserve(children_.size());
+        for (auto& child : children_) {
+            rects.push_back(child ? child->getRect() : SDL_Rect{0, 0, -1, -1});
         }
+        hitGrid_.build(rects);
+        hitGridStale_ = false;
     }
     
-    return nullptr;
+    // Last added = on top
+    int index = hitGrid_.findTopmost(x, y, [this](int i) { return isChildVisible(children_[i]); });
+    return index < 0 ? nullptr : children_[index];
 }
 
 std::shared_ptr<UIComponent> SimpleContainer::getChild(int index) const {
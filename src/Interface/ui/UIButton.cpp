@@ -52,13 +52,17 @@ void UIButton::handleEvent(const SDL_Event& event) {
 
 void UIButton::setText(const std::string& text) {
     text_ = text;
+    invalidateRender();
     updateSize();
+    invalidateLayout();
+    invalidateRender();
 }
 
 void UIButton::setColors(SDL_Color background, SDL_Color text, SDL_Color border) {
     backgroundColor_ = background;
     textColor_ = text;
     borderColor_ = border;
+    invalidateRender();
 }
 
 void UIButton::setOnClick(std::function<void()> onClick) {
@@ -66,7 +70,9 @@ void UIButton::setOnClick(std::function<void()> onClick) {
 }
 
 void UIButton::setEnabled(bool enabled) {
+    if (enabled_ == enabled) return;
     enabled_ = enabled;
+    invalidateRender();
 }
 
 void UIButton::updateSize() {
@@ -57,6 +57,7 @@ void UICard::handleEvent(const SDL_Event& event) {
 
 void UICard::setDisplayData(const CardDisplayData& data) {
     displayData_ = data;
+    invalidateRender();
 }
 
 void UICard::setFromProvider(const ICardDisplayProvider& provider) {
@@ -64,7 +65,9 @@ void UICard::setFromProvider(const ICardDisplayProvider& provider) {
 }
 
 void UICard::setSelected(bool selected) {
+    if (selected_ == selected) return;
     selected_ = selected;
+    invalidateRender();
 }
 
 bool UICard::compareDisplayData(const CardDisplayData& other) const {
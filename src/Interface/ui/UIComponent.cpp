@@ -1,5 +1,7 @@
 #include "Interface/ui/UIComponent.h"
+#include "Interface/ui/UIManager.h"
 #include "Systems/SDLManager.h"
+#include "Systems/GlyphAtlas.h"
 #include <iostream>
 
 UIComponent::UIComponent(int x, int y, int width, int height, SDLManager& sdlManager)
@@ -25,6 +27,12 @@ void UIComponent::renderBorder(SDL_Color color, int thickness) {
 }
 
 void UIComponent::renderText(const std::string& text, int offsetX, int offsetY, SDL_Color color) {
+    // Fast path: cached glyphs, no per-call surface or texture allocation
+    GlyphAtlas* atlas = sdlManager_.getGlyphAtlas();
+    if (atlas && atlas->drawText(sdlManager_.getFont(), text, x_ + offsetX, y_ + offsetY, color)) {
+        return;
+    }
+
     SDL_Surface* surface = TTF_RenderUTF8_Solid(sdlManager_.getFont(), text.c_str(), color);
     if (!surface) {
         std::cerr << "Text rendering failed: " << TTF_GetError() << std::endl;
@@ -53,14 +61,74 @@ bool UIComponent::isPointInside(int mouseX, int mouseY) const {
            mouseY >= y_ && mouseY <= y_ + height_;
 }
 
+void UIComponent::setZOrder(int zOrder) {
+    if (zOrder_ == zOrder) return;
+    zOrder_ = zOrder;
+    if (owner_) {
+        owner_->onZOrderChanged(this);
+    }
+}
+
 void UIComponent::setPosition(int x, int y) {
+    if (x_ == x && y_ == y) return;
+    invalidateRender();
     x_ = x;
     y_ = y;
+    invalidateRender();
+    invalidateLayout();
 }
 
 void UIComponent::setSize(int width, int height) {
+    if (width_ == width && height_ == height) return;
+    invalidateRender();
     width_ = width;
     height_ = height;
+    invalidateRender();
+    invalidateLayout();
+}
+
+void UIComponent::updateLayout() {
+    if (!layoutDirty_) return;
+    layout();
+    // Cleared afterwards: moving children during layout() invalidates this component again
+    layoutDirty_ = false;
+}
+
+void UIComponent::invalidateLayout() {
+    // Top-level components are hit-tested by their manager, which must see the new rect
+    if (owner_) {
+        owner_->onBoundsChanged(this);
+    }
+    for (UIComponent* component = this; component; component = component->parent_) {
+        component->layoutDirty_ = true;
+    }
+}
+
+void UIComponent::invalidateRender() {
+    const UIComponent* root = this;
+    while (root->parent_) {
+        root = root->parent_;
+    }
+    if (root->owner_) {
+        root->owner_->invalidateRect(getRenderBounds());
+    }
+}
+
+bool UIComponent::pushClipRect(const SDL_Rect& clip, ClipState& saved) {
+    SDL_Renderer* renderer = sdlManager_.getRenderer();
+    saved.enabled = SDL_RenderIsClipEnabled(renderer) == SDL_TRUE;
+    SDL_RenderGetClipRect(renderer, &saved.rect);
+    
+    saved.visible = clip;
+    if (saved.enabled && !SDL_IntersectRect(&clip, &saved.rect, &saved.visible)) {
+        return false;
+    }
+    SDL_RenderSetClipRect(renderer, &saved.visible);
+    return true;
+}
+
+void UIComponent::popClipRect(const ClipState& saved) {
+    SDL_RenderSetClipRect(sdlManager_.getRenderer(), saved.enabled ? &saved.rect : nullptr);
 }
 
 void UIComponent::getTextSize(const std::string& text, int& width, int& height) {
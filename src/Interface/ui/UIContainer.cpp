@@ -11,7 +11,10 @@ UIContainer::UIContainer(int x, int y, int width, int height, SDLManager& sdl)
 void UIContainer::setScrollOffset(int offset) {
     // For UIContainer, we manage scroll offset directly for backward compatibility
     // No need to check scrollable_ or calculate maxScroll like UILayoutContainer
-    scrollOffset_ = std::max(0, offset);  // Allow any positive offset for legacy behavior
+    int clamped = std::max(0, offset);  // Allow any positive offset for legacy behavior
+    if (clamped == scrollOffset_) return;
+    scrollOffset_ = clamped;
+    invalidateLayout();
 }
 
 void UIContainer::layout() {
@@ -22,13 +25,14 @@ void UIContainer::layout() {
         if (!child) continue;
         
         // First layout the child itself
-        child->layout();
+        child->updateLayout();
         
         // Then position it within this container, with scroll offset applied
         child->setPosition(x_, offsetY);
         
         offsetY += child->getHeight();
     }
+    updateChildLayouts();
 }
 
 int UIContainer::getVisibleCount() const {
@@ -0,0 +1,63 @@
+#include "Interface/ui/UIHitGrid.h"
+#include <algorithm>
+
+void UIHitGrid::clear() {
+    rects_.clear();
+    cells_.clear();
+    large_.clear();
+    bounds_ = {0, 0, 0, 0};
+    columns_ = rows_ = 0;
+}
+
+void UIHitGrid::build(const std::vector<SDL_Rect>& rects) {
+    clear();
+    rects_ = rects;
+    if (rects_.empty()) return;
+
+    // Extents are inclusive like isPointInside, so a w x h rect covers w + 1 x h + 1 points.
+    // Rects with negative sizes contain no points and stay out of the grid.
+    int minX = 0, minY = 0, maxX = -1, maxY = -1;
+    int indexed = 0;
+    long long extentSum = 0;
+    for (const SDL_Rect& r : rects_) {
+        if (r.w < 0 || r.h < 0) continue;
+        if (indexed++ == 0) {
+            minX = maxX = r.x;
+            minY = maxY = r.y;
+        }
+        minX = std::min(minX, r.x);
+        minY = std::min(minY, r.y);
+        maxX = std::max(maxX, r.x + r.w);
+        maxY = std::max(maxY, r.y + r.h);
+        extentSum += std::max(r.w, r.h);
+    }
+    if (indexed == 0) return;
+    bounds_ = {minX, minY, maxX - minX + 1, maxY - minY + 1};
+
+    // Cells about the size of a typical entry, capped at a few cells per entry
+    const int count = static_cast<int>(rects_.size());
+    const long long maxCells = std::max(64LL, 4LL * count);
+    cellSize_ = std::max<int>(MIN_CELL_SIZE, static_cast<int>(extentSum / indexed));
+    while (static_cast<long long>(bounds_.w / cellSize_ + 1) * (bounds_.h / cellSize_ + 1) > maxCells) {
+        cellSize_ *= 2;
+    }
+    columns_ = bounds_.w / cellSize_ + 1;
+    rows_ = bounds_.h / cellSize_ + 1;
+    cells_.resize(static_cast<size_t>(columns_) * rows_);
+
+    for (int i = 0; i < count; ++i) {
+        const SDL_Rect& r = rects_[i];
+        if (r.w < 0 || r.h < 0) continue;
+        const int c0 = (r.x - minX) / cellSize_, c1 = (r.x + r.w - minX) / cellSize_;
+        const int r0 = (r.y - minY) / cellSize_, r1 = (r.y + r.h - minY) / cellSize_;
+        if ((c1 - c0 + 1) * (r1 - r0 + 1) > MAX_CELLS_PER_RECT) {
+            large_.push_back(i);
+            continue;
+        }
+        for (int row = r0; row <= r1; ++row) {
+            for (int column = c0; column <= c1; ++column) {
+                cells_[row * columns_ + column].push_back(i);
+            }
+        }
+    }
+}
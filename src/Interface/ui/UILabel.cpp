@@ -43,10 +43,13 @@ void UILabel::render() {
 }
 
 void UILabel::setText(const std::string& text) {
+    if (text == text_) return;
     text_ = text;
     // Clear cached layout data - will be recalculated in next layout() call
     wrappedLines_.clear();
     totalTextHeight_ = 0;
+    invalidateLayout();
+    invalidateRender();
 }
 
 void UILabel::calculateTextLayout() {
@@ -12,10 +12,22 @@ UILayoutContainer::UILayoutContainer(int x, int y, int width, int height, SDLMan
     setVerticalLayout();  // Now uses LayoutFactory - no more class instantiation
 }
 
+UILayoutContainer::~UILayoutContainer() {
+    for (auto& child : children_) {
+        if (child && child->getParent() == this) {
+            child->setParent(nullptr);
+        }
+    }
+}
+
 void UILayoutContainer::addChild(std::shared_ptr<UIComponent> child) {
     if (!child) return;
     
     children_.push_back(child);
+    child->setParent(this);
+    hitGridStale_ = true;
+    invalidateLayout();
+    invalidateRender();
 }
 
 void UILayoutContainer::removeChild(std::shared_ptr<UIComponent> child) {
@@ -24,6 +36,12 @@ void UILayoutContainer::removeChild(std::shared_ptr<UIComponent> child) {
     auto it = std::find(children_.begin(), children_.end(), child);
     if (it != children_.end()) {
         children_.erase(it);
+        if (child->getParent() == this) {
+            child->setParent(nullptr);
+        }
+        hitGridStale_ = true;
+        invalidateLayout();
+        invalidateRender();
     }
     
     // Layout-specific cleanup through virtual function - no more dynamic_cast!
@@ -33,7 +51,15 @@ void UILayoutContainer::removeChild(std::shared_ptr<UIComponent> child) {
 }
 
 void UILayoutContainer::clearChildren() {
+    for (auto& child : children_) {
+        if (child && child->getParent() == this) {
+            child->setParent(nullptr);
+        }
+    }
     children_.clear();
+    hitGridStale_ = true;
+    invalidateLayout();
+    invalidateRender();
     
     // Layout-specific cleanup through virtual function - no more dynamic_cast!
     if (layout_) {
@@ -43,33 +69,40 @@ void UILayoutContainer::clearChildren() {
 
 void UILayoutContainer::setLayout(std::unique_ptr<Layout> layout) {
     layout_ = std::move(layout);
+    invalidateLayout();
 }
 
 void UILayoutContainer::setVerticalLayout(int spacing) {
     layout_ = LayoutFactory::vertical(spacing);
+    invalidateLayout();
 }
 
 void UILayoutContainer::setHorizontalLayout(int spacing) {
     layout_ = LayoutFactory::horizontal(spacing);
+    invalidateLayout();
 }
 
 void UILayoutContainer::setGridLayout(int rows, int cols, int spacing) {
     layout_ = LayoutFactory::grid(rows, cols, spacing);
+    invalidateLayout();
 }
 
 void UILayoutContainer::setBorderLayout(int gap) {
     layout_ = std::make_unique<BorderLayout>(gap);
+    invalidateLayout();
     // TODO: Convert to function when BorderLayout API is simplified
     // Note: Components need to be added using addBorderComponent
 }
 
 void UILayoutContainer::setFlexLayout(FlexDirection direction) {
     layout_ = std::make_unique<FlexLayout>(direction);
+    invalidateLayout();
     // TODO: Convert to function - FlexLayout is usually overkill for games
 }
 
 void UILayoutContainer::setAbsoluteLayout() {
     layout_ = std::make_unique<AbsoluteLayout>();
+    invalidateLayout();
     // TODO: Convert to function when AbsoluteLayout API is simplified
     // Note: Components need positions set using setAbsolutePosition
 }
@@ -85,6 +118,7 @@ void UILayoutContainer::addBorderComponent(std::shared_ptr<UIComponent> componen
     // Add to border layout
     if (auto borderLayout = dynamic_cast<BorderLayout*>(layout_.get())) {
         borderLayout->addComponent(component, position);
+        invalidateLayout();
     }
 }
 
@@ -99,6 +133,7 @@ void UILayoutContainer::setAbsolutePosition(std::shared_ptr<UIComponent> compone
     // Set absolute position
     if (auto absoluteLayout = dynamic_cast<AbsoluteLayout*>(layout_.get())) {
         absoluteLayout->setComponentPosition(component, position);
+        invalidateLayout();
     }
 }
 
@@ -106,7 +141,10 @@ void UILayoutContainer::setScrollOffset(int offset) {
     if (!scrollable_) return;
     
     // Clamp to [0, max]
-    scrollOffset_ = std::max(0, std::min(offset, getMaxScroll()));
+    int clamped = std::max(0, std::min(offset, getMaxScroll()));
+    if (clamped == scrollOffset_) return;
+    scrollOffset_ = clamped;
+    invalidateLayout();
 }
 
 int UILayoutContainer::getMaxScroll() const {
@@ -134,24 +172,28 @@ void UILayoutContainer::layout() {
     
     // Delegate to the layout manager
     layout_->layoutChildren(children_, layoutX, layoutY, layoutWidth, layoutHeight);
+    updateChildLayouts();
 }
 
 void UILayoutContainer::render() {
     if (!layout_) return;
     
     // Set up clipping rectangle
-    SDL_Rect clip = {x_, y_, width_, height_};
-    SDL_Renderer* renderer = sdlManager_.getRenderer();
-    SDL_RenderSetClipRect(renderer, &clip);
+    ClipState clip;
+    if (!pushClipRect({x_, y_, width_, height_}, clip)) return;
 
     // Render visible children
     for (auto& child : children_) {
+        // Children outside the clip (for example a partial redraw) are skipped
         if (child && isChildVisible(child)) {
-            child->render();
+            SDL_Rect bounds = child->getRenderBounds();
+            if (SDL_HasIntersection(&bounds, &clip.visible)) {
+                child->render();
+            }
         }
     }
 
-    SDL_RenderSetClipRect(renderer, nullptr);
+    popClipRect(clip);
 }
 
 void UILayoutContainer::handleEvent(const SDL_Event& event) {
@@ -175,17 +217,20 @@ std::shared_ptr<UIComponent> UILayoutContainer::hitTest(int x, int y) const {
         return nullptr;
     }
     
-    // Test children in reverse order (last added = on top)
-    for (auto it = children_.rbegin(); it != children_.rend(); ++it) {
-        auto& child = *it;
-        if (!child || !isChildVisible(child)) continue;
-        
-        if (child->isPointInside(x, y)) {
-            return child;
+    // A dirty container has children that moved since its last layout, so the index is rebuilt
+    if (hitGridStale_ || isLayoutDirty()) {
+        std::vector<SDL_Rect> rects;
+        rects.reserve(children_.size());
+        for (auto& child : children_) {
+            rects.push_back(child ? child->getRect() : SDL_Rect{0, 0, -1, -1});
         }
+        hitGrid_.build(rects);
+        hitGridStale_ = false;
     }
     
-    return nullptr;
+    // Last added = on top
+    int index = hitGrid_.findTopmost(x, y, [this](int i) { return isChildVisible(children_[i]); });
+    return index < 0 ? nullptr : children_[index];
 }
 
 std::shared_ptr<UIComponent> UILayoutContainer::getChild(int index) const {
@@ -225,5 +270,17 @@ void UILayoutContainer::updateScrollBounds() {
     
     // Clamp current scroll offset to valid range
     int maxScroll = getMaxScroll();
-    scrollOffset_ = std::max(0, std::min(scrollOffset_, maxScroll));
+    int clamped = std::max(0, std::min(scrollOffset_, maxScroll));
+    if (clamped == scrollOffset_) return;
+    scrollOffset_ = clamped;
+    invalidateLayout();
+}
+
+void UILayoutContainer::updateChildLayouts() {
+    // Children lay out before the layout positions them, so the ones it moved or resized
+    // are dirty again and lay out once more at their final rect
+    for (auto& child : children_) {
+        if (child) child->updateLayout();
+    }
+    hitGridStale_ = true;
 }
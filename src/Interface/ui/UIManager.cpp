@@ -3,7 +3,29 @@
 #include <algorithm>
 #include <iostream>
 
+UIManager::~UIManager() {
+    for (const RenderEntry& entry : renderList_) {
+        if (entry.component->owner_ == this) {
+            entry.component->owner_ = nullptr;
+        }
+    }
+    releaseFrameCache();
+}
+
 void UIManager::addComponent(std::shared_ptr<UIComponent> comp, bool persistent) {
+    if (!comp) return;
+    
+    // Insert after every entry with the same or lower z-order
+    auto position = std::upper_bound(renderList_.begin(), renderList_.end(), comp->getZOrder(),
+        [](int zOrder, const RenderEntry& entry) {
+            return zOrder < entry.component->getZOrder();
+        });
+    size_t slot = persistent ? persistent_.size() : dynamic_.size();
+    renderList_.insert(position, {comp.get(), nextSequence_++, persistent, slot});
+    comp->owner_ = this;
+    hitGridDirty_ = true;
+    invalidateRect(comp->getRenderBounds());
+    
     if (persistent) {
         persistent_.push_back(comp);
     } else {
@@ -30,6 +52,7 @@ void UIManager::clearDynamic() {
         }
     }
     
+    removeFromRenderList(false);
     dynamic_.clear();
 }
 
@@ -52,16 +75,20 @@ void UIManager::clearPersistent() {
         }
     }
     
+    removeFromRenderList(true);
     persistent_.clear();
 }
 
 void UIManager::layoutAll() {
-    // Layout persistent components first, then dynamic components
+    // Layout persistent components first, then dynamic components; clean subtrees are skipped.
+    // Laying out may resize a component, which moves it in the hit-test index.
     for (auto& c : persistent_) {
-        c->layout();
+        hitGridDirty_ = hitGridDirty_ || c->isLayoutDirty();
+        c->updateLayout();
     }
     for (auto& c : dynamic_) {
-        c->layout();
+        hitGridDirty_ = hitGridDirty_ || c->isLayoutDirty();
+        c->updateLayout();
     }
 }
 
@@ -69,28 +96,144 @@ void UIManager::renderAll() {
     // Always perform layout before rendering for consistency
     layoutAll();
     
-    // Get all components and sort by z-order
-    auto allComponents = getAllComponents();
-    sortComponentsByZOrder(allComponents);
-    
     // Render components in z-order (lowest to highest), only if visible
-    for (auto& c : allComponents) {
+    for (size_t i = 0; i < renderList_.size(); ++i) {
+        UIComponent* c = renderList_[i].component;
         if (c->isVisible()) {
             c->render();
         }
     }
 }
 
+bool UIManager::renderRetained(SDL_Renderer* renderer, SDL_Color background) {
+    // Time-driven visuals report their damage first
+    Uint32 ticks = SDL_GetTicks();
+    for (size_t i = 0; i < renderList_.size(); ++i) {
+        renderList_[i].component->onFrame(ticks);
+    }
+    auto focused = focusedComponent_.lock();
+    if (focused && focused->getParent()) {
+        focused->onFrame(ticks);
+    }
+    
+    // Layout moves damage both the old and the new rects
+    layoutAll();
+    if (!hasDamage()) {
+        lastRedrawArea_ = 0;
+        return false;
+    }
+    
+    int width = 0, height = 0;
+    if (!renderer || SDL_GetRendererOutputSize(renderer, &width, &height) != 0) {
+        width = height = 0;
+    }
+    SDL_Rect screen = {0, 0, width, height};
+    
+    // Collect this frame's damage; components changing during render damage the next frame
+    frameDamage_.clear();
+    bool full = fullDamage_;
+    if (!full) {
+        long long damagedArea = 0;
+        for (const SDL_Rect& rect : damage_) {
+            SDL_Rect area;
+            if (SDL_IntersectRect(&rect, &screen, &area)) {
+                frameDamage_.push_back(area);
+                damagedArea += static_cast<long long>(area.w) * area.h;
+            }
+        }
+        // Mostly damaged frames are cheaper to redraw in one pass
+        full = damagedArea * 4 > static_cast<long long>(width) * height * 3;
+    }
+    damage_.clear();
+    fullDamage_ = false;
+    
+    if (!ensureFrameCache(renderer, width, height)) {
+        // Whole-frame fallback: the window's back buffer does not survive presenting
+        SDL_RenderSetClipRect(renderer, nullptr);
+        SDL_SetRenderDrawColor(renderer, background.r, background.g, background.b, background.a);
+        SDL_RenderClear(renderer);
+        for (size_t i = 0; i < renderList_.size(); ++i) {
+            UIComponent* c = renderList_[i].component;
+            if (c->isVisible()) {
+                c->render();
+            }
+        }
+        lastRedrawArea_ = width * height;
+        return true;
+    }
+    
+    if (full) {
+        frameDamage_.assign(1, screen);
+    }
+    
+    SDL_Texture* previousTarget = SDL_GetRenderTarget(renderer);
+    SDL_SetRenderTarget(renderer, frameCache_);
+    lastRedrawArea_ = 0;
+    for (const SDL_Rect& area : frameDamage_) {
+        SDL_RenderSetClipRect(renderer, &area);
+        SDL_SetRenderDrawColor(renderer, background.r, background.g, background.b, background.a);
+        SDL_RenderFillRect(renderer, &area);
+        renderDamage(area);
+        lastRedrawArea_ += area.w * area.h;
+    }
+    SDL_RenderSetClipRect(renderer, nullptr);
+    SDL_SetRenderTarget(renderer, previousTarget);
+    SDL_RenderCopy(renderer, frameCache_, nullptr, nullptr);
+    return true;
+}
+
+void UIManager::renderDamage(const SDL_Rect& area) {
+    // Components overlapping the damaged area, in z-order; the clip rect keeps the rest intact
+    for (size_t i = 0; i < renderList_.size(); ++i) {
+        UIComponent* c = renderList_[i].component;
+        if (!c->isVisible()) continue;
+        SDL_Rect bounds = c->getRenderBounds();
+        if (SDL_HasIntersection(&bounds, &area)) {
+            c->render();
+        }
+    }
+}
+
+void UIManager::invalidateRect(const SDL_Rect& rect) {
+    if (fullDamage_ || rect.w <= 0 || rect.h <= 0) return;
+    
+    SDL_Rect grown = rect;
+    
+    // Merge with overlapping rects; a merged rect can reach others, so rescan after each merge
+    for (size_t i = 0; i < damage_.size();) {
+        if (SDL_HasIntersection(&damage_[i], &grown)) {
+            SDL_UnionRect(&damage_[i], &grown, &grown);
+            damage_[i] = damage_.back();
+            damage_.pop_back();
+            i = 0;
+        } else {
+            ++i;
+        }
+    }
+    damage_.push_back(grown);
+    
+    // Too many scattered rects: redraw their bounding box instead
+    if (damage_.size() > MAX_DAMAGE_RECTS) {
+        SDL_Rect bounds = damage_[0];
+        for (size_t i = 1; i < damage_.size(); ++i) {
+            SDL_UnionRect(&bounds, &damage_[i], &bounds);
+        }
+        damage_.assign(1, bounds);
+    }
+}
+
+void UIManager::invalidateAll() {
+    fullDamage_ = true;
+    damage_.clear();
+}
+
 void UIManager::layoutAndRenderClipped(const SDL_Rect& clip) {
     // First perform layout for all components
     layoutAll();
     
-    // Get all components and sort by z-order
-    auto allComponents = getAllComponents();
-    sortComponentsByZOrder(allComponents);
-    
     // Then render only visible components fully inside clip rect, in z-order
-    for (auto& c : allComponents) {
+    for (size_t i = 0; i < renderList_.size(); ++i) {
+        UIComponent* c = renderList_[i].component;
         if (c->isVisible()) {
             SDL_Rect r = c->getRect();
             if (r.x >= clip.x && r.x + r.w <= clip.x + clip.w &&
@@ -113,21 +256,12 @@ std::shared_ptr<UIComponent> UIManager::getComponentAt(int x, int y) const {
         return nullptr;
     }
     
-    // Get all components and sort by z-order (highest to lowest for hit-testing)
-    auto allComponents = getAllComponents();
-    std::sort(allComponents.begin(), allComponents.end(), 
-        [](const std::shared_ptr<UIComponent>& a, const std::shared_ptr<UIComponent>& b) {
-            return a->getZOrder() > b->getZOrder();
-        });
-    
-    // Find the top-most component at the point
-    for (auto& c : allComponents) {
-        if (c->isPointInside(x, y)) {
-            return c;
-        }
+    // Find the top-most component at the point: the index returns render list positions
+    if (hitGridDirty_) {
+        rebuildHitGrid();
     }
-    
-    return nullptr;
+    int index = hitGrid_.findTopmost(x, y, [](int) { return true; });
+    return index < 0 ? nullptr : getOwned(renderList_[index]);
 }
 
 // Event handling
@@ -145,6 +279,14 @@ void UIManager::handleEvent(const SDL_Event& event) {
         }
     }
     
+    // The window's contents are lost on these, and the cached frame on render resets
+    if (event.type == SDL_WINDOWEVENT || event.type == SDL_RENDER_TARGETS_RESET) {
+        invalidateAll();
+    } else if (event.type == SDL_RENDER_DEVICE_RESET) {
+        releaseFrameCache();
+        invalidateAll();
+    }
+    
     // Let modal component handle events first if present
     auto modal = modalComponent_.lock();
     if (modal) {
@@ -293,13 +435,10 @@ void UIManager::clearModal() {
 void UIManager::bringToTop(std::shared_ptr<UIComponent> component) {
     if (!component) return;
     
-    // Find the highest z-order among all components
+    // The highest z-order among all components ends the render list
     int maxZ = 0;
-    for (auto& c : persistent_) {
-        maxZ = std::max(maxZ, c->getZOrder());
-    }
-    for (auto& c : dynamic_) {
-        maxZ = std::max(maxZ, c->getZOrder());
+    if (!renderList_.empty()) {
+        maxZ = std::max(maxZ, renderList_.back().component->getZOrder());
     }
     
     // Set component z-order to highest + 1
@@ -309,20 +448,98 @@ void UIManager::bringToTop(std::shared_ptr<UIComponent> component) {
 void UIManager::sendToBottom(std::shared_ptr<UIComponent> component) {
     if (!component) return;
     
-    // Find the lowest z-order among all components
+    // The lowest z-order among all components starts the render list
     int minZ = 0;
-    for (auto& c : persistent_) {
-        minZ = std::min(minZ, c->getZOrder());
-    }
-    for (auto& c : dynamic_) {
-        minZ = std::min(minZ, c->getZOrder());
+    if (!renderList_.empty()) {
+        minZ = std::min(minZ, renderList_.front().component->getZOrder());
     }
     
     // Set component z-order to lowest - 1
     component->setZOrder(minZ - 1);
 }
 
+void UIManager::onZOrderChanged(UIComponent* component) {
+    sortRenderList();
+    invalidateRect(component->getRenderBounds());
+}
+
 // Helper functions
+void UIManager::sortRenderList() {
+    hitGridDirty_ = true;
+    
+    // Insertion sort: the list is sorted except for the changed entries, and it never allocates
+    auto before = [](const RenderEntry& a, const RenderEntry& b) {
+        int za = a.component->getZOrder();
+        int zb = b.component->getZOrder();
+        return za < zb || (za == zb && a.sequence < b.sequence);
+    };
+    for (size_t i = 1; i < renderList_.size(); ++i) {
+        RenderEntry entry = renderList_[i];
+        size_t j = i;
+        while (j > 0 && before(entry, renderList_[j - 1])) {
+            renderList_[j] = renderList_[j - 1];
+            --j;
+        }
+        renderList_[j] = entry;
+    }
+}
+
+void UIManager::removeFromRenderList(bool persistent) {
+    hitGridDirty_ = true;
+    renderList_.erase(std::remove_if(renderList_.begin(), renderList_.end(),
+        [this, persistent](const RenderEntry& entry) {
+            if (entry.persistent != persistent) return false;
+            invalidateRect(entry.component->getRenderBounds());
+            if (entry.component->owner_ == this) {
+                entry.component->owner_ = nullptr;
+            }
+            return true;
+        }), renderList_.end());
+}
+
+void UIManager::rebuildHitGrid() const {
+    std::vector<SDL_Rect> rects;
+    rects.reserve(renderList_.size());
+    for (const RenderEntry& entry : renderList_) {
+        const UIComponent* c = entry.component;
+        rects.push_back({c->getX(), c->getY(), c->getWidth(), c->getHeight()});
+    }
+    hitGrid_.build(rects);
+    hitGridDirty_ = false;
+}
+
+bool UIManager::ensureFrameCache(SDL_Renderer* renderer, int width, int height) {
+    if (frameCache_ && frameRenderer_ == renderer && frameWidth_ == width && frameHeight_ == height) {
+        return true;
+    }
+    releaseFrameCache();
+    if (!renderer || width <= 0 || height <= 0 || !SDL_RenderTargetSupported(renderer)) {
+        return false;
+    }
+    
+    frameCache_ = SDL_CreateTexture(renderer, SDL_PIXELFORMAT_RGBA8888, SDL_TEXTUREACCESS_TARGET, width, height);
+    if (!frameCache_) {
+        std::cerr << "UIManager: frame cache creation failed: " << SDL_GetError() << std::endl;
+        return false;
+    }
+    frameRenderer_ = renderer;
+    frameWidth_ = width;
+    frameHeight_ = height;
+    
+    // A new cache starts empty
+    frameDamage_.assign(1, {0, 0, width, height});
+    return true;
+}
+
+void UIManager::releaseFrameCache() {
+    if (frameCache_) {
+        SDL_DestroyTexture(frameCache_);
+        frameCache_ = nullptr;
+    }
+    frameRenderer_ = nullptr;
+    frameWidth_ = frameHeight_ = 0;
+}
+
 std::vector<std::shared_ptr<UIComponent>> UIManager::getAllComponents() const {
     std::vector<std::shared_ptr<UIComponent>> allComponents;
     allComponents.reserve(persistent_.size() + dynamic_.size());
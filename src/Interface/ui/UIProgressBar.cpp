@@ -61,30 +61,38 @@ void UIProgressBar::layout() {
 }
 
 void UIProgressBar::setProgress(float progress) {
-    progress_ = std::clamp(progress, 0.0f, 1.0f);
+    progress = std::clamp(progress, 0.0f, 1.0f);
+    if (progress == progress_) return;
+    progress_ = progress;
     if (!animated_) {
         displayProgress_ = progress_;
     }
+    invalidateRender();
 }
 
 void UIProgressBar::setShowText(bool showText) {
     showText_ = showText;
+    invalidateRender();
 }
 
 void UIProgressBar::setCustomText(const std::string& text) {
+    if (hasCustomText_ && customText_ == text) return;
     customText_ = text;
     hasCustomText_ = true;
+    invalidateRender();
 }
 
 void UIProgressBar::clearCustomText() {
     customText_.clear();
     hasCustomText_ = false;
+    invalidateRender();
 }
 
 void UIProgressBar::setColors(SDL_Color background, SDL_Color fill, SDL_Color border) {
     backgroundColor_ = background;
     fillColor_ = fill;
     borderColor_ = border;
+    invalidateRender();
 }
 
 void UIProgressBar::setColors(SDL_Color background, SDL_Color fill, SDL_Color border, SDL_Color text) {
@@ -92,10 +100,12 @@ void UIProgressBar::setColors(SDL_Color background, SDL_Color fill, SDL_Color bo
     fillColor_ = fill;
     borderColor_ = border;
     textColor_ = text;
+    invalidateRender();
 }
 
 void UIProgressBar::setBorderWidth(int borderWidth) {
     borderWidth_ = std::max(0, borderWidth);
+    invalidateRender();
 }
 
 void UIProgressBar::setAnimated(bool animated, float animationSpeed) {
@@ -104,11 +114,13 @@ void UIProgressBar::setAnimated(bool animated, float animationSpeed) {
     if (!animated_) {
         displayProgress_ = progress_;
     }
+    invalidateRender();
 }
 
 void UIProgressBar::update(float deltaTime) {
-    if (animated_) {
+    if (animated_ && displayProgress_ != progress_) {
         updateDisplayProgress(deltaTime);
+        invalidateRender();
     }
 }
 
@@ -208,7 +208,20 @@ void UISceneManager::update(float deltaTime) {
     }
 }
 
-void UISceneManager::render() {
+bool UISceneManager::render() {
+    // A lone retained scene owns the whole frame; transitions and overlays draw in full
+    if (!transitionActive_ && sceneStack_.size() == 1 && sceneStack_.top()->isRetainedRendering()) {
+        UIScene* scene = sceneStack_.top().get();
+        UIManager& ui = scene->getUIManager();
+        if (retainedScene_ != scene) {
+            // Frames drawn another way since the scene's last retained frame are not cached
+            ui.invalidateAll();
+            retainedScene_ = scene;
+        }
+        return ui.renderRetained(sdlManager_.getRenderer(), scene->getBackgroundColor());
+    }
+    retainedScene_ = nullptr;
+    
     if (transitionActive_) {
         renderTransition();
     } else {
@@ -227,6 +240,7 @@ void UISceneManager::render() {
             (*it)->getUIManager().renderAll();
         }
     }
+    return true;
 }
 
 void UISceneManager::handleEvent(const SDL_Event& event) {
@@ -65,13 +65,23 @@ void UITextInput::render() {
     }
     
     // Handle cursor blinking
-    Uint32 currentTime = SDL_GetTicks();
-    if (currentTime - lastCursorBlink_ > CURSOR_BLINK_RATE) {
-        showCursor_ = !showCursor_;
-        lastCursorBlink_ = currentTime;
+    advanceCursorBlink(SDL_GetTicks());
+}
+
+void UITextInput::onFrame(Uint32 ticks) {
+    // Only the cursor changes over time, and only while it is drawn
+    if (hasFocus() && !readOnly_ && advanceCursorBlink(ticks)) {
+        invalidateRender();
     }
 }
 
+bool UITextInput::advanceCursorBlink(Uint32 ticks) {
+    if (ticks - lastCursorBlink_ <= CURSOR_BLINK_RATE) return false;
+    showCursor_ = !showCursor_;
+    lastCursorBlink_ = ticks;
+    return true;
+}
+
 void UITextInput::handleEvent(const SDL_Event& event) {
     if (!hasFocus() || readOnly_) {
         return;
@@ -154,6 +164,7 @@ void UITextInput::handleEvent(const SDL_Event& event) {
             // Reset cursor blink on any key press
             showCursor_ = true;
             lastCursorBlink_ = SDL_GetTicks();
+            invalidateRender();
             break;
         }
             
@@ -168,6 +179,7 @@ void UITextInput::handleEvent(const SDL_Event& event) {
                 // Reset cursor blink
                 showCursor_ = true;
                 lastCursorBlink_ = SDL_GetTicks();
+                invalidateRender();
             }
             break;
     }
@@ -352,6 +364,9 @@ void UITextInput::updateTextOffset() {
     if (textOffset_ < 0) {
         textOffset_ = 0;
     }
+    
+    // Every text, cursor and selection edit ends here
+    invalidateRender();
 }
 
 void UITextInput::validateAndUpdateText(const std::string& newText) {
@@ -375,14 +390,13 @@ void UITextInput::renderTextContent() {
     int textX = x_ + TEXT_PADDING - textOffset_;
     int textY = y_ + (height_ - 16) / 2; // Assuming font height ~16
     
-    // Set clipping rectangle to prevent text from drawing outside component
-    SDL_Rect clipRect = {x_ + TEXT_PADDING, y_, width_ - 2 * TEXT_PADDING, height_};
-    SDL_RenderSetClipRect(sdlManager_.getRenderer(), &clipRect);
+    // Clip text to the component, within any clip already active
+    ClipState clip;
+    if (!pushClipRect({x_ + TEXT_PADDING, y_, width_ - 2 * TEXT_PADDING, height_}, clip)) return;
     
     UIComponent::renderText(displayText, textX - x_, textY - y_, textColor_);
     
-    // Reset clipping
-    SDL_RenderSetClipRect(sdlManager_.getRenderer(), nullptr);
+    popClipRect(clip);
 }
 
 void UITextInput::renderCursor() {
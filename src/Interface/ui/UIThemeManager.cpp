@@ -104,6 +104,8 @@ void UIThemeManager::applyThemeToComponent(UIComponent* component) {
         // Delegate to UITheme for actual theme application
         UITheme& theme = UITheme::getInstance();
         theme.applyThemeToComponent(componentType, component);
+        component->invalidateLayout();  // Theme fonts and metrics can change sizes
+        component->invalidateRender();
         
         std::cout << "Applied theme to " << componentType << std::endl;
     } else {
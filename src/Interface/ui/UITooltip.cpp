@@ -40,11 +40,16 @@ void UITooltip::show(const TooltipData& data, int mouseX, int mouseY) {
     mouseX_ = mouseX;
     mouseY_ = mouseY;
     
+    // Damage both the old and the new placement
+    if (visible_) {
+        invalidateRender();
+    }
     generateDisplayLines(data);
     calculateSize();
     calculateOptimalPosition();
     
     visible_ = true;
+    invalidateRender();
 }
 
 void UITooltip::showForProvider(const ITooltipProvider& provider, int mouseX, int mouseY) {
@@ -52,7 +57,9 @@ void UITooltip::showForProvider(const ITooltipProvider& provider, int mouseX, in
 }
 
 void UITooltip::hide() {
+    if (!visible_) return;
     visible_ = false;
+    invalidateRender();
 }
 
 void UITooltip::generateDisplayLines(const TooltipData& data) {
@@ -0,0 +1,293 @@
+#include "Interface/ui/VirtualListContainer.h"
+#include "Systems/SDLManager.h"
+#include <algorithm>
+#include <iostream>
+
+VirtualListContainer::VirtualListContainer(int x, int y, int width, int height, SDLManager& sdl)
+    : UIComponent(x, y, width, height, sdl) {
+    layout_ = LayoutFactory::vertical(spacing_);
+}
+
+VirtualListContainer::~VirtualListContainer() {
+    releaseRows();
+}
+
+void VirtualListContainer::setRowFactory(RowFactory factory, RowBinder binder) {
+    releaseRows();
+    factory_ = std::move(factory);
+    binder_ = std::move(binder);
+    invalidateLayout();
+    invalidateRender();
+}
+
+void VirtualListContainer::setRowCount(int count) {
+    count = std::max(0, count);
+    if (count == rowCount_) return;
+    rowCount_ = count;
+    rebuildOffsets();
+    invalidateLayout();
+    invalidateRender();
+}
+
+void VirtualListContainer::setRowHeight(int height) {
+    rowHeightFunction_ = nullptr;
+    rowHeight_ = std::max(1, height);
+    rebuildOffsets();
+    invalidateLayout();
+    invalidateRender();
+}
+
+void VirtualListContainer::setRowHeightFunction(RowHeightFunction rowHeight) {
+    rowHeightFunction_ = std::move(rowHeight);
+    rebuildOffsets();
+    invalidateLayout();
+    invalidateRender();
+}
+
+void VirtualListContainer::setSpacing(int spacing) {
+    spacing = std::max(0, spacing);
+    if (spacing == spacing_) return;
+    spacing_ = spacing;
+    layout_ = LayoutFactory::vertical(spacing_);
+    rebuildOffsets();
+    invalidateLayout();
+    invalidateRender();
+}
+
+void VirtualListContainer::setOverscan(int rows) {
+    overscan_ = std::max(0, rows);
+    invalidateLayout();
+}
+
+void VirtualListContainer::refreshRows() {
+    rebuildOffsets();
+    rebindAll_ = true;
+    invalidateLayout();
+    invalidateRender();
+}
+
+void VirtualListContainer::refreshRow(int row) {
+    auto component = getRowComponent(row);
+    if (!component) return;
+    if (binder_) {
+        binder_(*component, row);
+    }
+    // The height may have changed with the data
+    if (rowHeightFunction_) {
+        rebuildOffsets();
+        invalidateLayout();
+    }
+}
+
+void VirtualListContainer::setScrollOffset(int offset) {
+    int clamped = std::max(0, std::min(offset, getMaxScroll()));
+    if (clamped == scrollOffset_) return;
+    scrollOffset_ = clamped;
+    invalidateLayout();
+    invalidateRender();
+}
+
+int VirtualListContainer::getMaxScroll() const {
+    return std::max(0, getContentHeight() - height_);
+}
+
+int VirtualListContainer::getContentHeight() const {
+    if (rowCount_ == 0) return 0;
+    return getRowTop(rowCount_) - spacing_;
+}
+
+void VirtualListContainer::scrollToRow(int row) {
+    if (row < 0 || row >= rowCount_) return;
+    int top = getRowTop(row);
+    int bottom = top + getRowHeight(row);
+    if (top < scrollOffset_) {
+        setScrollOffset(top);
+    } else if (bottom > scrollOffset_ + height_) {
+        setScrollOffset(bottom - height_);
+    }
+}
+
+int VirtualListContainer::getRowTop(int row) const {
+    row = std::max(0, std::min(row, rowCount_));
+    if (rowHeightFunction_) {
+        return rowOffsets_[row];
+    }
+    return row * (rowHeight_ + spacing_);
+}
+
+int VirtualListContainer::getRowHeight(int row) const {
+    if (row < 0 || row >= rowCount_) return 0;
+    if (rowHeightFunction_) {
+        return rowOffsets_[row + 1] - rowOffsets_[row] - spacing_;
+    }
+    return rowHeight_;
+}
+
+int VirtualListContainer::getRowAt(int y) const {
+    if (rowCount_ == 0 || y < y_ || y > y_ + height_) return -1;
+
+    int contentY = y - y_ + scrollOffset_;
+    if (contentY >= getContentHeight()) return -1;
+    int row = rowAtContentY(contentY);
+    // Points in the spacing between rows belong to no row
+    return contentY < getRowTop(row) + getRowHeight(row) ? row : -1;
+}
+
+std::shared_ptr<UIComponent> VirtualListContainer::getRowComponent(int row) const {
+    int index = row - firstBound_;
+    if (index < 0 || index >= static_cast<int>(bound_.size())) return nullptr;
+    return bound_[index];
+}
+
+void VirtualListContainer::layout() {
+    // Rows may have been removed since the scroll offset was set
+    scrollOffset_ = std::max(0, std::min(scrollOffset_, getMaxScroll()));
+
+    if (!factory_ || rowCount_ == 0 || height_ <= 0) {
+        bindRows(0, 0);
+        return;
+    }
+
+    int first = rowAtContentY(scrollOffset_);
+    int last = rowAtContentY(scrollOffset_ + height_ - 1);
+    bindRows(std::max(0, first - overscan_), std::min(rowCount_, last + 1 + overscan_));
+    if (bound_.empty()) return;
+
+    // Rows take their height from the list, then stack from the first bound row's offset
+    for (size_t i = 0; i < bound_.size(); ++i) {
+        bound_[i]->setSize(width_, getRowHeight(firstBound_ + static_cast<int>(i)));
+    }
+    layout_->layoutChildren(bound_, x_, y_ + getRowTop(firstBound_) - scrollOffset_, width_, height_);
+
+    // Rows moved by the layout lay out again at their final rect
+    for (auto& row : bound_) {
+        row->updateLayout();
+    }
+}
+
+void VirtualListContainer::render() {
+    ClipState clip;
+    if (!pushClipRect({x_, y_, width_, height_}, clip)) return;
+
+    // Overscan rows and rows outside a partial redraw are skipped
+    for (auto& row : bound_) {
+        SDL_Rect bounds = row->getRenderBounds();
+        if (row->isVisible() && SDL_HasIntersection(&bounds, &clip.visible)) {
+            row->render();
+        }
+    }
+
+    popClipRect(clip);
+}
+
+void VirtualListContainer::handleEvent(const SDL_Event& event) {
+    // Handle scroll wheel
+    if (event.type == SDL_MOUSEWHEEL) {
+        setScrollOffset(scrollOffset_ - event.wheel.y * 10);
+    }
+
+    // Forward events to rows in view
+    SDL_Rect view = {x_, y_, width_, height_};
+    for (size_t i = 0; i < bound_.size(); ++i) {
+        SDL_Rect rect = bound_[i]->getRect();
+        if (SDL_HasIntersection(&rect, &view)) {
+            bound_[i]->handleEvent(event);
+        }
+    }
+}
+
+std::shared_ptr<UIComponent> VirtualListContainer::hitTest(int x, int y) const {
+    if (x < x_ || x > x_ + width_ || y < y_ || y > y_ + height_) {
+        return nullptr;
+    }
+
+    // Bound rows never overlap, so the row under the point is the only candidate
+    int row = getRowAt(y);
+    auto component = getRowComponent(row);
+    if (component && component->isPointInside(x, y)) {
+        return component;
+    }
+    return nullptr;
+}
+
+void VirtualListContainer::rebuildOffsets() {
+    rowOffsets_.clear();
+    if (!rowHeightFunction_) return;
+
+    rowOffsets_.reserve(rowCount_ + 1);
+    int top = 0;
+    for (int row = 0; row < rowCount_; ++row) {
+        rowOffsets_.push_back(top);
+        top += std::max(1, rowHeightFunction_(row)) + spacing_;
+    }
+    rowOffsets_.push_back(top);
+}
+
+int VirtualListContainer::rowAtContentY(int contentY) const {
+    if (rowCount_ == 0) return 0;
+    int row;
+    if (rowHeightFunction_) {
+        // Last row starting at or above contentY
+        auto it = std::upper_bound(rowOffsets_.begin(), rowOffsets_.end() - 1, contentY);
+        row = static_cast<int>(it - rowOffsets_.begin()) - 1;
+    } else {
+        row = contentY >= 0 ? contentY / (rowHeight_ + spacing_) : 0;
+    }
+    return std::max(0, std::min(row, rowCount_ - 1));
+}
+
+void VirtualListContainer::bindRows(int first, int end) {
+    end = std::max(first, end);
+    std::vector<std::shared_ptr<UIComponent>> next(end - first);
+
+    // Rows still in range keep their component and data; the rest return to the pool
+    for (size_t i = 0; i < bound_.size(); ++i) {
+        int row = firstBound_ + static_cast<int>(i);
+        if (!rebindAll_ && row >= first && row < end) {
+            next[row - first] = std::move(bound_[i]);
+        } else {
+            spare_.push_back(std::move(bound_[i]));
+        }
+    }
+    rebindAll_ = false;
+
+    for (int row = first; row < end; ++row) {
+        auto& component = next[row - first];
+        if (component) continue;
+
+        if (!spare_.empty()) {
+            component = std::move(spare_.back());
+            spare_.pop_back();
+        } else {
+            component = factory_();
+            if (!component) {
+                std::cerr << "VirtualListContainer: row factory returned no component" << std::endl;
+                // Bound rows must stay contiguous, so the range ends here
+                for (size_t i = row - first + 1; i < next.size(); ++i) {
+                    if (next[i]) spare_.push_back(std::move(next[i]));
+                }
+                next.resize(row - first);
+                break;
+            }
+            component->setParent(this);
+        }
+        if (binder_) {
+            binder_(*component, row);
+        }
+    }
+
+    bound_ = std::move(next);
+    firstBound_ = first;
+}
+
+void VirtualListContainer::releaseRows() {
+    for (auto* pool : {&bound_, &spare_}) {
+        for (auto& component : *pool) {
+            if (component && component->getParent() == this) {
+                component->setParent(nullptr);
+            }
+        }
+        pool->clear();
+    }
+    firstBound_ = 0;
+}
@@ -0,0 +1,314 @@
+#include "Systems/GlyphAtlas.h"
+#include "UIConstants.h"
+#include <algorithm>
+#include <iostream>
+
+GlyphAtlas::GlyphAtlas(SDL_Renderer* renderer) : renderer_(renderer) {
+}
+
+GlyphAtlas::~GlyphAtlas() {
+    clear();
+}
+
+bool GlyphAtlas::drawText(TTF_Font* font, const std::string& text, int x, int y, SDL_Color color) {
+    if (!queueText(font, text, x, y, color)) {
+        return false;
+    }
+    return flush();
+}
+
+bool GlyphAtlas::queueText(TTF_Font* font, const std::string& text, int x, int y, SDL_Color color) {
+    if (!renderer_ || !font || !geometrySupported_) return false;
+    if (text.empty()) return true;
+
+    FontAtlas& atlas = fonts_[font];
+
+    // Remember batch sizes so a failed glyph does not leave half a string queued
+    std::vector<std::pair<size_t, size_t>> rollback;
+    rollback.reserve(activeBatches_);
+    for (size_t i = 0; i < activeBatches_; ++i) {
+        rollback.emplace_back(batches_[i].vertices.size(), batches_[i].indices.size());
+    }
+    size_t batchCount = activeBatches_;
+
+    const float invPage = 1.0f / static_cast<float>(UIConstants::GLYPH_ATLAS_PAGE_SIZE);
+    int penX = x;
+    Uint32 previous = 0;
+    size_t index = 0;
+
+    while (index < text.size()) {
+        Uint32 codepoint = decodeUTF8(text, index);
+        const Glyph* glyph = getGlyph(font, atlas, codepoint);
+        if (!glyph) {
+            for (size_t i = 0; i < batchCount; ++i) {
+                batches_[i].vertices.resize(rollback[i].first);
+                batches_[i].indices.resize(rollback[i].second);
+            }
+            for (size_t i = batchCount; i < activeBatches_; ++i) {
+                batches_[i].vertices.clear();
+                batches_[i].indices.clear();
+            }
+            activeBatches_ = batchCount;
+            return false;
+        }
+
+        if (previous != 0) {
+            penX += TTF_GetFontKerningSizeGlyphs32(font, previous, codepoint);
+        }
+        previous = codepoint;
+
+        if (glyph->page >= 0) {
+            Batch& batch = getBatch(atlas.pages[glyph->page].texture);
+            int base = static_cast<int>(batch.vertices.size());
+
+            float left = static_cast<float>(penX);
+            float top = static_cast<float>(y);
+            float right = left + glyph->src.w;
+            float bottom = top + glyph->src.h;
+            float u0 = glyph->src.x * invPage;
+            float v0 = glyph->src.y * invPage;
+            float u1 = (glyph->src.x + glyph->src.w) * invPage;
+            float v1 = (glyph->src.y + glyph->src.h) * invPage;
+
+            batch.vertices.push_back({{left, top}, color, {u0, v0}});
+            batch.vertices.push_back({{right, top}, color, {u1, v0}});
+            batch.vertices.push_back({{right, bottom}, color, {u1, v1}});
+            batch.vertices.push_back({{left, bottom}, color, {u0, v1}});
+
+            batch.indices.push_back(base);
+            batch.indices.push_back(base + 1);
+            batch.indices.push_back(base + 2);
+            batch.indices.push_back(base);
+            batch.indices.push_back(base + 2);
+            batch.indices.push_back(base + 3);
+        }
+
+        penX += glyph->advance;
+    }
+
+    return true;
+}
+
+bool GlyphAtlas::flush() {
+    bool success = true;
+
+    for (size_t i = 0; i < activeBatches_; ++i) {
+        Batch& batch = batches_[i];
+        if (!batch.indices.empty() && success) {
+            if (SDL_RenderGeometry(renderer_, batch.texture,
+                                   batch.vertices.data(), static_cast<int>(batch.vertices.size()),
+                                   batch.indices.data(), static_cast<int>(batch.indices.size())) < 0) {
+                // Renderer cannot draw textured geometry - disable the atlas for good
+                std::cerr << "Glyph atlas disabled: " << SDL_GetError() << std::endl;
+                geometrySupported_ = false;
+                success = false;
+            }
+        }
+        // Keep vector capacity for the next frame
+        batch.vertices.clear();
+        batch.indices.clear();
+        batch.texture = nullptr;
+    }
+    activeBatches_ = 0;
+
+    return success;
+}
+
+void GlyphAtlas::releaseFont(TTF_Font* font) {
+    auto it = fonts_.find(font);
+    if (it == fonts_.end()) return;
+
+    flush();
+    for (auto& page : it->second.pages) {
+        if (page.texture) SDL_DestroyTexture(page.texture);
+    }
+    fonts_.erase(it);
+}
+
+void GlyphAtlas::clear() {
+    // Pending quads reference page textures, drop them before destroying the pages
+    for (auto& batch : batches_) {
+        batch.vertices.clear();
+        batch.indices.clear();
+        batch.texture = nullptr;
+    }
+    activeBatches_ = 0;
+
+    for (auto& [font, atlas] : fonts_) {
+        for (auto& page : atlas.pages) {
+            if (page.texture) SDL_DestroyTexture(page.texture);
+        }
+    }
+    fonts_.clear();
+}
+
+int GlyphAtlas::getPageCount() const {
+    int count = 0;
+    for (const auto& [font, atlas] : fonts_) {
+        count += static_cast<int>(atlas.pages.size());
+    }
+    return count;
+}
+
+int GlyphAtlas::getGlyphCount() const {
+    int count = 0;
+    for (const auto& [font, atlas] : fonts_) {
+        count += static_cast<int>(atlas.glyphs.size());
+    }
+    return count;
+}
+
+const GlyphAtlas::Glyph* GlyphAtlas::getGlyph(TTF_Font* font, FontAtlas& atlas, Uint32 codepoint) {
+    auto it = atlas.glyphs.find(codepoint);
+    if (it != atlas.glyphs.end()) {
+        return &it->second;
+    }
+
+    Glyph glyph;
+    if (!rasterizeGlyph(font, atlas, codepoint, glyph)) {
+        return nullptr;
+    }
+    return &atlas.glyphs.emplace(codepoint, glyph).first->second;
+}
+
+bool GlyphAtlas::rasterizeGlyph(TTF_Font* font, FontAtlas& atlas, Uint32 codepoint, Glyph& glyph) {
+    int minX, maxX, minY, maxY, advance;
+    if (TTF_GlyphMetrics32(font, codepoint, &minX, &maxX, &minY, &maxY, &advance) < 0) {
+        return false;
+    }
+    glyph.advance = advance;
+
+    // Whitespace only moves the pen
+    if (codepoint == ' ' || codepoint == '\t' || codepoint == '\n' || codepoint == '\r') {
+        return true;
+    }
+
+    // Rendered white so vertex colors can tint it; the surface spans the full font
+    // height with the glyph at its baseline offset, exactly as in a rendered string
+    SDL_Surface* surface = TTF_RenderGlyph32_Blended(font, codepoint, {255, 255, 255, 255});
+    if (!surface) {
+        std::cerr << "Glyph rasterization failed: " << TTF_GetError() << std::endl;
+        return false;
+    }
+
+    if (surface->format->format != SDL_PIXELFORMAT_ARGB8888) {
+        SDL_Surface* converted = SDL_ConvertSurfaceFormat(surface, SDL_PIXELFORMAT_ARGB8888, 0);
+        SDL_FreeSurface(surface);
+        if (!converted) {
+            std::cerr << "Glyph conversion failed: " << SDL_GetError() << std::endl;
+            return false;
+        }
+        surface = converted;
+    }
+
+    int page;
+    SDL_Rect region;
+    if (!allocateRegion(atlas, surface->w, surface->h, page, region)) {
+        SDL_FreeSurface(surface);
+        return false;
+    }
+
+    if (SDL_UpdateTexture(atlas.pages[page].texture, &region, surface->pixels, surface->pitch) < 0) {
+        std::cerr << "Glyph upload failed: " << SDL_GetError() << std::endl;
+        SDL_FreeSurface(surface);
+        return false;
+    }
+    SDL_FreeSurface(surface);
+
+    glyph.src = region;
+    glyph.page = page;
+    return true;
+}
+
+bool GlyphAtlas::allocateRegion(FontAtlas& atlas, int width, int height, int& page, SDL_Rect& region) {
+    const int pageSize = UIConstants::GLYPH_ATLAS_PAGE_SIZE;
+    const int padding = 1; // Keeps linear filtering from bleeding neighbouring glyphs
+
+    if (width + padding > pageSize || height + padding > pageSize) {
+        return false;
+    }
+
+    if (atlas.pages.empty() && !addPage(atlas)) {
+        return false;
+    }
+
+    // Shelf packing: fill rows left to right, open a new shelf or page when full
+    Page* current = &atlas.pages.back();
+    if (current->shelfX + width + padding > pageSize) {
+        current->shelfY += current->shelfHeight;
+        current->shelfX = 0;
+        current->shelfHeight = 0;
+    }
+    if (current->shelfY + height + padding > pageSize) {
+        if (!addPage(atlas)) {
+            return false;
+        }
+        current = &atlas.pages.back();
+    }
+
+    region = {current->shelfX, current->shelfY, width, height};
+    current->shelfX += width + padding;
+    current->shelfHeight = std::max(current->shelfHeight, height + padding);
+    page = static_cast<int>(atlas.pages.size()) - 1;
+    return true;
+}
+
+bool GlyphAtlas::addPage(FontAtlas& atlas) {
+    const int pageSize = UIConstants::GLYPH_ATLAS_PAGE_SIZE;
+
+    SDL_Texture* texture = SDL_CreateTexture(renderer_, SDL_PIXELFORMAT_ARGB8888,
+                                             SDL_TEXTUREACCESS_STATIC, pageSize, pageSize);
+    if (!texture) {
+        std::cerr << "Glyph atlas page creation failed: " << SDL_GetError() << std::endl;
+        return false;
+    }
+
+    // Static textures start undefined - clear to fully transparent once
+    std::vector<Uint32> blank(static_cast<size_t>(pageSize) * pageSize, 0);
+    SDL_UpdateTexture(texture, nullptr, blank.data(), pageSize * static_cast<int>(sizeof(Uint32)));
+    SDL_SetTextureBlendMode(texture, SDL_BLENDMODE_BLEND);
+
+    Page page;
+    page.texture = texture;
+    atlas.pages.push_back(page);
+    return true;
+}
+
+GlyphAtlas::Batch& GlyphAtlas::getBatch(SDL_Texture* texture) {
+    for (size_t i = 0; i < activeBatches_; ++i) {
+        if (batches_[i].texture == texture) {
+            return batches_[i];
+        }
+    }
+
+    if (activeBatches_ == batches_.size()) {
+        batches_.emplace_back();
+    }
+    Batch& batch = batches_[activeBatches_++];
+    batch.texture = texture;
+    return batch;
+}
+
+Uint32 GlyphAtlas::decodeUTF8(const std::string& text, size_t& index) {
+    const Uint32 replacement = 0xFFFD;
+    unsigned char lead = static_cast<unsigned char>(text[index++]);
+
+    if (lead < 0x80) return lead;
+
+    int extra;
+    Uint32 codepoint;
+    if ((lead & 0xE0) == 0xC0) { extra = 1; codepoint = lead & 0x1F; }
+    else if ((lead & 0xF0) == 0xE0) { extra = 2; codepoint = lead & 0x0F; }
+    else if ((lead & 0xF8) == 0xF0) { extra = 3; codepoint = lead & 0x07; }
+    else return replacement;
+
+    for (int i = 0; i < extra; ++i) {
+        if (index >= text.size()) return replacement;
+        unsigned char next = static_cast<unsigned char>(text[index]);
+        if ((next & 0xC0) != 0x80) return replacement;
+        codepoint = (codepoint << 6) | (next & 0x3F);
+        ++index;
+    }
+
+    return codepoint;
+}
@@ -1,4 +1,5 @@
 #include "Systems/SDLManager.h"
+#include "Systems/GlyphAtlas.h"
 #include <stdexcept>
 
 SDLManager::SDLManager() {
@@ -32,6 +33,7 @@ void SDLManager::init() {
     if (!font) {
         throw std::runtime_error("Font loading failed: " + std::string(TTF_GetError()));
     }
+    glyphAtlas = std::make_unique<GlyphAtlas>(renderer);
     
     initialized = true;
 }
@@ -45,6 +47,8 @@ void SDLManager::cleanup() {
     // NOTE: Avoid double free of font
     // if (font) TTF_CloseFont(font);
     // TTF_Quit();
+    // Atlas pages are renderer textures - release them while the renderer is alive
+    glyphAtlas.reset();
     if (renderer) SDL_DestroyRenderer(renderer);
     if (window) SDL_DestroyWindow(window);
     SDL_Quit();
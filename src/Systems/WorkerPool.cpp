@@ -0,0 +1,105 @@
+#include "Systems/WorkerPool.h"
+#include <algorithm>
+
+WorkerPool::WorkerPool(int threadCount) {
+    if (threadCount <= 0) {
+        threadCount = std::max(1, static_cast<int>(std::thread::hardware_concurrency())) - 1;
+    }
+
+    threads_.reserve(threadCount);
+    for (int i = 0; i < threadCount; ++i) {
+        // Worker 0 is the calling thread
+        threads_.emplace_back(&WorkerPool::workerLoop, this, i + 1);
+    }
+}
+
+WorkerPool::~WorkerPool() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stopping_ = true;
+    }
+    wakeCondition_.notify_all();
+    for (auto& thread : threads_) {
+        thread.join();
+    }
+}
+
+WorkerPool& WorkerPool::shared() {
+    static WorkerPool pool;
+    return pool;
+}
+
+void WorkerPool::parallelFor(int count, const std::function<void(int, int)>& task) {
+    if (count <= 0) return;
+
+    // Small jobs or no workers: run inline
+    if (threads_.empty() || count == 1) {
+        for (int i = 0; i < count; ++i) {
+            task(i, 0);
+        }
+        return;
+    }
+
+    std::lock_guard<std::mutex> submitLock(submitMutex_);
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        task_ = &task;
+        count_ = count;
+        nextItem_.store(0);
+        busyWorkers_ = static_cast<int>(threads_.size());
+        error_ = nullptr;
+        ++jobGeneration_;
+    }
+    wakeCondition_.notify_all();
+
+    runItems(0);
+
+    std::exception_ptr error;
+    {
+        std::unique_lock<std::mutex> lock(mutex_);
+        doneCondition_.wait(lock, [this] { return busyWorkers_ == 0; });
+        task_ = nullptr;
+        error = error_;
+    }
+
+    if (error) {
+        std::rethrow_exception(error);
+    }
+}
+
+void WorkerPool::workerLoop(int workerIndex) {
+    unsigned seenGeneration = 0;
+
+    while (true) {
+        {
+            std::unique_lock<std::mutex> lock(mutex_);
+            wakeCondition_.wait(lock, [&] { return stopping_ || jobGeneration_ != seenGeneration; });
+            if (stopping_) return;
+            seenGeneration = jobGeneration_;
+        }
+
+        runItems(workerIndex);
+
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            if (--busyWorkers_ == 0) {
+                doneCondition_.notify_one();
+            }
+        }
+    }
+}
+
+void WorkerPool::runItems(int workerIndex) {
+    while (true) {
+        int item = nextItem_.fetch_add(1);
+        if (item >= count_) return;
+
+        try {
+            (*task_)(item, workerIndex);
+        } catch (...) {
+            std::lock_guard<std::mutex> lock(mutex_);
+            if (!error_) error_ = std::current_exception();
+            nextItem_.store(count_); // Stop handing out work
+        }
+    }
+}
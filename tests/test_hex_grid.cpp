@@ -0,0 +1,1169 @@
+#include <catch2/catch.hpp>
+#include "Interface/ui/HexGrid.h"
+#include "Interface/ui/HexMapFile.h"
+#include "Interface/ui/HexPathHierarchy.h"
+#include "Interface/ui/HexVisibility.h"
+#include "Systems/WorkerPool.h"
+#include <algorithm>
+#include <climits>
+#include <cstdio>
+#include <fstream>
+#include <random>
+#include <sstream>
+
+TEST_CASE("HexGrid dense tile storage", "[HexGrid]") {
+    HexGrid grid(7, 5);
+
+    SECTION("Tiles are stored row-major in offset order") {
+        REQUIRE(grid.getTileCount() == 35);
+
+        for (int row = 0; row < grid.getHeight(); ++row) {
+            for (int col = 0; col < grid.getWidth(); ++col) {
+                HexCoordinate coord = HexCoordinate::fromOffset(col, row);
+                int index = grid.getTileIndex(coord);
+                REQUIRE(index == row * grid.getWidth() + col);
+                REQUIRE(grid.getCoordinateAt(index) == coord);
+                REQUIRE(grid.getTile(coord) == grid.getTileByIndex(index));
+            }
+        }
+    }
+
+    SECTION("Coordinates outside the grid have no index") {
+        REQUIRE(grid.getTileIndex(HexCoordinate::fromOffset(-1, 0)) == -1);
+        REQUIRE(grid.getTileIndex(HexCoordinate::fromOffset(7, 0)) == -1);
+        REQUIRE(grid.getTileIndex(HexCoordinate::fromOffset(0, 5)) == -1);
+        REQUIRE(grid.getTileIndex(HexCoordinate(1, 1, 1)) == -1); // Not a cube coordinate
+        REQUIRE(grid.getTile(HexCoordinate::fromOffset(0, -1)) == nullptr);
+        REQUIRE_FALSE(grid.isValidCoordinate(HexCoordinate::fromOffset(10, 10)));
+    }
+
+    SECTION("Neighbor table matches HexCoordinate::getNeighbor") {
+        for (int index = 0; index < grid.getTileCount(); ++index) {
+            const HexCoordinate& coord = grid.getCoordinateAt(index);
+            for (int direction = 0; direction < 6; ++direction) {
+                REQUIRE(grid.getNeighborIndex(index, direction) ==
+                        grid.getTileIndex(coord.getNeighbor(direction)));
+            }
+        }
+    }
+
+    SECTION("Tile pointers stay stable across modifications") {
+        HexCoordinate coord = HexCoordinate::fromOffset(3, 2);
+        HexTile* tile = grid.getTile(coord);
+
+        grid.setTerrain(coord, TerrainType::FOREST);
+        grid.setTerrainArea(grid.getCoordinatesInRadius(coord, 2), TerrainType::SWAMP);
+        grid.clear();
+
+        REQUIRE(grid.getTile(coord) == tile);
+    }
+
+    SECTION("setTile keeps the tile at its grid coordinate") {
+        HexCoordinate coord = HexCoordinate::fromOffset(2, 2);
+        grid.setTile(coord, HexTile(HexCoordinate(0, 0, 0), TerrainType::MOUNTAIN));
+
+        REQUIRE(grid.getTile(coord)->getTerrainType() == TerrainType::MOUNTAIN);
+        REQUIRE(grid.getTile(coord)->getCoordinate() == coord);
+    }
+
+    SECTION("Resize rebuilds storage") {
+        grid.resize(4, 3);
+        REQUIRE(grid.getTileCount() == 12);
+        REQUIRE(grid.getAllCoordinates().size() == 12);
+        REQUIRE_FALSE(grid.isValidCoordinate(HexCoordinate::fromOffset(5, 0)));
+    }
+}
+
+TEST_CASE("HexGrid pathfinding on dense storage", "[HexGrid]") {
+    HexGrid grid(10, 10);
+
+    SECTION("Straight path on open plains") {
+        HexCoordinate start = HexCoordinate::fromOffset(0, 0);
+        HexCoordinate goal = HexCoordinate::fromOffset(5, 0);
+
+        PathfindingResult result = grid.findPath(start, goal);
+        REQUIRE(result.pathFound);
+        REQUIRE(result.path.front() == start);
+        REQUIRE(result.path.back() == goal);
+        REQUIRE(result.totalCost == 5);
+    }
+
+    SECTION("Path routes around impassable terrain") {
+        for (int row = 0; row < 9; ++row) {
+            grid.setTerrain(HexCoordinate::fromOffset(4, row), TerrainType::RIVER);
+        }
+
+        PathfindingResult result = grid.findPath(HexCoordinate::fromOffset(0, 0),
+                                                 HexCoordinate::fromOffset(8, 0));
+        REQUIRE(result.pathFound);
+        for (const HexCoordinate& step : result.path) {
+            REQUIRE(grid.getTile(step)->isPassable());
+        }
+    }
+
+    SECTION("Movement range respects movement points and terrain") {
+        HexCoordinate center = HexCoordinate::fromOffset(5, 5);
+        MovementRange range = grid.calculateMovementRange(center, 2);
+
+        REQUIRE(range.getCostToReach(center) == 0);
+        REQUIRE(range.reachableTiles.size() == grid.getCoordinatesInRadius(center, 2).size());
+
+        grid.setTerrainArea(grid.getNeighbors(center), TerrainType::FOREST);
+        MovementRange forest = grid.calculateMovementRange(center, 2);
+        REQUIRE(forest.reachableTiles.size() == 7); // Center plus six forest tiles at cost 2
+    }
+}
+
+TEST_CASE("HexGrid hot tile arrays stay in sync", "[HexGrid]") {
+    HexGrid grid(8, 8);
+    HexCoordinate coord = HexCoordinate::fromOffset(3, 3);
+    int index = grid.getTileIndex(coord);
+
+    SECTION("Terrain changes update packed terrain, cost and flags") {
+        grid.setTerrain(coord, TerrainType::FOREST);
+        REQUIRE(grid.getTerrainAt(index) == TerrainType::FOREST);
+        REQUIRE(grid.getMovementCostAt(index) == grid.getTile(coord)->getMovementCost());
+        REQUIRE(grid.blocksLineOfSightAt(index) == grid.getTile(coord)->blocksLineOfSight());
+
+        grid.setTerrainArea({coord}, TerrainType::RIVER);
+        REQUIRE_FALSE(grid.isPassableAt(index));
+
+        grid.buildBridge(coord);
+        REQUIRE(grid.getTerrainAt(index) == grid.getTile(coord)->getTerrainType());
+        REQUIRE(grid.isPassableAt(index) == grid.getTile(coord)->isPassable());
+    }
+
+    SECTION("Height and occupancy go through grid mutators") {
+        grid.setHeight(coord, 2);
+        REQUIRE(grid.getHeightAt(index) == 2);
+
+        grid.setHeightArea({coord}, 7);
+        REQUIRE(grid.getHeightAt(index) == 3); // Clamped like HexTile::setHeight
+
+        grid.setOccupant(coord, "legion");
+        REQUIRE(grid.isOccupiedAt(index));
+        REQUIRE_FALSE(grid.findPath(HexCoordinate::fromOffset(0, 0), coord).pathFound);
+
+        grid.setOccupant(coord, "");
+        REQUIRE_FALSE(grid.isOccupiedAt(index));
+    }
+
+    SECTION("refreshTile picks up direct tile edits") {
+        grid.getTile(coord)->setTerrainType(TerrainType::MOUNTAIN);
+        grid.refreshTile(coord);
+        REQUIRE(grid.getTerrainAt(index) == TerrainType::MOUNTAIN);
+        REQUIRE(grid.getMovementCostAt(index) == 3);
+    }
+
+    SECTION("Step cost matches HexTileUtils") {
+        HexCoordinate neighbor = coord.getNeighbor(0);
+        grid.setTerrain(neighbor, TerrainType::SWAMP);
+        grid.setHeight(neighbor, 2);
+
+        int expected = HexTileUtils::calculateMovementCost(*grid.getTile(coord), *grid.getTile(neighbor));
+        REQUIRE(grid.getStepCost(index, grid.getTileIndex(neighbor)) == expected);
+    }
+
+    SECTION("Battlefield setups keep arrays in sync") {
+        grid.setupTeutobergBattlefield();
+        for (int i = 0; i < grid.getTileCount(); ++i) {
+            REQUIRE(grid.getTerrainAt(i) == grid.getTileByIndex(i)->getTerrainType());
+            REQUIRE(grid.isPassableAt(i) == grid.getTileByIndex(i)->isPassable());
+        }
+    }
+}
+
+TEST_CASE("HexGrid workspace pathfinding", "[HexGrid][Pathfinding]") {
+    HexGrid grid(12, 12);
+    grid.setupTeutobergBattlefield();
+    for (int row = 2; row < 10; ++row) {
+        grid.setTerrain(HexCoordinate::fromOffset(6, row), TerrainType::RIVER);
+    }
+
+    PathfindingWorkspace workspace;
+    PathfindingResult result;
+
+    SECTION("Matches the legacy API for every start/goal pair in a row") {
+        for (int col = 0; col < grid.getWidth(); ++col) {
+            HexCoordinate start = HexCoordinate::fromOffset(0, 3);
+            HexCoordinate goal = HexCoordinate::fromOffset(col, 8);
+
+            PathfindingResult legacy = grid.findPath(start, goal);
+            bool found = grid.findPath(start, goal, workspace, result);
+
+            REQUIRE(found == legacy.pathFound);
+            REQUIRE(result.totalCost == legacy.totalCost);
+            if (found) {
+                REQUIRE(result.path.front() == start);
+                REQUIRE(result.path.back() == goal);
+            }
+        }
+    }
+
+    SECTION("Custom predicates are honoured") {
+        HexCoordinate start = HexCoordinate::fromOffset(0, 6);
+        HexCoordinate goal = HexCoordinate::fromOffset(11, 6);
+
+        REQUIRE(grid.findPath(start, goal, workspace, result));
+        REQUIRE_FALSE(grid.findPath(start, goal, workspace, result,
+                                    [](const HexTile& tile) { return tile.getTerrainType() != TerrainType::ROAD; }));
+        REQUIRE(result.path.empty());
+    }
+
+    SECTION("A workspace can be reused across grids of different sizes") {
+        HexGrid small(3, 3);
+        REQUIRE(small.findPath(HexCoordinate::fromOffset(0, 0), HexCoordinate::fromOffset(2, 2), workspace, result));
+        REQUIRE(grid.findPath(HexCoordinate::fromOffset(0, 0), HexCoordinate::fromOffset(11, 11), workspace, result));
+        REQUIRE(result.path.back() == HexCoordinate::fromOffset(11, 11));
+    }
+
+    SECTION("Start equals goal") {
+        HexCoordinate start = HexCoordinate::fromOffset(4, 4);
+        REQUIRE(grid.findPath(start, start, workspace, result));
+        REQUIRE(result.path.size() == 1);
+        REQUIRE(result.totalCost == 0);
+    }
+}
+
+TEST_CASE("HexGrid batched movement ranges", "[HexGrid][Pathfinding]") {
+    HexGrid grid(20, 16);
+    grid.setupCannaeBattlefield();
+    grid.setTerrainArea(grid.getCoordinatesInRadius(HexCoordinate::fromOffset(12, 8), 2), TerrainType::FOREST);
+    grid.setOccupant(HexCoordinate::fromOffset(5, 5), "hastati");
+
+    std::vector<MovementRequest> requests;
+    for (int i = 0; i < 40; ++i) {
+        MovementRequest request;
+        request.start = HexCoordinate::fromOffset((i * 7) % 20, (i * 3) % 16);
+        request.movementPoints = 2 + i % 5;
+        if (i % 4 == 0) {
+            request.isPassable = [](const HexTile& tile) { return tile.getTerrainType() != TerrainType::FOREST; };
+        }
+        requests.push_back(request);
+    }
+
+    WorkerPool pool(3);
+    std::vector<MovementField> results = grid.calculateMovementRanges(requests, &pool);
+    REQUIRE(results.size() == requests.size());
+
+    for (size_t i = 0; i < requests.size(); ++i) {
+        const MovementRequest& request = requests[i];
+        const MovementField& field = results[i];
+        MovementRange expected = grid.calculateMovementRange(request.start, request.movementPoints,
+                                                             request.isPassable);
+
+        REQUIRE(field.startIndex == grid.getTileIndex(request.start));
+        REQUIRE(field.size() == static_cast<int>(expected.reachableTiles.size()));
+        REQUIRE(std::is_sorted(field.tiles.begin(), field.tiles.end()));
+
+        for (const auto& [coord, cost] : expected.reachableTiles) {
+            int index = grid.getTileIndex(coord);
+            REQUIRE(field.canReach(index));
+            REQUIRE(field.getCostToReach(index) == cost);
+        }
+    }
+
+    SECTION("Unreached tiles report no cost") {
+        const MovementField& field = results[1];
+        int farIndex = grid.getTileIndex(HexCoordinate::fromOffset(19, 15));
+        if (!field.canReach(farIndex)) {
+            REQUIRE(field.getCostToReach(farIndex) == -1);
+        }
+        REQUIRE_FALSE(field.canReach(-1));
+        REQUIRE_FALSE(field.canReach(grid.getTileCount() + 64));
+    }
+
+    SECTION("Results can be reused for a second batch") {
+        requests.resize(5);
+        grid.calculateMovementRanges(requests, results, &pool);
+        REQUIRE(results.size() == 5);
+    }
+}
+
+TEST_CASE("HexGrid bucket queue movement ranges", "[HexGrid][Pathfinding]") {
+    HexGrid grid(24, 18);
+    PathfindingWorkspace workspace;
+    MovementField heapField;
+    MovementField bucketField;
+
+    SECTION("Max step cost tracks passable terrain") {
+        REQUIRE(grid.getMaxStepCost(true) == 1 + 3);
+        grid.setTerrain(HexCoordinate::fromOffset(2, 2), TerrainType::MOUNTAIN);
+        REQUIRE(grid.getMaxStepCost(true) == 3 + 3);
+        grid.setTerrain(HexCoordinate::fromOffset(3, 3), TerrainType::RIVER);
+        REQUIRE(grid.getMaxStepCost(true) == 3 + 3);  // Rivers are impassable
+        REQUIRE(grid.getMaxStepCost(false) == 99 + 3);
+        grid.setTerrain(HexCoordinate::fromOffset(3, 3), TerrainType::PLAIN);
+        REQUIRE(grid.getMaxStepCost(false) == 3 + 3);
+    }
+
+    SECTION("Bucket and heap queues agree on historical battlefields") {
+        void (HexGrid::*setups[])() = {
+            &HexGrid::setupCannaeBattlefield,
+            &HexGrid::setupAlesiaBattlefield,
+            &HexGrid::setupTeutobergBattlefield
+        };
+
+        for (auto setup : setups) {
+            (grid.*setup)();
+            grid.setHeightArea(grid.getCoordinatesInRadius(HexCoordinate::fromOffset(6, 6), 3), 2);
+
+            for (int index = 0; index < grid.getTileCount(); index += 17) {
+                const HexCoordinate& start = grid.getCoordinateAt(index);
+
+                grid.setSearchQueue(HexGrid::SearchQueue::BinaryHeap);
+                grid.calculateMovementRange(start, 12, workspace, heapField);
+                grid.setSearchQueue(HexGrid::SearchQueue::BucketQueue);
+                grid.calculateMovementRange(start, 12, workspace, bucketField);
+
+                REQUIRE(heapField.tiles == bucketField.tiles);
+                REQUIRE(heapField.costs == bucketField.costs);
+            }
+        }
+    }
+
+    SECTION("Custom predicates crossing expensive terrain") {
+        grid.setupCannaeBattlefield();
+        auto cavalry = [](const HexTile&) { return true; }; // Fords the river at full cost
+
+        HexCoordinate start = HexCoordinate::fromOffset(1, 5);
+        grid.setSearchQueue(HexGrid::SearchQueue::BinaryHeap);
+        grid.calculateMovementRange(start, 120, workspace, heapField, cavalry);
+        grid.setSearchQueue(HexGrid::SearchQueue::BucketQueue);
+        grid.calculateMovementRange(start, 120, workspace, bucketField, cavalry);
+
+        REQUIRE(heapField.costs == bucketField.costs);
+        REQUIRE(bucketField.canReach(grid.getTileIndex(HexCoordinate::fromOffset(0, 5))));
+    }
+}
+
+TEST_CASE("HexGrid field of view and line of sight", "[HexGrid][Visibility]") {
+    HexGrid grid(21, 21);
+    HexCoordinate origin = HexCoordinate::fromOffset(10, 10);
+
+    auto contains = [](const std::vector<HexCoordinate>& coords, const HexCoordinate& coord) {
+        return std::find(coords.begin(), coords.end(), coord) != coords.end();
+    };
+
+    SECTION("Open terrain sees every hex in range") {
+        std::vector<HexCoordinate> fov = grid.computeFieldOfView(origin, 5);
+        REQUIRE(fov.size() == grid.getCoordinatesInRadius(origin, 5).size());
+        REQUIRE(fov.front() == origin);
+
+        std::vector<HexCoordinate> attack = grid.calculateAttackRange(origin, 5);
+        REQUIRE(attack.size() == fov.size() - 1);
+        REQUIRE_FALSE(contains(attack, origin));
+    }
+
+    SECTION("Blockers are visible but shadow the hexes behind them") {
+        for (int direction = 0; direction < 6; ++direction) {
+            HexGrid fresh(21, 21);
+            HexCoordinate blocker = origin.getNeighbor(direction);
+            fresh.setTerrain(blocker, TerrainType::FOREST);
+            REQUIRE(fresh.getTile(blocker)->blocksLineOfSight());
+
+            std::vector<HexCoordinate> fov = fresh.computeFieldOfView(origin, 6);
+            REQUIRE(contains(fov, blocker));
+            for (int distance = 2; distance <= 6; ++distance) {
+                HexCoordinate behind = origin;
+                for (int i = 0; i < distance; ++i) behind = behind.getNeighbor(direction);
+                REQUIRE_FALSE(contains(fov, behind));
+                REQUIRE_FALSE(fresh.hasLineOfSight(origin, behind));
+            }
+
+            // Hexes off to the side stay visible
+            REQUIRE(contains(fov, origin.getNeighbor((direction + 2) % 6).getNeighbor((direction + 2) % 6)));
+        }
+    }
+
+    SECTION("A line between two hexes is blocked only when both block") {
+        HexCoordinate left = origin.getNeighbor(4);
+        HexCoordinate right = origin.getNeighbor(5);
+        HexCoordinate target = left.getNeighbor(5);
+
+        grid.setTerrain(left, TerrainType::FOREST);
+        REQUIRE(grid.hasLineOfSight(origin, target));
+        REQUIRE(contains(grid.computeFieldOfView(origin, 2), target));
+
+        grid.setTerrain(right, TerrainType::FOREST);
+        REQUIRE_FALSE(grid.hasLineOfSight(origin, target));
+        REQUIRE_FALSE(contains(grid.computeFieldOfView(origin, 2), target));
+    }
+
+    SECTION("A ring of blockers hides everything beyond it") {
+        for (const HexCoordinate& coord : grid.getCoordinatesInRadius(origin, 1)) {
+            if (coord != origin) grid.setTerrain(coord, TerrainType::FOREST);
+        }
+        REQUIRE(grid.computeFieldOfView(origin, 8).size() == 7);
+    }
+
+    SECTION("Field of view clips to the grid") {
+        HexCoordinate corner = HexCoordinate::fromOffset(0, 0);
+        std::vector<HexCoordinate> fov = grid.computeFieldOfView(corner, 3);
+        REQUIRE(fov.size() == grid.getCoordinatesInRadius(corner, 3).size());
+        REQUIRE(grid.computeFieldOfView(HexCoordinate::fromOffset(-5, 0), 3).empty());
+    }
+
+    SECTION("Field of view agrees with line of sight on random maps") {
+        std::mt19937 rng(7);
+        std::uniform_int_distribution<int> percent(0, 99);
+        for (int map = 0; map < 20; ++map) {
+            HexGrid forest(30, 30);
+            for (int row = 0; row < 30; ++row) {
+                for (int col = 0; col < 30; ++col) {
+                    if (percent(rng) < 15) {
+                        forest.setTerrain(HexCoordinate::fromOffset(col, row), TerrainType::FOREST);
+                    }
+                }
+            }
+            HexCoordinate observer = HexCoordinate::fromOffset(percent(rng) % 30, percent(rng) % 30);
+            int range = 4 + map % 12;
+            std::vector<HexCoordinate> fov = forest.computeFieldOfView(observer, range);
+            for (const HexCoordinate& coord : forest.getCoordinatesInRadius(observer, range)) {
+                if (!forest.isValidCoordinate(coord)) continue;
+                REQUIRE(contains(fov, coord) == forest.hasLineOfSight(observer, coord));
+            }
+        }
+    }
+
+    SECTION("Cache is invalidated only when blocking changes") {
+        grid.setVisibilityCacheEnabled(true);
+        REQUIRE(grid.isVisibilityCacheEnabled());
+
+        HexCoordinate target = origin.getNeighbor(0).getNeighbor(0);
+        uint64_t revision = grid.getLineOfSightRevision();
+        REQUIRE(grid.hasLineOfSight(origin, target));
+        size_t openCount = grid.computeFieldOfView(origin, 4).size();
+
+        grid.setHeight(origin.getNeighbor(0), 2);          // Does not affect blocking
+        REQUIRE(grid.getLineOfSightRevision() == revision);
+
+        grid.setTerrain(origin.getNeighbor(0), TerrainType::FOREST);
+        REQUIRE(grid.getLineOfSightRevision() != revision);
+        REQUIRE_FALSE(grid.hasLineOfSight(origin, target));
+        REQUIRE(grid.computeFieldOfView(origin, 4).size() < openCount);
+
+        grid.destroyStructure(origin.getNeighbor(0));
+        grid.setTerrain(origin.getNeighbor(0), TerrainType::PLAIN);
+        REQUIRE(grid.hasLineOfSight(origin, target));
+        REQUIRE(grid.computeFieldOfView(origin, 4).size() == openCount);
+
+        grid.setVisibilityCacheEnabled(false);
+        REQUIRE_FALSE(grid.isVisibilityCacheEnabled());
+    }
+}
+
+TEST_CASE("HexVisibilityMap faction fog of war", "[HexGrid][Visibility]") {
+    HexGrid grid(30, 30);
+    WorkerPool pool(3);
+    HexVisibilityMap fog(grid);
+
+    std::vector<VisibilityObserver> observers = {
+        {1, HexCoordinate::fromOffset(5, 5), 4},
+        {2, HexCoordinate::fromOffset(8, 6), 3},
+        {3, HexCoordinate::fromOffset(20, 22), 5},
+    };
+    for (int col = 12; col < 18; ++col) {
+        grid.setTerrain(HexCoordinate::fromOffset(col, 20), TerrainType::MOUNTAIN);
+    }
+
+    // Reference: union of per-observer FOVs
+    auto expectUnion = [&](const std::vector<VisibilityObserver>& expected) {
+        std::vector<int> counts(grid.getTileCount(), 0);
+        std::vector<int> visible;
+        for (const VisibilityObserver& observer : expected) {
+            grid.computeFieldOfView(observer.position, observer.sightRange, visible);
+            for (int index : visible) ++counts[index];
+        }
+        int visibleCount = 0;
+        bool matches = true;
+        for (int index = 0; index < grid.getTileCount(); ++index) {
+            visibleCount += counts[index] > 0;
+            matches = matches && fog.isVisible(index) == (counts[index] > 0)
+                              && fog.getObserverCount(index) == counts[index];
+        }
+        REQUIRE(matches);
+        REQUIRE(fog.getVisibleCount() == visibleCount);
+    };
+
+    fog.setObservers(observers, &pool);
+    expectUnion(observers);
+    REQUIRE(fog.isVisible(observers[2].position));
+    REQUIRE_FALSE(fog.isVisible(HexCoordinate::fromOffset(29, 0)));
+
+    SECTION("Moving one unit updates only its contribution") {
+        fog.moveObserver(2, HexCoordinate::fromOffset(25, 3));
+        observers[1].position = HexCoordinate::fromOffset(25, 3);
+        expectUnion(observers);
+        REQUIRE(fog.isVisible(HexCoordinate::fromOffset(25, 3)));
+    }
+
+    SECTION("Adding and removing observers") {
+        VisibilityObserver scout{4, HexCoordinate::fromOffset(28, 28), 2};
+        fog.addObserver(scout);
+        observers.push_back(scout);
+        expectUnion(observers);
+
+        fog.removeObserver(1);
+        observers.erase(observers.begin());
+        expectUnion(observers);
+
+        fog.removeObserver(99); // Unknown ids are ignored
+        expectUnion(observers);
+    }
+
+    SECTION("Terrain changes are picked up by update") {
+        REQUIRE_FALSE(fog.update(&pool));
+        grid.setTerrain(HexCoordinate::fromOffset(6, 5), TerrainType::FOREST);
+        REQUIRE(fog.update(&pool));
+        expectUnion(observers);
+    }
+
+    SECTION("Observer changes after a resize use the new layout") {
+        grid.resize(12, 40);
+        observers[0].position = HexCoordinate::fromOffset(2, 35);
+        fog.moveObserver(1, observers[0].position);
+        observers.erase(observers.begin() + 2);
+        fog.removeObserver(3);
+        expectUnion(observers);
+
+        grid.resize(50, 8);
+        VisibilityObserver scout{4, HexCoordinate::fromOffset(45, 6), 3};
+        fog.addObserver(scout);
+        observers = {scout};
+        fog.removeObserver(1);
+        fog.removeObserver(2);
+        expectUnion(observers);
+        REQUIRE_FALSE(fog.update(&pool));
+    }
+
+    SECTION("Visibility is written back to the tiles") {
+        fog.applyToGrid(grid);
+        REQUIRE(grid.getTile(observers[0].position)->isVisible());
+        REQUIRE_FALSE(grid.getTile(HexCoordinate::fromOffset(29, 0))->isVisible());
+    }
+}
+
+TEST_CASE("HexGrid change notifications", "[HexGrid]") {
+    HexGrid grid(8, 8);
+    std::vector<std::pair<int, uint8_t>> changes;
+    int listener = grid.addChangeListener([&](int index, uint8_t kind) { changes.emplace_back(index, kind); });
+
+    HexCoordinate coord = HexCoordinate::fromOffset(3, 4);
+    int index = grid.getTileIndex(coord);
+
+    grid.setTerrain(coord, TerrainType::FOREST);
+    REQUIRE(changes.size() == 1);
+    REQUIRE(changes[0].first == index);
+    REQUIRE(changes[0].second & HexGrid::CHANGE_TERRAIN);
+    REQUIRE(changes[0].second & HexGrid::CHANGE_FLAGS); // Forest blocks line of sight
+
+    grid.setTerrain(coord, TerrainType::FOREST); // No change, no notification
+    REQUIRE(changes.size() == 1);
+
+    grid.setHeight(coord, 2);
+    REQUIRE(changes.back().second == HexGrid::CHANGE_HEIGHT);
+
+    grid.setOccupant(coord, "legio_x");
+    REQUIRE(changes.back().second == (HexGrid::CHANGE_FLAGS | HexGrid::CHANGE_OCCUPANT));
+
+    grid.setOccupant(coord, "legio_ix"); // Same occupancy, different unit
+    REQUIRE(changes.back().second == HexGrid::CHANGE_OCCUPANT);
+
+    grid.resize(10, 10);
+    REQUIRE(changes.back().first == -1);
+    REQUIRE(changes.back().second == HexGrid::CHANGE_LAYOUT);
+
+    size_t count = changes.size();
+    grid.removeChangeListener(listener);
+    grid.setTerrain(coord, TerrainType::RIVER);
+    REQUIRE(changes.size() == count);
+}
+
+TEST_CASE("HexGrid change journal", "[HexGrid]") {
+    HexGrid grid(8, 8);
+    std::vector<HexGrid::TileChangeRecord> changes;
+    int cursor = grid.openChangeCursor();
+
+    HexCoordinate river = HexCoordinate::fromOffset(2, 2);
+    HexCoordinate field = HexCoordinate::fromOffset(5, 6);
+    grid.setTerrain(river, TerrainType::RIVER);
+
+    SECTION("Changes are merged per tile in first-change order") {
+        grid.setHeightArea(grid.getCoordinatesInRadius(field, 1), 2);
+        grid.buildBridge(river);
+        grid.setOccupant(field, "legio_x");
+
+        REQUIRE(grid.drainChanges(cursor, changes));
+        REQUIRE(changes.size() == 8);   // River plus the 7 tiles of the raised area
+        REQUIRE(changes[0].index == grid.getTileIndex(river));
+        REQUIRE(changes[0].changes & HexGrid::CHANGE_TERRAIN);
+
+        auto fieldRecord = std::find_if(changes.begin(), changes.end(), [&](const HexGrid::TileChangeRecord& record) {
+            return record.index == grid.getTileIndex(field);
+        });
+        REQUIRE(fieldRecord != changes.end());
+        REQUIRE(fieldRecord->changes == (HexGrid::CHANGE_HEIGHT | HexGrid::CHANGE_FLAGS | HexGrid::CHANGE_OCCUPANT));
+
+        REQUIRE(grid.drainChanges(cursor, changes));
+        REQUIRE(changes.empty());
+    }
+
+    SECTION("Each cursor sees every change once") {
+        REQUIRE(grid.drainChanges(cursor, changes));
+        int second = grid.openChangeCursor();
+
+        grid.buildFortification(field);
+        REQUIRE(grid.drainChanges(second, changes));
+        REQUIRE(changes.size() == 1);
+
+        grid.destroyStructure(field);
+        grid.setHeight(field, 3);
+        REQUIRE(grid.drainChanges(second, changes));
+        REQUIRE(changes.size() == 1);
+        REQUIRE(changes[0].changes == (HexGrid::CHANGE_TERRAIN | HexGrid::CHANGE_FLAGS | HexGrid::CHANGE_HEIGHT));
+
+        // The first cursor missed both drains and gets a single merged record
+        REQUIRE(grid.drainChanges(cursor, changes));
+        REQUIRE(changes.size() == 1);
+        REQUIRE(changes[0].index == grid.getTileIndex(field));
+        REQUIRE(changes[0].changes & HexGrid::CHANGE_HEIGHT);
+        grid.closeChangeCursor(second);
+    }
+
+    SECTION("Resizing or falling behind requires a rescan") {
+        grid.resize(6, 6);
+        REQUIRE_FALSE(grid.drainChanges(cursor, changes));
+        REQUIRE(grid.drainChanges(cursor, changes));
+        REQUIRE(changes.empty());
+
+        int idle = grid.openChangeCursor();
+        for (int round = 0; round < 100; ++round) {
+            for (int index = 0; index < grid.getTileCount(); ++index) {
+                grid.setHeight(grid.getCoordinateAt(index), round % 2);
+            }
+            REQUIRE(grid.drainChanges(cursor, changes));
+        }
+        REQUIRE(changes.size() == static_cast<size_t>(grid.getTileCount()));
+        REQUIRE_FALSE(grid.drainChanges(idle, changes));
+        REQUIRE(grid.drainChanges(idle, changes));
+        REQUIRE(changes.empty());
+    }
+
+    SECTION("Closed cursors stop receiving changes") {
+        grid.closeChangeCursor(cursor);
+        grid.setHeight(field, 1);
+        REQUIRE_FALSE(grid.drainChanges(cursor, changes));
+    }
+}
+
+TEST_CASE("HexGrid tracked highlights", "[HexGrid]") {
+    HexGrid grid(8, 8);
+    grid.highlightFormation({HexCoordinate::fromOffset(1, 1), HexCoordinate::fromOffset(2, 1)}, {255, 0, 0, 255});
+    grid.setHighlight(grid.getTileIndex(HexCoordinate::fromOffset(1, 1)), {0, 255, 0, 255});
+
+    REQUIRE(grid.getHighlightedTiles().size() == 2);
+    REQUIRE(grid.getTile(HexCoordinate::fromOffset(1, 1))->getHighlightColor().g == 255);
+
+    grid.clearHighlights();
+    REQUIRE(grid.getHighlightedTiles().empty());
+    for (int index = 0; index < grid.getTileCount(); ++index) {
+        REQUIRE_FALSE(grid.getTileByIndex(index)->isHighlighted());
+    }
+
+    // Highlights copied in with a tile, or set on a tile and refreshed, are cleared too
+    HexTile copied(HexCoordinate(), TerrainType::PLAIN);
+    copied.setHighlighted(true);
+    grid.setTile(HexCoordinate::fromOffset(3, 3), copied);
+    grid.getTile(HexCoordinate::fromOffset(4, 4))->setHighlighted(true);
+    grid.refreshTile(HexCoordinate::fromOffset(4, 4));
+    grid.setTerrain(HexCoordinate::fromOffset(4, 4), TerrainType::FOREST);
+    REQUIRE(grid.getHighlightedTiles().size() == 2);
+
+    grid.clearHighlights();
+    REQUIRE_FALSE(grid.getTile(HexCoordinate::fromOffset(3, 3))->isHighlighted());
+    REQUIRE_FALSE(grid.getTile(HexCoordinate::fromOffset(4, 4))->isHighlighted());
+}
+
+namespace {
+// Reference statistics by scanning tiles, for checking the incremental counters
+HexGrid::GridStatistics scanStatistics(const HexGrid& grid, int minCol, int minRow, int maxCol, int maxRow) {
+    HexGrid::GridStatistics stats;
+    for (int index = 0; index < grid.getTileCount(); ++index) {
+        int col, row;
+        grid.getCoordinateAt(index).toOffset(col, row);
+        if (col < minCol || col > maxCol || row < minRow || row > maxRow) continue;
+
+        const HexTile* tile = grid.getTileByIndex(index);
+        stats.totalTiles++;
+        stats.terrainCounts[tile->getTerrainType()]++;
+        if (!tile->isPassable()) stats.impassableTiles++;
+        if (tile->canBuild()) stats.buildableTiles++;
+        if (tile->isSupplyPoint()) stats.supplyPoints++;
+    }
+    return stats;
+}
+
+void requireSameStatistics(const HexGrid::GridStatistics& actual, const HexGrid::GridStatistics& expected) {
+    REQUIRE(actual.totalTiles == expected.totalTiles);
+    REQUIRE(actual.terrainCounts == expected.terrainCounts);
+    REQUIRE(actual.impassableTiles == expected.impassableTiles);
+    REQUIRE(actual.buildableTiles == expected.buildableTiles);
+    REQUIRE(actual.supplyPoints == expected.supplyPoints);
+}
+}
+
+TEST_CASE("HexGrid incremental statistics", "[HexGrid]") {
+    HexGrid grid(40, 35);
+    requireSameStatistics(grid.getStatistics(), scanStatistics(grid, 0, 0, 39, 34));
+
+    grid.setupAlesiaBattlefield();
+    grid.setTerrainArea(grid.getCoordinatesInRadius(HexCoordinate::fromOffset(30, 20), 4), TerrainType::CAMP);
+    grid.buildFortification(HexCoordinate::fromOffset(5, 5));
+    grid.setOccupant(HexCoordinate::fromOffset(31, 20), "legio_x");
+    requireSameStatistics(grid.getStatistics(), scanStatistics(grid, 0, 0, 39, 34));
+
+    SECTION("Region statistics match a scan across chunk boundaries") {
+        requireSameStatistics(grid.getStatistics(3, 7, 33, 20), scanStatistics(grid, 3, 7, 33, 20));
+        requireSameStatistics(grid.getStatistics(16, 16, 31, 31), scanStatistics(grid, 16, 16, 31, 31));
+        requireSameStatistics(grid.getStatistics(-5, -5, 100, 100), grid.getStatistics());
+        REQUIRE(grid.getStatistics(20, 10, 19, 10).totalTiles == 0);
+    }
+
+    SECTION("Resizing resets the counters") {
+        grid.resize(12, 9);
+        HexGrid::GridStatistics stats = grid.getStatistics();
+        REQUIRE(stats.totalTiles == 108);
+        REQUIRE(stats.terrainCounts.size() == 1);
+        REQUIRE(stats.terrainCounts[TerrainType::PLAIN] == 108);
+        requireSameStatistics(stats, scanStatistics(grid, 0, 0, 11, 8));
+    }
+}
+
+TEST_CASE("HexGrid binary map format", "[HexGrid][Serialization]") {
+    const std::string filename = "test_hex_grid_map.hexmap";
+    HexGrid grid(33, 21);
+    grid.setupCannaeBattlefield();
+    grid.buildFortification(HexCoordinate::fromOffset(4, 4));
+    grid.setOccupant(HexCoordinate::fromOffset(10, 10), "legio_x");
+
+    HexTile* tagged = grid.getTile(HexCoordinate::fromOffset(7, 3));
+    tagged->getProperties().specialTag = "consul_tent";
+    tagged->getProperties().defensiveBonus = 15;
+    TileEvent event;
+    event.eventId = "ambush";
+    event.triggerCondition = "unit_enter";
+    event.action = "spawn_enemy";
+    event.parameters["count"] = "3";
+    tagged->addEvent(event);
+    grid.refreshTile(tagged->getCoordinate());
+
+    REQUIRE(grid.saveBinary(filename));
+
+    SECTION("Heights saturate at the packed range") {
+        REQUIRE(HexMapFormat::packHeight(3) == 3);
+        REQUIRE(HexMapFormat::packHeight(200) == 127);
+        REQUIRE(HexMapFormat::packHeight(-300) == -128);
+    }
+
+    SECTION("Packed arrays are readable in place") {
+        HexMapView map;
+        REQUIRE(map.open(filename));
+        REQUIRE(map.getWidth() == 33);
+        REQUIRE(map.getHeight() == 21);
+        for (int index = 0; index < grid.getTileCount(); ++index) {
+            REQUIRE(map.getTerrain()[index] == grid.getTerrainAt(index));
+            REQUIRE(map.getHeights()[index] == grid.getHeightAt(index));
+            REQUIRE(map.getFlags()[index] == grid.getTileFlags(index));
+            REQUIRE(map.getMovementCosts()[index] == grid.getMovementCostAt(index));
+        }
+    }
+
+    SECTION("Loading restores tiles and side-table data") {
+        HexGrid loaded(1, 1);
+        REQUIRE(loaded.loadBinary(filename));
+        REQUIRE(loaded.getWidth() == 33);
+        REQUIRE(loaded.toJSON() == grid.toJSON());
+
+        const HexTile* tile = loaded.getTile(HexCoordinate::fromOffset(7, 3));
+        REQUIRE(tile->getProperties().specialTag == "consul_tent");
+        REQUIRE(tile->getDefensiveBonus() == 15);
+        REQUIRE(tile->getEvents().size() == 1);
+        REQUIRE(tile->getEvents()[0].parameters.at("count") == "3");
+        REQUIRE(loaded.getTile(HexCoordinate::fromOffset(10, 10))->getOccupantId() == "legio_x");
+
+        for (int index = 0; index < grid.getTileCount(); ++index) {
+            REQUIRE(loaded.getTileFlags(index) == grid.getTileFlags(index));
+        }
+        REQUIRE(loaded.getStatistics().impassableTiles == grid.getStatistics().impassableTiles);
+    }
+
+    SECTION("JSON round-trips through the binary form") {
+        HexGrid fromJson(1, 1);
+        fromJson.fromJSON(grid.toJSON());
+        REQUIRE(fromJson.toJSON() == grid.toJSON());
+
+        REQUIRE(fromJson.saveBinary(filename));
+        HexGrid fromBinary(1, 1);
+        REQUIRE(fromBinary.loadBinary(filename));
+        REQUIRE(fromBinary.toJSON() == grid.toJSON());
+    }
+
+    SECTION("Invalid files are rejected and leave the grid unchanged") {
+        {
+            std::ofstream file(filename, std::ios::binary | std::ios::trunc);
+            file << "{\"width\":2}";
+        }
+        HexGrid target(4, 4);
+        std::string error;
+        REQUIRE_FALSE(target.loadBinary(filename, &error));
+        REQUIRE_FALSE(error.empty());
+        REQUIRE(target.getWidth() == 4);
+        REQUIRE_FALSE(target.loadBinary("missing_hex_grid_map.hexmap"));
+    }
+
+    std::remove(filename.c_str());
+}
+
+TEST_CASE("HexGrid streaming JSON", "[HexGrid][Serialization]") {
+    HexGrid grid(12, 9);
+    grid.setupAlesiaBattlefield();
+    grid.setOccupant(HexCoordinate::fromOffset(2, 2), "legio_x");
+
+    HexTile* tagged = grid.getTile(HexCoordinate::fromOffset(5, 4));
+    tagged->getProperties().specialTag = "the \"consul's\" tent\n";
+    tagged->getProperties().evasionBonus = 7;
+    tagged->getProperties().rangedAccuracyPenalty = 4;
+    tagged->getProperties().destructible = true;
+    TileEvent event;
+    event.eventId = "relief";
+    event.triggerCondition = "turn_5";
+    event.action = "spawn_enemy";
+    event.turnDelay = 2;
+    event.parameters["side"] = "north";
+    tagged->addEvent(event);
+    grid.refreshTile(tagged->getCoordinate());
+
+    SECTION("Stream round trip keeps every tile field") {
+        std::stringstream stream;
+        grid.writeJSON(stream);
+        REQUIRE(stream.str() == grid.toJSON());
+
+        HexGrid loaded(1, 1);
+        std::string error;
+        REQUIRE(loaded.readJSON(stream, &error));
+        REQUIRE(loaded.toJSON() == grid.toJSON());
+
+        const HexTile* tile = loaded.getTile(tagged->getCoordinate());
+        REQUIRE(tile->getProperties().specialTag == tagged->getProperties().specialTag);
+        REQUIRE(tile->getEvasionBonus() == 7);
+        REQUIRE(tile->getRangedAccuracyPenalty() == 4);
+        REQUIRE(tile->getProperties().destructible);
+        REQUIRE(tile->getEvents().size() == 1);
+        REQUIRE(tile->getEvents()[0].turnDelay == 2);
+        REQUIRE(tile->getEvents()[0].parameters.at("side") == "north");
+        REQUIRE(loaded.getTile(HexCoordinate::fromOffset(2, 2))->getOccupantId() == "legio_x");
+        for (int index = 0; index < grid.getTileCount(); ++index) {
+            REQUIRE(loaded.getTileFlags(index) == grid.getTileFlags(index));
+        }
+    }
+
+    SECTION("Tile keys may come in any order") {
+        HexTile tile = HexTile::fromJSON(
+            "{\"movementCost\":5,\"specialTag\":\"ford\",\"terrain\":3,\"x\":1,\"y\":-1,\"z\":0,\"passable\":true}");
+        REQUIRE(tile.getCoordinate() == HexCoordinate(1, -1, 0));
+        REQUIRE(tile.getTerrainType() == TerrainType::RIVER);
+        REQUIRE(tile.isPassable());
+        REQUIRE(tile.getMovementCost() == 5);
+        REQUIRE(tile.getProperties().specialTag == "ford");
+
+        REQUIRE(HexTile::fromJSON(tagged->toJSON()).toJSON() == tagged->toJSON());
+    }
+
+    SECTION("Malformed documents are reported") {
+        std::string error;
+        std::istringstream truncated(grid.toJSON().substr(0, 200));
+        HexGrid target(3, 3);
+        target.setTerrain(HexCoordinate::fromOffset(1, 1), TerrainType::FOREST);
+        REQUIRE_FALSE(target.readJSON(truncated, &error));
+        REQUIRE_FALSE(error.empty());
+        REQUIRE(target.getWidth() == 3);     // Failed loads leave the grid unchanged
+        REQUIRE(target.getTile(HexCoordinate::fromOffset(1, 1))->getTerrainType() == TerrainType::FOREST);
+        REQUIRE(target.getTerrainAt(target.getTileIndex(HexCoordinate::fromOffset(1, 1))) == TerrainType::FOREST);
+
+        std::istringstream tilesFirst("{\"tiles\":[],\"width\":2,\"height\":2}");
+        HexGrid unchanged(3, 3);
+        REQUIRE_FALSE(unchanged.readJSON(tilesFirst, &error));
+        REQUIRE(unchanged.getWidth() == 3);
+
+        // Dimensions are bounded before any tiles are allocated
+        for (const char* json : {"{\"width\":70000,\"height\":70000,\"tiles\":[]}",
+                                 "{\"width\":5000,\"height\":5000,\"tiles\":[]}",
+                                 "{\"width\":0,\"height\":4,\"tiles\":[]}",
+                                 "{\"width\":-2,\"height\":4,\"tiles\":[]}",
+                                 "{\"width\":1e300,\"height\":-1e300,\"tiles\":[]}",
+                                 "{\"width\":18446744073709551615,\"height\":4,\"tiles\":[]}"}) {
+            std::istringstream invalid(json);
+            error.clear();
+            REQUIRE_FALSE(unchanged.readJSON(invalid, &error));
+            REQUIRE(error.find("invalid dimensions") != std::string::npos);
+            REQUIRE(unchanged.getWidth() == 3);
+        }
+
+        // Numbers no int can hold are clamped or rejected, never converted out of range
+        std::istringstream hugeTerrain("{\"width\":2,\"height\":2,\"tiles\":[{\"x\":0,\"y\":0,\"z\":0,\"terrain\":1e40}]}");
+        error.clear();
+        REQUIRE_FALSE(unchanged.readJSON(hugeTerrain, &error));
+        REQUIRE(error.find("unknown terrain type") != std::string::npos);
+        std::istringstream overflow("{\"width\":1e400,\"height\":4,\"tiles\":[]}");
+        error.clear();
+        REQUIRE_FALSE(unchanged.readJSON(overflow, &error));
+        REQUIRE_FALSE(error.empty());
+        REQUIRE(unchanged.getWidth() == 3);
+    }
+}
+
+TEST_CASE("HexPathHierarchy long-distance routes", "[HexGrid][Pathfinding]") {
+    HexGrid grid(64, 48);
+
+    auto requireValidPath = [&](const PathfindingResult& result, const HexCoordinate& start, const HexCoordinate& goal) {
+        REQUIRE(result.path.front() == start);
+        REQUIRE(result.path.back() == goal);
+        int cost = 0;
+        for (size_t step = 1; step < result.path.size(); ++step) {
+            REQUIRE(result.path[step - 1].distanceTo(result.path[step]) == 1);
+            int index = grid.getTileIndex(result.path[step]);
+            REQUIRE(grid.isPassableAt(index));
+            cost += grid.getStepCost(grid.getTileIndex(result.path[step - 1]), index);
+        }
+        REQUIRE(cost == result.totalCost);
+    };
+
+    SECTION("Routes match flat A* reachability and stay close to its cost") {
+        std::mt19937 rng(7);
+        std::uniform_int_distribution<int> terrainDist(0, 9);
+        const TerrainType terrains[] = {TerrainType::PLAIN, TerrainType::PLAIN, TerrainType::PLAIN, TerrainType::FOREST,
+                                        TerrainType::MOUNTAIN, TerrainType::SWAMP, TerrainType::ROAD,
+                                        TerrainType::RIVER, TerrainType::RIVER, TerrainType::CITY_WALL};
+        for (int index = 0; index < grid.getTileCount(); ++index) {
+            grid.setTerrain(grid.getCoordinateAt(index), terrains[terrainDist(rng)]);
+        }
+
+        HexPathHierarchy hierarchy(grid, 8);
+        REQUIRE(hierarchy.getClusterCount() == 48);
+        REQUIRE(hierarchy.getEntranceCount() > 0);
+
+        std::uniform_int_distribution<int> tileDist(0, grid.getTileCount() - 1);
+        long long flatTotal = 0, hierarchicalTotal = 0;
+        for (int query = 0; query < 200; ++query) {
+            HexCoordinate start = grid.getCoordinateAt(tileDist(rng));
+            HexCoordinate goal = grid.getCoordinateAt(tileDist(rng));
+
+            PathfindingResult flat = grid.findPath(start, goal);
+            PathfindingResult hierarchical = hierarchy.findPath(start, goal);
+            REQUIRE(hierarchical.pathFound == flat.pathFound);
+            if (!flat.pathFound) continue;
+
+            requireValidPath(hierarchical, start, goal);
+            REQUIRE(hierarchical.totalCost >= flat.totalCost);
+            flatTotal += flat.totalCost;
+            hierarchicalTotal += hierarchical.totalCost;
+        }
+        REQUIRE(flatTotal > 0);
+        REQUIRE(hierarchicalTotal <= flatTotal * 5 / 4);
+    }
+
+    SECTION("Lazy refinement rebuilds the same path segment by segment") {
+        HexPathHierarchy hierarchy(grid, 8);
+        HexCoordinate start = HexCoordinate::fromOffset(1, 1);
+        HexCoordinate goal = HexCoordinate::fromOffset(60, 45);
+
+        HexPathHierarchy::Route route;
+        REQUIRE(hierarchy.findRoute(start, goal, route));
+        REQUIRE(route.waypoints.size() > 2);
+
+        PathfindingResult refined;
+        refined.path.push_back(start);
+        for (int segment = 0; segment + 1 < static_cast<int>(route.waypoints.size()); ++segment) {
+            REQUIRE(hierarchy.refineSegment(route, segment, refined.path));
+        }
+        refined.totalCost = route.totalCost;
+        requireValidPath(refined, start, goal);
+        REQUIRE(refined.totalCost == grid.findPath(start, goal).totalCost);
+    }
+
+    SECTION("A unit on a cluster border can step straight into the next cluster") {
+        // The unit's own tile is occupied, and rivers close every way out inside its cluster
+        HexCoordinate start = HexCoordinate::fromOffset(7, 4);
+        int startIndex = grid.getTileIndex(start);
+        for (int direction = 0; direction < 6; ++direction) {
+            int neighbor = grid.getNeighborIndex(startIndex, direction);
+            if (neighbor % grid.getWidth() < 8) {
+                grid.setTerrain(grid.getCoordinateAt(neighbor), TerrainType::RIVER);
+            }
+        }
+        grid.setOccupant(start, "hastati");
+        HexPathHierarchy hierarchy(grid, 8);
+
+        for (HexCoordinate goal : {HexCoordinate::fromOffset(12, 4), HexCoordinate::fromOffset(40, 30)}) {
+            PathfindingResult flat = grid.findPath(start, goal);
+            PathfindingResult hierarchical = hierarchy.findPath(start, goal);
+            REQUIRE(flat.pathFound);
+            REQUIRE(hierarchical.pathFound);
+            requireValidPath(hierarchical, start, goal);
+            REQUIRE(hierarchical.totalCost >= flat.totalCost);
+        }
+        REQUIRE(hierarchy.findPath(start, HexCoordinate::fromOffset(12, 4)).totalCost ==
+                grid.findPath(start, HexCoordinate::fromOffset(12, 4)).totalCost);
+    }
+
+    SECTION("Bridges and destroyed structures repair only nearby clusters") {
+        for (int row = 0; row < grid.getHeight(); ++row) {
+            grid.setTerrain(HexCoordinate::fromOffset(30, row), TerrainType::RIVER);
+        }
+        HexPathHierarchy hierarchy(grid, 8);
+        HexCoordinate west = HexCoordinate::fromOffset(5, 5);
+        HexCoordinate east = HexCoordinate::fromOffset(58, 40);
+        REQUIRE_FALSE(hierarchy.findPath(west, east).pathFound);
+
+        int rebuilt = hierarchy.getRebuiltClusterCount();
+        HexCoordinate ford = HexCoordinate::fromOffset(30, 20);
+        grid.buildBridge(ford);
+        PathfindingResult bridged = hierarchy.findPath(west, east);
+        REQUIRE(bridged.pathFound);
+        REQUIRE(std::find(bridged.path.begin(), bridged.path.end(), ford) != bridged.path.end());
+        requireValidPath(bridged, west, east);
+        REQUIRE(hierarchy.getRebuiltClusterCount() - rebuilt <= 12);
+
+        grid.destroyStructure(ford);
+        REQUIRE_FALSE(hierarchy.findPath(west, east).pathFound);
+    }
+}
+
+TEST_CASE("HexGrid flow fields", "[HexGrid][Pathfinding]") {
+    HexGrid grid(20, 15);
+    grid.setupCannaeBattlefield();
+    for (int row = 2; row < 13; ++row) {
+        grid.setTerrain(HexCoordinate::fromOffset(9, row), TerrainType::RIVER);
+    }
+    grid.setHeight(HexCoordinate::fromOffset(4, 4), 3);
+    HexCoordinate goal = HexCoordinate::fromOffset(16, 7);
+
+    SECTION("Costs match A* and directions lead to the goal") {
+        FlowField field = grid.computeFlowField({goal});
+        int goalIndex = grid.getTileIndex(goal);
+        REQUIRE(field.goals == std::vector<int>{goalIndex});
+        REQUIRE(field.getCost(goalIndex) == 0);
+        REQUIRE(field.getDirection(goalIndex) == FlowField::NO_DIRECTION);
+
+        for (int index = 0; index < grid.getTileCount(); ++index) {
+            PathfindingResult path = grid.findPath(grid.getCoordinateAt(index), goal);
+            REQUIRE(field.canReach(index) == path.pathFound);
+            if (!path.pathFound) continue;
+            REQUIRE(field.getCost(index) == path.totalCost);
+
+            // Walk the directions and add up the step costs
+            int cost = 0;
+            int current = index;
+            while (current != goalIndex) {
+                int next = grid.getNeighborIndex(current, field.getDirection(current));
+                REQUIRE(next >= 0);
+                cost += grid.getStepCost(current, next);
+                current = next;
+            }
+            REQUIRE(cost == field.getCost(index));
+        }
+    }
+
+    SECTION("Several goals share one field") {
+        HexCoordinate other = HexCoordinate::fromOffset(2, 7);
+        FlowField field = grid.computeFlowField({goal, other, goal});
+        FlowField toGoal = grid.computeFlowField({goal});
+        FlowField toOther = grid.computeFlowField({other});
+        REQUIRE(field.goals.size() == 2);
+        for (int index = 0; index < grid.getTileCount(); ++index) {
+            int expected = std::min(toGoal.canReach(index) ? toGoal.getCost(index) : INT_MAX,
+                                    toOther.canReach(index) ? toOther.getCost(index) : INT_MAX);
+            REQUIRE(field.getCost(index) == (expected == INT_MAX ? FlowField::UNREACHABLE : expected));
+        }
+    }
+
+    SECTION("Cached fields last until movement costs change") {
+        std::shared_ptr<const FlowField> field = grid.getFlowField(goal);
+        REQUIRE(field);
+        REQUIRE(grid.getFlowField(goal) == field);
+        REQUIRE(grid.getFlowField(HexCoordinate::fromOffset(-1, 0)) == nullptr);
+
+        grid.setOccupant(HexCoordinate::fromOffset(3, 3), "legio_ix");
+        REQUIRE(grid.isFlowFieldCurrent(*field));
+        REQUIRE(grid.getFlowField(goal) == field);
+
+        grid.buildBridge(HexCoordinate::fromOffset(9, 7));
+        REQUIRE_FALSE(grid.isFlowFieldCurrent(*field));
+        std::shared_ptr<const FlowField> rebuilt = grid.getFlowField(goal);
+        REQUIRE(rebuilt != field);
+        int west = grid.getTileIndex(HexCoordinate::fromOffset(5, 7));
+        REQUIRE(rebuilt->getCost(west) < field->getCost(west));
+    }
+}
+
+TEST_CASE("HexGrid symmetry-reduced A* matches full expansion", "[HexGrid][Pathfinding]") {
+    std::mt19937 rng(2024);
+    std::uniform_int_distribution<int> percent(0, 99);
+    std::uniform_int_distribution<int> sizeDist(4, 32);
+    PathfindingWorkspace workspace;
+    PathfindingResult full, reduced;
+
+    // Random maps mixing uniform plains and roads with obstacles, rough patches, hills and units
+    for (int map = 0; map < 80; ++map) {
+        HexGrid grid(sizeDist(rng), sizeDist(rng));
+        int obstacles = percent(rng) % 35;
+        int rough = percent(rng) % 30;
+        int hills = percent(rng) % 20;
+        int units = percent(rng) % 10;
+        for (int index = 0; index < grid.getTileCount(); ++index) {
+            const HexCoordinate& coord = grid.getCoordinateAt(index);
+            int roll = percent(rng);
+            if (roll < obstacles) {
+                grid.setTerrain(coord, roll % 2 ? TerrainType::RIVER : TerrainType::CITY_WALL);
+            } else if (roll < obstacles + rough) {
+                grid.setTerrain(coord, roll % 2 ? TerrainType::FOREST : TerrainType::SWAMP);
+            } else {
+                grid.setTerrain(coord, roll % 2 ? TerrainType::ROAD : TerrainType::PLAIN);
+            }
+            if (percent(rng) < hills) grid.setHeight(coord, percent(rng) % 4);
+            if (percent(rng) < units) grid.setOccupant(coord, "legio_" + std::to_string(index));
+        }
+
+        std::uniform_int_distribution<int> tileDist(0, grid.getTileCount() - 1);
+        auto avoidForest = [](const HexTile& tile) {
+            return tile.isPassable() && tile.getTerrainType() != TerrainType::FOREST;
+        };
+        for (int query = 0; query < 40; ++query) {
+            HexCoordinate start = grid.getCoordinateAt(tileDist(rng));
+            HexCoordinate goal = grid.getCoordinateAt(tileDist(rng));
+
+            grid.setSymmetryReduction(false);
+            bool fullFound = grid.findPath(start, goal, workspace, full);
+            grid.setSymmetryReduction(true);
+            bool reducedFound = grid.findPath(start, goal, workspace, reduced);
+            REQUIRE(reducedFound == fullFound);
+            REQUIRE(reduced.totalCost == full.totalCost);
+
+            if (reducedFound) {
+                REQUIRE(reduced.path.front() == start);
+                REQUIRE(reduced.path.back() == goal);
+                for (size_t step = 1; step < reduced.path.size(); ++step) {
+                    REQUIRE(reduced.path[step - 1].distanceTo(reduced.path[step]) == 1);
+                }
+            }
+
+            grid.setSymmetryReduction(false);
+            fullFound = grid.findPath(start, goal, workspace, full, avoidForest);
+            grid.setSymmetryReduction(true);
+            reducedFound = grid.findPath(start, goal, workspace, reduced, avoidForest);
+            REQUIRE(reducedFound == fullFound);
+            REQUIRE(reduced.totalCost == full.totalCost);
+        }
+    }
+}
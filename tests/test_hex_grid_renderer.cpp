@@ -0,0 +1,229 @@
+#include <catch2/catch.hpp>
+#include "Interface/ui/HexGridRenderer.h"
+#include "Interface/ui/HexGridEditor.h"
+#include "Interface/ui/HexWorld.h"
+#include "Systems/SDLManager.h"
+#include <cmath>
+#include <cstdio>
+#include <fstream>
+
+// Mock SDLManager for testing
+class MockSDLManager : public SDLManager {
+public:
+    MockSDLManager() {}
+};
+
+namespace {
+// Reference culling: project every tile and test its bounding box against the component
+std::vector<HexCoordinate> scanVisibleTiles(const HexGridRenderer& renderer, const HexGrid& grid) {
+    float radius = renderer.getRenderConfig().hexSize * renderer.getRenderConfig().zoomLevel;
+    float halfWidth = std::sqrt(3.0f) / 2.0f * radius;
+
+    std::vector<HexCoordinate> visible;
+    for (const HexCoordinate& coord : grid.getAllCoordinates()) {
+        float x, y;
+        renderer.hexToScreen(coord, x, y);
+        if (x + halfWidth >= 0 && x - halfWidth <= renderer.getWidth() &&
+            y + radius >= 0 && y - radius <= renderer.getHeight()) {
+            visible.push_back(coord);
+        }
+    }
+    return visible;
+}
+}
+
+TEST_CASE("HexGridRenderer visible tile culling", "[HexGridRenderer]") {
+    MockSDLManager sdl;
+    auto grid = std::make_shared<HexGrid>(60, 45);
+    HexGridRenderer renderer(0, 0, 640, 480, sdl, grid);
+
+    SECTION("Matches a full scan across pan and zoom") {
+        const float zooms[] = {0.13f, 0.5f, 1.0f, 2.3f};
+        const float pans[][2] = {{17.3f, 11.1f}, {-913.7f, -402.9f}, {301.3f, -1207.7f}, {-5003.1f, 97.9f}};
+
+        for (float zoom : zooms) {
+            for (const auto& pan : pans) {
+                renderer.setZoom(zoom);
+                renderer.setPan(pan[0], pan[1]);
+                const auto& visible = renderer.getVisibleTiles();
+                REQUIRE(visible == scanVisibleTiles(renderer, *grid));
+
+                for (const HexCoordinate& coord : visible) {
+                    REQUIRE(renderer.isTileVisible(coord));
+                }
+            }
+        }
+    }
+
+    SECTION("Panned off the map shows nothing") {
+        renderer.setPan(100000.0f, 100000.0f);
+        REQUIRE(renderer.getVisibleTiles().empty());
+        REQUIRE_FALSE(renderer.isTileVisible(HexCoordinate::fromOffset(0, 0)));
+    }
+
+    SECTION("Cached until the view changes") {
+        renderer.setPan(-200.3f, -150.7f);
+        const auto* first = renderer.getVisibleTiles().data();
+        size_t count = renderer.getVisibleTiles().size();
+        REQUIRE(renderer.getVisibleTiles().data() == first);
+
+        renderer.setSize(1280, 960);
+        REQUIRE(renderer.getVisibleTiles().size() > count);
+        REQUIRE(renderer.getVisibleTiles() == scanVisibleTiles(renderer, *grid));
+    }
+
+    SECTION("Culling disabled returns the whole grid") {
+        renderer.getRenderConfig().enableCulling = false;
+        REQUIRE(renderer.getVisibleTiles().size() == static_cast<size_t>(grid->getTileCount()));
+    }
+}
+
+TEST_CASE("HexGridRenderer marker list follows the grid", "[HexGridRenderer]") {
+    MockSDLManager sdl;
+    auto grid = std::make_shared<HexGrid>(40, 30);
+    grid->setOccupant(HexCoordinate::fromOffset(7, 3), "legio_x");
+    HexGridRenderer renderer(0, 0, 640, 480, sdl, grid);
+    REQUIRE(renderer.getMarkerTiles() == std::vector<int>{3 * 40 + 7});
+
+    HexTile* supply = grid->getTile(HexCoordinate::fromOffset(2, 1));
+    supply->getProperties().supplyPoint = true;
+    grid->refreshTile(supply->getCoordinate());
+    grid->setOccupant(HexCoordinate::fromOffset(39, 29), "legio_ix");
+    grid->setOccupant(HexCoordinate::fromOffset(7, 3), "");
+    REQUIRE(renderer.getMarkerTiles() == std::vector<int>{1 * 40 + 2, 29 * 40 + 39});
+
+    grid->resize(10, 10);
+    REQUIRE(renderer.getMarkerTiles().empty());
+}
+
+TEST_CASE("HexOverviewLayer terrain image and mip chain", "[HexGridRenderer]") {
+    HexOverviewLayer overview;
+    overview.resize(5, 3);
+
+    REQUIRE(overview.getLevelWidth(0) == 11);
+    REQUIRE(overview.getLevelHeight(0) == 3);
+    REQUIRE(overview.getChunkCount() == 1);
+    REQUIRE(overview.getLevelWidth(overview.getLevelCount() - 1) == 1);
+    REQUIRE(overview.getLevelHeight(overview.getLevelCount() - 1) == 1);
+
+    const SDL_Color red = {200, 0, 0, 255};
+    const SDL_Color blue = {0, 0, 100, 255};
+    for (int row = 0; row < 3; ++row) {
+        for (int col = 0; col < 5; ++col) {
+            overview.setTileColor(col, row, red);
+        }
+    }
+    overview.updateMipmaps();
+
+    SECTION("Odd rows are shifted by one texel") {
+        REQUIRE(overview.getTexel(0, 0, 0).a == 255);
+        REQUIRE(overview.getTexel(0, 10, 0).a == 0);
+        REQUIRE(overview.getTexel(0, 0, 1).a == 0);
+        REQUIRE(overview.getTexel(0, 10, 1).a == 255);
+    }
+
+    SECTION("Transparent edges do not darken minified colors") {
+        SDL_Color texel = overview.getTexel(1, 0, 0);
+        REQUIRE(texel.r == 200);
+        REQUIRE(texel.a == 191); // Three of four source texels are opaque
+    }
+
+    SECTION("Single tile updates propagate through every level") {
+        overview.setTileColor(0, 0, blue);
+        REQUIRE(overview.getTexel(0, 1, 0).b == 100);
+
+        SDL_Color parent = overview.getTexel(1, 0, 0);
+        REQUIRE(parent.b > 0);
+        REQUIRE(parent.r < 200);
+
+        SDL_Color top = overview.getTexel(overview.getLevelCount() - 1, 0, 0);
+        REQUIRE(top.b > 0);
+        REQUIRE(top.r > top.b);
+    }
+
+    SECTION("Level selection keeps texels around one screen pixel") {
+        REQUIRE(overview.chooseLevel(4.0f) == 0);
+        REQUIRE(overview.chooseLevel(0.5f) == 0);
+        REQUIRE(overview.chooseLevel(0.3f) == 1);
+        REQUIRE(overview.chooseLevel(0.01f) == overview.getLevelCount() - 1);
+    }
+}
+
+TEST_CASE("HexGridEditor JSON map files", "[HexGridRenderer][Serialization]") {
+    MockSDLManager sdl;
+    HexGridEditor editor(0, 0, 400, 300, sdl);
+    auto grid = editor.getGrid();
+    REQUIRE(grid != nullptr);
+    HexCoordinate forest = HexCoordinate::fromOffset(1, 1);
+    grid->setTerrain(forest, TerrainType::FOREST);
+
+    std::vector<std::string> loaded;
+    editor.onMapLoaded = [&](const std::string& filename) { loaded.push_back(filename); };
+
+    const std::string filename = "test_hex_grid_editor_map.json";
+    editor.saveMap(filename);
+    std::string saved = grid->toJSON();
+    grid->setTerrain(forest, TerrainType::PLAIN);
+
+    editor.loadMap(filename);
+    REQUIRE(loaded.size() == 1);
+    REQUIRE(grid->toJSON() == saved);
+
+    SECTION("Failed loads keep the map and do not report success") {
+        {
+            std::ofstream file(filename, std::ios::trunc);
+            file << saved.substr(0, saved.size() / 2);
+        }
+        editor.loadMap(filename);
+        REQUIRE(loaded.size() == 1);
+        REQUIRE(grid->getTile(forest)->getTerrainType() == TerrainType::FOREST);
+
+        editor.loadMap("missing_hex_grid_editor_map.json");
+        REQUIRE(loaded.size() == 1);
+    }
+
+    std::remove(filename.c_str());
+}
+
+TEST_CASE("HexGridRenderer prefetches the streaming world around the view", "[HexGridRenderer][HexWorld]") {
+    const std::string filename = "test_renderer_world.hexmap";
+    REQUIRE(HexGrid(200, 200).saveBinary(filename));
+    HexWorld world(64);
+    REQUIRE(world.open(filename));
+
+    MockSDLManager sdl;
+    auto grid = std::make_shared<HexGrid>(1, 1);
+    int originCol = 0, originRow = 0;
+    world.extractRegion(64, 64, 95, 95, *grid, originCol, originRow);
+    HexGridRenderer renderer(0, 0, 320, 240, sdl, grid);
+    renderer.setZoom(1.0f);
+    renderer.setPan(0.0f, 0.0f);
+    renderer.setStreamingWorld(&world, originCol, originRow);
+
+    renderer.updateWorldPrefetch();
+    world.waitForPrefetch();
+    world.update();
+    int prefetched = world.getPrefetchedChunkCount();
+    REQUIRE(prefetched > 0);
+    // The chunk left of and above the extracted window is within the margin
+    REQUIRE(world.isChunkResident(originCol - 1, originRow - 1));
+    REQUIRE_FALSE(world.isChunkResident(199, 199));
+
+    // An unchanged view queues nothing; panning to the far corner queues the chunks there
+    renderer.updateWorldPrefetch();
+    world.waitForPrefetch();
+    world.update();
+    REQUIRE(world.getPrefetchedChunkCount() == prefetched);
+
+    float x, y;
+    renderer.hexToWorld(HexCoordinate::fromOffset(199 - originCol, 199 - originRow), x, y);
+    renderer.setPan(320.0f - x, 240.0f - y);
+    renderer.updateWorldPrefetch();
+    world.waitForPrefetch();
+    world.update();
+    REQUIRE(world.getPrefetchedChunkCount() > prefetched);
+    REQUIRE(world.isChunkResident(199, 199));
+
+    world.close();
+    std::remove(filename.c_str());
+}
@@ -0,0 +1,128 @@
+#include <catch2/catch.hpp>
+#include "Interface/ui/HexWorld.h"
+#include <cstdio>
+
+namespace {
+
+// 100x70 map: three chunk rows, four chunk columns with a partial last column
+void buildWorldMap(HexGrid& grid) {
+    const TerrainType terrains[] = {TerrainType::PLAIN, TerrainType::FOREST, TerrainType::MOUNTAIN,
+                                    TerrainType::SWAMP, TerrainType::RIVER};
+    for (int index = 0; index < grid.getTileCount(); ++index) {
+        const HexCoordinate& coord = grid.getCoordinateAt(index);
+        grid.setTerrain(coord, terrains[(index * 7 + index / 13) % 5]);
+        grid.setHeight(coord, index % 3);
+    }
+    grid.setOccupant(HexCoordinate::fromOffset(5, 5), "legio_v");
+    HexTile* tagged = grid.getTile(HexCoordinate::fromOffset(90, 65));
+    tagged->getProperties().specialTag = "river_ford";
+    grid.refreshTile(tagged->getCoordinate());
+}
+
+bool sameTile(const HexTile& a, const HexTile& b) {
+    return a.toJSON() == b.toJSON();
+}
+
+} // namespace
+
+TEST_CASE("HexWorld chunk streaming", "[HexGrid][HexWorld]") {
+    const std::string filename = "test_hex_world_map.hexmap";
+    const std::string savedFile = "test_hex_world_saved.hexmap";
+    HexGrid grid(100, 70);
+    buildWorldMap(grid);
+    REQUIRE(grid.saveBinary(filename));
+
+    HexWorld world(4);
+    REQUIRE(world.open(filename));
+    REQUIRE(world.getWidth() == 100);
+    REQUIRE(world.getHeight() == 70);
+
+    SECTION("Tiles match the source grid within the chunk budget") {
+        for (int row = 0; row < grid.getHeight(); ++row) {
+            for (int col = 0; col < grid.getWidth(); ++col) {
+                HexCoordinate coord = HexCoordinate::fromOffset(col, row);
+                const HexTile* tile = world.getTile(col, row);
+                REQUIRE(tile != nullptr);
+                REQUIRE(tile->getCoordinate() == coord);
+                REQUIRE(sameTile(*tile, *grid.getTile(coord)));
+                REQUIRE(world.getResidentChunkCount() <= 4);
+            }
+        }
+        REQUIRE(world.getTile(100, 0) == nullptr);
+        REQUIRE(world.getTile(-1, 3) == nullptr);
+        REQUIRE(world.getTile(HexCoordinate::fromOffset(5, 5))->getOccupantId() == "legio_v");
+    }
+
+    SECTION("Edits survive eviction and are saved") {
+        HexTile* edited = world.editTile(3, 3);
+        edited->setTerrainType(TerrainType::CAMP);
+        edited->getProperties().specialTag = "praetorium";
+
+        // Touch more chunks than the budget holds
+        for (int row = 0; row < 70; row += HexWorld::CHUNK_SIZE) {
+            for (int col = 0; col < 100; col += HexWorld::CHUNK_SIZE) {
+                world.getTile(col + 1, row + 1);
+            }
+        }
+        REQUIRE_FALSE(world.isChunkResident(3, 3));
+        REQUIRE(world.getTile(3, 3)->getTerrainType() == TerrainType::CAMP);
+        REQUIRE(world.getTile(3, 3)->getProperties().specialTag == "praetorium");
+
+        world.editTile(99, 69)->setHeight(2);
+        REQUIRE(world.save(savedFile));
+
+        HexGrid loaded(1, 1);
+        REQUIRE(loaded.loadBinary(savedFile));
+        grid.setTile(HexCoordinate::fromOffset(3, 3), *world.getTile(3, 3));
+        grid.setHeight(HexCoordinate::fromOffset(99, 69), 2);
+        REQUIRE(loaded.toJSON() == grid.toJSON());
+        std::remove(savedFile.c_str());
+    }
+
+    SECTION("Prefetched chunks are installed by update") {
+        world.prefetchRegion(40, 0, 70, 40);
+        world.waitForPrefetch();
+        world.update();
+        REQUIRE(world.getPrefetchedChunkCount() == 4);
+        REQUIRE(world.isChunkResident(40, 0));
+        REQUIRE(world.isChunkResident(70, 40));
+
+        int loads = world.getChunkLoadCount();
+        REQUIRE(sameTile(*world.getTile(64, 33), *grid.getTile(HexCoordinate::fromOffset(64, 33))));
+        REQUIRE(world.getChunkLoadCount() == loads);
+    }
+
+    SECTION("Path prefetch covers the corridor between the endpoints") {
+        world.setChunkBudget(16);
+        world.prefetchPath(HexCoordinate::fromOffset(2, 2), HexCoordinate::fromOffset(97, 67), 4);
+        world.waitForPrefetch();
+        world.update();
+        REQUIRE(world.isChunkResident(2, 2));
+        REQUIRE(world.isChunkResident(50, 35));
+        REQUIRE(world.isChunkResident(97, 67));
+        REQUIRE_FALSE(world.isChunkResident(97, 2));
+    }
+
+    SECTION("Regions extract into a HexGrid with the offset layout intact") {
+        HexGrid region(1, 1);
+        int originCol = 0, originRow = 0;
+        world.extractRegion(20, 31, 80, 60, region, originCol, originRow);
+        REQUIRE(originCol == 20);
+        REQUIRE(originRow == 30);
+        REQUIRE(region.getWidth() == 61);
+        REQUIRE(region.getHeight() == 31);
+
+        for (int row = originRow; row <= 60; ++row) {
+            for (int col = originCol; col <= 80; ++col) {
+                const HexTile* tile = region.getTile(HexCoordinate::fromOffset(col - originCol, row - originRow));
+                const HexTile* source = grid.getTile(HexCoordinate::fromOffset(col, row));
+                REQUIRE(tile->getTerrainType() == source->getTerrainType());
+                REQUIRE(tile->getHeight() == source->getHeight());
+                REQUIRE(tile->getMovementCost() == source->getMovementCost());
+            }
+        }
+    }
+
+    world.close();
+    std::remove(filename.c_str());
+}
@@ -4,6 +4,7 @@
 #include "Interface/ui/UILabel.h"
 #include "Systems/SDLManager.h"
 #include <memory>
+#include <vector>
 
 TEST_CASE("SimpleContainer - Basic Functionality", "[SimpleContainer]") {
     SDLManager sdl;
@@ -213,6 +214,51 @@ TEST_CASE("SimpleContainer - Event Handling", "[SimpleContainer][Events]") {
     }
 }
 
+TEST_CASE("SimpleContainer - Indexed hit testing", "[SimpleContainer][Events]") {
+    SDLManager sdl;
+    SimpleContainer container(0, 0, 200, 300, sdl);
+    container.setScrollable(true);
+    container.setVerticalLayout(0);
+    
+    std::vector<std::shared_ptr<UIButton>> buttons;
+    for (int i = 0; i < 200; ++i) {
+        auto button = std::make_shared<UIButton>("Item", 0, 0, 100, 30, sdl);
+        container.addChild(button);
+        buttons.push_back(button);
+    }
+    container.layout();
+    
+    REQUIRE(container.hitTest(10, 35) == buttons[1]);
+    REQUIRE(container.hitTest(150, 35) == nullptr); // Right of the buttons
+    
+    SECTION("Scrolled children are found at their new rects") {
+        container.setScrollOffset(40);
+        container.layout();
+        REQUIRE(container.hitTest(10, 5) == buttons[1]);
+        REQUIRE(container.hitTest(10, 299) == buttons[11]);
+        
+        // Children scrolled out of the container are not hit
+        REQUIRE(container.hitTest(10, 320) == nullptr);
+    }
+    
+    SECTION("Moved and removed children are seen without a layout pass") {
+        buttons[150]->setPosition(120, 100);
+        REQUIRE(container.hitTest(150, 110) == buttons[150]);
+        
+        container.removeChild(buttons[150]);
+        REQUIRE(container.hitTest(150, 110) == nullptr);
+    }
+    
+    SECTION("Later children win where they overlap") {
+        auto overlay = std::make_shared<UIButton>("Overlay", 0, 0, 100, 30, sdl);
+        container.setCustomLayout(nullptr);
+        container.addChild(overlay);
+        overlay->setPosition(0, 30);
+        REQUIRE(container.hitTest(10, 35) == overlay);
+        REQUIRE(container.hitTest(10, 65) == buttons[2]);
+    }
+}
+
 TEST_CASE("SimpleContainer - Composition over Inheritance", "[SimpleContainer][Design]") {
     SDLManager sdl;
     
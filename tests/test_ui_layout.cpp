@@ -17,6 +17,7 @@ public:
 #include "Interface/ui/UIComponent.h"
 #include "Interface/ui/UIButton.h"
 #include "Interface/ui/UIContainer.h"
+#include "Interface/ui/SimpleContainer.h"
 #include <memory>
 
 // Mock component with layout tracking for testing
@@ -165,7 +166,13 @@ TEST_CASE("Layout and render separation improves testability", "[ui][layout][tes
         // Results should be identical
         REQUIRE(firstX == secondX);
         REQUIRE(firstY == secondY);
-        REQUIRE(child->wasLayoutCalled()); // Confirm it was called again
+        REQUIRE_FALSE(child->wasLayoutCalled()); // Clean children keep their layout
+        
+        // Invalidated children lay out again
+        child->invalidateLayout();
+        container.layout();
+        REQUIRE(child->wasLayoutCalled());
+        REQUIRE(child->getY() == firstY);
     }
 }
 
@@ -197,3 +204,87 @@ TEST_CASE("Clipped rendering with layout", "[ui][layout][clipping]") {
         REQUIRE_FALSE(component3->wasRenderCalled()); // Completely outside
     }
 }
+
+TEST_CASE("Layout invalidation skips clean subtrees", "[ui][layout][invalidation]") {
+    SDLManager sdl;
+    UIManager manager;
+    
+    auto outer = std::make_shared<SimpleContainer>(0, 0, 300, 400, sdl);
+    auto inner = std::make_shared<SimpleContainer>(0, 0, 300, 200, sdl);
+    auto first = std::make_shared<MockLayoutComponent>(0, 0, 100, 30, sdl);
+    auto second = std::make_shared<MockLayoutComponent>(0, 0, 100, 30, sdl);
+    auto footer = std::make_shared<MockLayoutComponent>(0, 0, 100, 20, sdl);
+    outer->setVerticalLayout(0);
+    inner->setVerticalLayout(0);
+    inner->addChild(first);
+    inner->addChild(second);
+    outer->addChild(inner);
+    outer->addChild(footer);
+    manager.addComponent(outer);
+    
+    REQUIRE(first->getParent() == inner.get());
+    REQUIRE(inner->getParent() == outer.get());
+    
+    manager.layoutAll();
+    REQUIRE(first->wasLayoutCalled());
+    REQUIRE(second->getY() == 30);
+    REQUIRE(footer->getY() == 200);
+    REQUIRE_FALSE(outer->isLayoutDirty());
+    REQUIRE_FALSE(second->isLayoutDirty());
+    
+    SECTION("Idle frames skip layout entirely") {
+        first->reset(); second->reset(); footer->reset();
+        manager.layoutAll();
+        manager.renderAll();
+        REQUIRE_FALSE(first->wasLayoutCalled());
+        REQUIRE_FALSE(second->wasLayoutCalled());
+        REQUIRE_FALSE(footer->wasLayoutCalled());
+    }
+    
+    SECTION("Invalidating a child re-lays out its ancestors only") {
+        first->reset(); second->reset(); footer->reset();
+        first->setExpectedSize(100, 50);
+        first->invalidateLayout();
+        REQUIRE(inner->isLayoutDirty());
+        REQUIRE(outer->isLayoutDirty());
+        REQUIRE_FALSE(footer->isLayoutDirty());
+        
+        manager.layoutAll();
+        REQUIRE(first->wasLayoutCalled());
+        REQUIRE(first->getHeight() == 50);
+        REQUIRE(second->getY() == 50);
+        REQUIRE_FALSE(footer->wasLayoutCalled());
+        REQUIRE_FALSE(outer->isLayoutDirty());
+        REQUIRE_FALSE(first->isLayoutDirty());
+    }
+    
+    SECTION("Moving a container lays out its children again") {
+        outer->setPosition(10, 20);
+        manager.layoutAll();
+        REQUIRE(first->getX() == 10);
+        REQUIRE(second->getY() == 50);
+        REQUIRE(footer->getY() == 220);
+    }
+    
+    SECTION("Removing a child detaches it and dirties the container") {
+        inner->removeChild(first);
+        REQUIRE(first->getParent() == nullptr);
+        REQUIRE(outer->isLayoutDirty());
+        manager.layoutAll();
+        REQUIRE(second->getY() == 0);
+        
+        first->invalidateLayout();
+        REQUIRE_FALSE(inner->isLayoutDirty());
+    }
+    
+    SECTION("Scrolling repositions children") {
+        inner->setScrollable(true);
+        inner->setSize(300, 40);
+        manager.layoutAll();
+        inner->setScrollOffset(20);
+        REQUIRE(inner->isLayoutDirty());
+        manager.layoutAll();
+        REQUIRE(first->getY() == -20);
+        REQUIRE(second->getY() == 10);
+    }
+}
@@ -15,7 +15,9 @@ public:
 
 #include "Interface/ui/UIManager.h"
 #include "Interface/ui/UIComponent.h"
+#include "Interface/ui/SimpleContainer.h"
 #include <memory>
+#include <vector>
 
 class MockComponent : public UIComponent {
 public:
@@ -63,3 +65,216 @@ TEST_CASE("UIManager hit-test and event routing") {
     target->handleEvent(mv);
     REQUIRE(b->hovered == true);
 }
+
+class OrderedComponent : public UIComponent {
+public:
+    OrderedComponent(int id, std::vector<int>& order, SDLManager& sdl)
+        : UIComponent(0,0,100,100,sdl), id_(id), order_(order) {}
+    void render() override { order_.push_back(id_); }
+    void handleEvent(const SDL_Event&) override {}
+private:
+    int id_;
+    std::vector<int>& order_;
+};
+
+TEST_CASE("UIManager keeps a z-ordered render list") {
+    SDLManager dummy;
+    UIManager mgr;
+    std::vector<int> order;
+
+    auto a = std::make_shared<OrderedComponent>(1, order, dummy);
+    auto b = std::make_shared<OrderedComponent>(2, order, dummy);
+    auto c = std::make_shared<OrderedComponent>(3, order, dummy);
+    auto d = std::make_shared<OrderedComponent>(4, order, dummy);
+    b->setZOrder(5);
+    mgr.addComponent(a, true);
+    mgr.addComponent(b, true);
+    mgr.addComponent(c, false);
+    mgr.addComponent(d, true);
+
+    // Equal z-orders keep insertion order, and the later component is on top
+    mgr.renderAll();
+    REQUIRE(order == std::vector<int>{1, 3, 4, 2});
+    REQUIRE(mgr.getComponentAt(50, 50).get() == b.get());
+
+    // Changing the z-order of a managed component reorders rendering and hit-testing
+    order.clear();
+    b->setZOrder(0);
+    a->setZOrder(-1);
+    mgr.renderAll();
+    REQUIRE(order == std::vector<int>{1, 2, 3, 4});
+    REQUIRE(mgr.getComponentAt(50, 50).get() == d.get());
+
+    mgr.bringToTop(a);
+    REQUIRE(mgr.getComponentAt(50, 50).get() == a.get());
+    mgr.sendToBottom(a);
+    mgr.sendToBottom(d);
+    order.clear();
+    mgr.renderAll();
+    REQUIRE(order == std::vector<int>{4, 1, 2, 3});
+
+    // Cleared components leave the render list
+    mgr.clearDynamic();
+    order.clear();
+    mgr.renderAll();
+    REQUIRE(order == std::vector<int>{4, 1, 2});
+    REQUIRE(mgr.getComponentAt(50, 50).get() == b.get());
+
+    mgr.clearPersistent();
+    REQUIRE(mgr.getComponentAt(50, 50) == nullptr);
+    c->setZOrder(7);
+}
+
+TEST_CASE("UIManager tracks damage for retained rendering") {
+    SDLManager dummy;
+    UIManager mgr;
+    std::vector<int> order;
+    const SDL_Color background = {0, 0, 0, 255};
+
+    auto a = std::make_shared<OrderedComponent>(1, order, dummy);
+    auto b = std::make_shared<OrderedComponent>(2, order, dummy);
+    b->setPosition(200, 200);
+    b->setSize(50, 50);
+    mgr.addComponent(a, true);
+    mgr.addComponent(b, true);
+
+    // The first frame is drawn in full, then idle frames draw nothing
+    REQUIRE(mgr.hasDamage());
+    REQUIRE(mgr.renderRetained(nullptr, background));
+    REQUIRE(order == std::vector<int>{1, 2});
+    REQUIRE_FALSE(mgr.hasDamage());
+    order.clear();
+    REQUIRE_FALSE(mgr.renderRetained(nullptr, background));
+    REQUIRE(order.empty());
+
+    SECTION("Moves damage the old and new rects, merged") {
+        b->setPosition(210, 200);
+        const int m = UIComponent::RENDER_MARGIN;
+        REQUIRE(mgr.getDamageRects().size() == 1);
+        SDL_Rect r = mgr.getDamageRects()[0];
+        REQUIRE(r.x == 200 - m);
+        REQUIRE(r.y == 200 - m);
+        REQUIRE(r.w == 60 + 2 * m);
+        REQUIRE(r.h == 50 + 2 * m);
+
+        // Unchanged state does not damage anything
+        order.clear();
+        REQUIRE(mgr.renderRetained(nullptr, background));
+        b->setPosition(210, 200);
+        b->setVisible(true);
+        REQUIRE_FALSE(mgr.hasDamage());
+    }
+
+    SECTION("Nested children damage through their top-level ancestor") {
+        auto container = std::make_shared<SimpleContainer>(300, 0, 100, 100, dummy);
+        auto child = std::make_shared<OrderedComponent>(3, order, dummy);
+        container->addChild(child);
+        mgr.addComponent(container, true);
+        mgr.renderRetained(nullptr, background);
+        REQUIRE_FALSE(mgr.hasDamage());
+
+        child->invalidateRender();
+        REQUIRE(mgr.getDamageRects().size() == 1);
+        SDL_Rect bounds = child->getRenderBounds();
+        SDL_Rect damage = mgr.getDamageRects()[0];
+        REQUIRE(damage.x == bounds.x);
+        REQUIRE(damage.w == bounds.w);
+
+        container->removeChild(child);
+        mgr.renderRetained(nullptr, background);
+        child->invalidateRender();
+        REQUIRE_FALSE(mgr.hasDamage());
+    }
+
+    SECTION("Scattered damage collapses to its bounds") {
+        std::vector<std::shared_ptr<OrderedComponent>> items;
+        for (int i = 0; i < 20; ++i) {
+            auto item = std::make_shared<OrderedComponent>(10 + i, order, dummy);
+            item->setPosition(i * 40, 500);
+            item->setSize(10, 10);
+            mgr.addComponent(item, false);
+            items.push_back(item);
+        }
+        REQUIRE(mgr.getDamageRects().size() < items.size());
+        for (const auto& item : items) {
+            SDL_Rect bounds = item->getRenderBounds();
+            bool covered = false;
+            for (const auto& r : mgr.getDamageRects()) {
+                SDL_Rect merged;
+                SDL_UnionRect(&r, &bounds, &merged);
+                covered = covered || (merged.x == r.x && merged.y == r.y && merged.w == r.w && merged.h == r.h);
+            }
+            REQUIRE(covered);
+        }
+
+        mgr.renderRetained(nullptr, background);
+        mgr.clearDynamic();
+        REQUIRE(mgr.hasDamage());
+    }
+
+    SECTION("Window events and z-order changes force redraws") {
+        SDL_Event ev{};
+        ev.type = SDL_WINDOWEVENT;
+        mgr.handleEvent(ev);
+        REQUIRE(mgr.hasDamage());
+        REQUIRE(mgr.getDamageRects().empty());
+        mgr.renderRetained(nullptr, background);
+
+        mgr.bringToTop(a);
+        REQUIRE(mgr.hasDamage());
+        order.clear();
+        REQUIRE(mgr.renderRetained(nullptr, background));
+        REQUIRE(order == std::vector<int>{2, 1});
+    }
+}
+
+TEST_CASE("UIManager hit-tests through a spatial index") {
+    SDLManager dummy;
+    UIManager mgr;
+    std::vector<int> order;
+
+    // A full-screen backdrop under a 40 x 50 board of cards, each 20 x 15 at a 24 x 18 pitch
+    auto backdrop = std::make_shared<OrderedComponent>(-1, order, dummy);
+    backdrop->setSize(1000, 1000);
+    backdrop->setZOrder(-1);
+    mgr.addComponent(backdrop, true);
+    std::vector<std::shared_ptr<OrderedComponent>> cards;
+    for (int i = 0; i < 2000; ++i) {
+        auto card = std::make_shared<OrderedComponent>(i, order, dummy);
+        card->setPosition((i % 40) * 24, (i / 40) * 18);
+        card->setSize(20, 15);
+        mgr.addComponent(card, i % 2 == 0);
+        cards.push_back(card);
+    }
+
+    REQUIRE(mgr.getComponentAt(24 * 5 + 3, 18 * 7 + 3) == cards[7 * 40 + 5]);
+    REQUIRE(mgr.getComponentAt(24 * 5 + 22, 18 * 7 + 3) == backdrop);   // Gap between cards
+    REQUIRE(mgr.getComponentAt(1001, 10) == nullptr);
+
+    SECTION("Edges are inclusive like isPointInside") {
+        REQUIRE(mgr.getComponentAt(20, 15) == cards[0]);
+        REQUIRE(mgr.getComponentAt(21, 15) == backdrop);
+    }
+
+    SECTION("Moves and resizes are picked up") {
+        cards[0]->setPosition(500, 900);
+        REQUIRE(mgr.getComponentAt(505, 905) == cards[0]);
+        REQUIRE(mgr.getComponentAt(5, 5) == backdrop);
+        cards[1]->setSize(100, 15);
+        REQUIRE(mgr.getComponentAt(100, 5) == cards[4]);   // Later cards still stack above
+        cards[1]->setZOrder(1);
+        REQUIRE(mgr.getComponentAt(100, 5) == cards[1]);
+    }
+
+    SECTION("Cleared components are no longer hit") {
+        mgr.clearPersistent();
+        REQUIRE(mgr.getComponentAt(24 * 1 + 3, 3) == cards[1]);
+        REQUIRE(mgr.getComponentAt(3, 3) == nullptr);
+    }
+
+    SECTION("Modal components capture every point") {
+        mgr.setModal(cards[0]);
+        REQUIRE(mgr.getComponentAt(5, 5) == cards[0]);
+        REQUIRE(mgr.getComponentAt(24 * 5 + 3, 3) == nullptr);
+    }
+}
@@ -199,6 +199,35 @@ TEST_CASE("UISceneManager Update and Render", "[UISceneManager]") {
         // Only active scene should be updated
         REQUIRE(testScene1->updateCount == 0); // Paused, not updated
     }
+    
+    SECTION("Retained scenes only redraw damaged frames") {
+        sceneManager.registerScene<TestScene>("menu");
+        sceneManager.registerScene<AnotherTestScene>("overlay");
+        sceneManager.switchToScene("menu");
+        auto menu = std::dynamic_pointer_cast<TestScene>(sceneManager.getCurrentScene());
+        menu->setRetainedRendering(true, {10, 20, 30, 255});
+        REQUIRE(menu->isRetainedRendering());
+        
+        // First frame is drawn, idle frames are skipped, and render() is left to the UIManager
+        REQUIRE(sceneManager.render());
+        REQUIRE_FALSE(sceneManager.render());
+        REQUIRE(menu->renderCount == 0);
+        
+        menu->getUIManager().invalidateRect({0, 0, 10, 10});
+        REQUIRE(sceneManager.render());
+        REQUIRE_FALSE(sceneManager.render());
+        
+        // Overlays render every scene in full
+        sceneManager.pushScene("overlay");
+        REQUIRE(sceneManager.render());
+        REQUIRE(sceneManager.render());
+        REQUIRE(menu->renderCount == 2);
+        
+        // Back to retained rendering, starting from a full frame
+        sceneManager.popScene();
+        REQUIRE(sceneManager.render());
+        REQUIRE_FALSE(sceneManager.render());
+    }
 }
 
 TEST_CASE("UISceneManager Global Data", "[UISceneManager]") {
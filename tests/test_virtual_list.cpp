@@ -0,0 +1,118 @@
+#include <catch2/catch.hpp>
+#include "Interface/ui/VirtualListContainer.h"
+#include "Interface/ui/UILabel.h"
+#include "Systems/SDLManager.h"
+#include <memory>
+#include <string>
+
+TEST_CASE("VirtualListContainer - Row recycling", "[VirtualList]") {
+    SDLManager sdl;
+    VirtualListContainer list(0, 0, 200, 100, sdl);
+
+    int created = 0;
+    int binds = 0;
+    list.setRowFactory(
+        [&]() {
+            ++created;
+            return std::make_shared<UILabel>(0, 0, 200, 20, sdl, "");
+        },
+        [&](UIComponent& component, int row) {
+            ++binds;
+            static_cast<UILabel&>(component).setText("Row " + std::to_string(row));
+        });
+    list.setRowHeight(20);
+    list.setOverscan(1);
+    list.setRowCount(50000);
+    list.layout();
+
+    // 5 rows in view plus one overscan row below
+    REQUIRE(list.getContentHeight() == 50000 * 20);
+    REQUIRE(list.getFirstBoundRow() == 0);
+    REQUIRE(list.getBoundRowCount() == 6);
+    REQUIRE(created == 6);
+
+    auto first = std::static_pointer_cast<UILabel>(list.getRowComponent(0));
+    REQUIRE(first->getText() == "Row 0");
+    REQUIRE(first->getY() == 0);
+    REQUIRE(first->getParent() == &list);
+    REQUIRE(list.getRowComponent(10) == nullptr);
+
+    SECTION("Scrolling rebinds pooled rows instead of creating new ones") {
+        list.setScrollOffset(25000 * 20 + 10);
+        REQUIRE(list.isLayoutDirty());
+        list.layout();
+
+        REQUIRE(list.getFirstBoundRow() == 24999);
+        REQUIRE(list.getBoundRowCount() == 8);
+        REQUIRE(list.getPoolSize() == 8);
+        REQUIRE(created == 8);
+
+        auto row = std::static_pointer_cast<UILabel>(list.getRowComponent(25000));
+        REQUIRE(row->getText() == "Row 25000");
+        REQUIRE(row->getY() == -10);
+        REQUIRE(list.getRowAt(5) == 25000);
+        REQUIRE(list.getRowAt(15) == 25001);
+        REQUIRE(list.hitTest(50, 5) == row);
+    }
+
+    SECTION("Small scrolls keep rows that stay in range") {
+        list.setScrollOffset(20);
+        list.layout();
+        int bindsBefore = binds;
+        list.setScrollOffset(40);
+        list.layout();
+
+        // One row enters at the bottom, reusing the row that left the top
+        REQUIRE(binds == bindsBefore + 1);
+        REQUIRE(list.getPoolSize() == 7);
+        REQUIRE(list.getRowComponent(0) == nullptr);
+        REQUIRE(std::static_pointer_cast<UILabel>(list.getRowComponent(7))->getText() == "Row 7");
+    }
+
+    SECTION("Refreshing rebinds every bound row") {
+        int bindsBefore = binds;
+        list.refreshRows();
+        list.layout();
+        REQUIRE(binds == bindsBefore + list.getBoundRowCount());
+        REQUIRE(created == 6);
+    }
+
+    SECTION("Shrinking the row count clamps the scroll") {
+        list.setScrollOffset(list.getMaxScroll());
+        list.setRowCount(3);
+        list.layout();
+        REQUIRE(list.getScrollOffset() == 0);
+        REQUIRE(list.getBoundRowCount() == 3);
+        REQUIRE(list.getRowAt(70) == -1);
+    }
+}
+
+TEST_CASE("VirtualListContainer - Variable row heights", "[VirtualList]") {
+    SDLManager sdl;
+    VirtualListContainer list(10, 50, 200, 100, sdl);
+    list.setRowFactory(
+        [&]() { return std::make_shared<UILabel>(0, 0, 200, 20, sdl, ""); },
+        nullptr);
+    list.setRowHeightFunction([](int row) { return row % 2 == 0 ? 10 : 30; });
+    list.setSpacing(2);
+    list.setOverscan(0);
+    list.setRowCount(1000);
+
+    // Each pair of rows takes 10 + 2 + 30 + 2 pixels
+    REQUIRE(list.getRowTop(2) == 44);
+    REQUIRE(list.getRowHeight(3) == 30);
+    REQUIRE(list.getContentHeight() == 500 * 44 - 2);
+    REQUIRE(list.getRowAt(50 + 44 + 5) == 2);
+    REQUIRE(list.getRowAt(50 + 11) == -1); // Spacing between rows
+
+    list.scrollToRow(101);
+    REQUIRE(list.getScrollOffset() == 50 * 44 + 12 + 30 - 100);
+    list.layout();
+
+    auto row = list.getRowComponent(101);
+    REQUIRE(row != nullptr);
+    REQUIRE(row->getHeight() == 30);
+    REQUIRE(row->getY() + row->getHeight() == 50 + 100);
+    REQUIRE(row->getX() == 10);
+    REQUIRE(list.getRowComponent(list.getFirstBoundRow())->getY() <= 50);
+}
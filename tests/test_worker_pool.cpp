@@ -0,0 +1,50 @@
+#include <catch2/catch.hpp>
+#include "Systems/WorkerPool.h"
+#include <atomic>
+#include <stdexcept>
+#include <vector>
+
+TEST_CASE("WorkerPool parallelFor", "[WorkerPool]") {
+    WorkerPool pool(3);
+    REQUIRE(pool.getConcurrency() == 4);
+
+    SECTION("Every item runs exactly once") {
+        std::vector<std::atomic<int>> hits(1000);
+        for (auto& hit : hits) hit = 0;
+
+        pool.parallelFor(static_cast<int>(hits.size()), [&](int item, int) {
+            hits[item]++;
+        });
+
+        for (auto& hit : hits) {
+            REQUIRE(hit == 1);
+        }
+    }
+
+    SECTION("Pool is reusable across many jobs") {
+        std::atomic<int> total{0};
+        for (int job = 0; job < 50; ++job) {
+            pool.parallelFor(job, [&](int, int) { total++; });
+        }
+        REQUIRE(total == 49 * 50 / 2);
+    }
+
+    SECTION("Worker indices are within concurrency") {
+        std::atomic<bool> valid{true};
+        pool.parallelFor(200, [&](int, int worker) {
+            if (worker < 0 || worker >= pool.getConcurrency()) valid = false;
+        });
+        REQUIRE(valid);
+    }
+
+    SECTION("Exceptions propagate to the caller") {
+        REQUIRE_THROWS_AS(pool.parallelFor(100, [](int item, int) {
+            if (item == 42) throw std::runtime_error("failed");
+        }), std::runtime_error);
+
+        // Pool still works afterwards
+        std::atomic<int> count{0};
+        pool.parallelFor(10, [&](int, int) { count++; });
+        REQUIRE(count == 10);
+    }
+}